@@ -88,4 +88,7 @@
 // Safe to enable this flag since standalone is associated with host and not a device.
 #define CONFIG_BUILD_FOR_HOST_UNIT_TEST 1
 
+// Build the reporting engine with its per-cluster dirty attribute table, so that the host unit tests cover it.
+#define CHIP_IM_DIRTY_ATTRIBUTE_SET 1
+
 #endif /* CHIPPROJECTCONFIG_H */
@@ -24,12 +24,20 @@
 #include <messaging/Flags.h>
 #include <protocols/bdx/BdxTransferSession.h>
 
-#include <fstream>
+#include <cinttypes>
 
 using chip::bdx::StatusCode;
 using chip::bdx::TransferControlFlags;
 using chip::bdx::TransferSession;
 
+namespace {
+// Data of empty blocks, since PrepareBlock rejects a null pointer even for an empty BlockEOF.
+const uint8_t kNoData = 0;
+
+// Number of blocks following the one being sent that the kernel is asked to read ahead.
+constexpr size_t kReadAheadBlocks = 8;
+} // namespace
+
 BdxOtaSender::BdxOtaSender()
 {
     memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
@@ -122,6 +130,8 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         memcpy(mFileDesignator, fd, fdl);
         mFileDesignator[fdl] = 0;
 
+        mStats           = TransferStats();
+        mStats.startTime = chip::System::SystemClock().GetMonotonicTimestamp();
         break;
     }
     case TransferSession::OutputEventType::kQueryReceived: {
@@ -136,37 +146,35 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
             bytesToRead = static_cast<uint16_t>(mTransfer.GetTransferLength() - mNumBytesSent);
         }
 
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull())
-        {
-            // TODO(#13981): AbortTransfer() needs to support GeneralStatusCode failures as well as BDX specific errors.
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            return;
-        }
-
-        std::ifstream otaFile(mFileDesignator, std::ifstream::in);
-        if (!otaFile.good())
+        if (mImage == nullptr)
         {
-            ChipLogError(BDX, "OTA file open failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
+            mImage = OTAImageCache::Instance().Acquire(mFileDesignator);
+            if (mImage == nullptr)
+            {
+                ChipLogError(BDX, "OTA file open failed");
+                mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+                return;
+            }
         }
 
-        otaFile.seekg(mNumBytesSent);
-        otaFile.read(reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (!(otaFile.good() || otaFile.eof()))
+        mBlockBuffer.resize(bytesToRead);
+        chip::MutableByteSpan block(mBlockBuffer.data(), mBlockBuffer.size());
+        err = OTAImageCache::ReadBlock(*mImage, mNumBytesSent, block, kReadAheadBlocks * blockSize);
+        if (err != CHIP_NO_ERROR)
         {
-            ChipLogError(BDX, "OTA file read failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
+            ChipLogError(BDX, "OTA file read failed: %" CHIP_ERROR_FORMAT, err.Format());
+            mTransfer.AbortTransfer(StatusCode::kUnknown);
             return;
         }
 
-        blockData.Data   = blockBuf->Start();
-        blockData.Length = static_cast<size_t>(otaFile.gcount());
+        blockData.Data   = block.empty() ? &kNoData : block.data();
+        blockData.Length = block.size();
         blockData.IsEof  = (blockData.Length < blockSize) ||
-            (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mTransfer.GetTransferLength() || (otaFile.peek() == EOF));
+            (mNumBytesSent + static_cast<uint64_t>(blockData.Length) == mTransfer.GetTransferLength()) ||
+            (mNumBytesSent + static_cast<uint64_t>(blockData.Length) >= OTAImageCache::GetSize(*mImage));
         mNumBytesSent = static_cast<uint32_t>(mNumBytesSent + blockData.Length);
-        otaFile.close();
+        mStats.blocksSent++;
+        mStats.bytesSent += blockData.Length;
 
         err = mTransfer.PrepareBlock(blockData);
         if (err != CHIP_NO_ERROR)
@@ -180,6 +188,8 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         break;
     case TransferSession::OutputEventType::kAckEOFReceived:
         ChipLogDetail(BDX, "Transfer completed, got AckEOF");
+        ChipLogProgress(BDX, "Sent %" PRIu32 " blocks (%" PRIu64 " bytes) in %" PRIu64 " ms", mStats.blocksSent, mStats.bytesSent,
+                        (chip::System::SystemClock().GetMonotonicTimestamp() - mStats.startTime).count());
         mStopPolling = true; // Stop polling the TransferSession only after receiving BlockAckEOF
         Reset();
         break;
@@ -219,6 +229,9 @@ void BdxOtaSender::Reset()
         mExchangeCtx = nullptr;
     }
 
+    OTAImageCache::Instance().Release(mImage);
+    mImage = nullptr;
+
     mInitialized  = false;
     mNumBytesSent = 0;
     memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
@@ -15,8 +15,12 @@
  *    limitations under the License.
  */
 
+#include <ota-provider-common/OTAImageCache.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <protocols/bdx/TransferFacilitator.h>
+#include <system/SystemClock.h>
+
+#include <vector>
 
 #pragma once
 
@@ -28,6 +32,16 @@ public:
     // Initializes BDX transfer-related metadata. Should always be called first.
     CHIP_ERROR InitializeTransfer(chip::FabricIndex fabricIndex, chip::NodeId nodeId);
 
+    struct TransferStats
+    {
+        uint32_t blocksSent = 0;
+        uint64_t bytesSent  = 0;
+        chip::System::Clock::Timestamp startTime;
+    };
+
+    // Stats of the current transfer, or of the last one once it is over.
+    const TransferStats & GetTransferStats() const { return mStats; }
+
 private:
     // Inherited from bdx::TransferFacilitator
     void HandleTransferSessionOutput(chip::bdx::TransferSession::OutputEvent & event) override;
@@ -39,6 +53,14 @@ private:
 
     uint32_t mNumBytesSent = 0;
 
+    // The image being served, acquired when the first block is queried.
+    OTAImageCache::Image * mImage = nullptr;
+
+    // Blocks are read from the image into this buffer, then copied into the message by PrepareBlock.
+    std::vector<uint8_t> mBlockBuffer;
+
+    TransferStats mStats;
+
     bool mInitialized = false;
 
     chip::Optional<chip::FabricIndex> mFabricIndex;
@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ota-provider-common/OTAImageCache.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct OTAImageCache::Image
+{
+    std::string path;
+    dev_t device;
+    ino_t inode;
+    off_t fileSize;
+    time_t modificationTime;
+
+    int fd            = -1;
+    uint32_t refCount = 0;
+
+    ~Image()
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+
+    bool IsCurrent(const struct stat & fileStat) const
+    {
+        return device == fileStat.st_dev && inode == fileStat.st_ino && fileSize == fileStat.st_size &&
+            modificationTime == fileStat.st_mtime;
+    }
+};
+
+OTAImageCache & OTAImageCache::Instance()
+{
+    static OTAImageCache sInstance;
+    return sInstance;
+}
+
+OTAImageCache::OTAImageCache()  = default;
+OTAImageCache::~OTAImageCache() = default;
+
+OTAImageCache::Image * OTAImageCache::Acquire(const char * path)
+{
+    struct stat fileStat;
+    VerifyOrReturnValue(path != nullptr && stat(path, &fileStat) == 0 && S_ISREG(fileStat.st_mode), nullptr);
+
+    for (auto & image : mImages)
+    {
+        if (image->path == path && image->IsCurrent(fileStat))
+        {
+            image->refCount++;
+            return image.get();
+        }
+    }
+
+    std::unique_ptr<Image> image(new Image());
+    image->path = path;
+    image->fd   = open(path, O_RDONLY | O_CLOEXEC);
+    VerifyOrReturnValue(image->fd >= 0, nullptr, ChipLogError(BDX, "OTA file open failed"));
+    // Stat the opened file, in case it was replaced since the check above.
+    VerifyOrReturnValue(fstat(image->fd, &fileStat) == 0, nullptr, ChipLogError(BDX, "OTA file stat failed"));
+    image->device           = fileStat.st_dev;
+    image->inode            = fileStat.st_ino;
+    image->fileSize         = fileStat.st_size;
+    image->modificationTime = fileStat.st_mtime;
+
+    // Blocks are served in order, so let the kernel read ahead aggressively.
+    posix_fadvise(image->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    ChipLogProgress(BDX, "Opened OTA image %s (%u bytes)", path, static_cast<unsigned>(image->fileSize));
+    image->refCount = 1;
+    mImages.push_back(std::move(image));
+    return mImages.back().get();
+}
+
+void OTAImageCache::Release(Image * image)
+{
+    VerifyOrReturn(image != nullptr);
+
+    auto it = std::find_if(mImages.begin(), mImages.end(),
+                           [image](const std::unique_ptr<Image> & entry) { return entry.get() == image; });
+    VerifyOrReturn(it != mImages.end());
+    VerifyOrReturn(--image->refCount == 0);
+
+    mImages.erase(it);
+}
+
+CHIP_ERROR OTAImageCache::ReadBlock(const Image & image, uint64_t offset, chip::MutableByteSpan & block, size_t readAhead)
+{
+    const uint64_t imageSize = static_cast<uint64_t>(image.fileSize);
+    if (offset >= imageSize)
+    {
+        block.reduce_size(0);
+        return CHIP_NO_ERROR;
+    }
+
+    size_t length = static_cast<size_t>(std::min<uint64_t>(block.size(), imageSize - offset));
+    size_t read   = 0;
+    while (read < length)
+    {
+        ssize_t count = pread(image.fd, block.data() + read, length - read, static_cast<off_t>(offset + read));
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        // A file truncated since it was opened ends before the size the transfer was started with.
+        VerifyOrReturnError(count > 0, CHIP_ERROR_READ_FAILED);
+        read += static_cast<size_t>(count);
+    }
+    block.reduce_size(length);
+
+    uint64_t readAheadStart = offset + length;
+    if (readAhead > 0 && readAheadStart < imageSize)
+    {
+        posix_fadvise(image.fd, static_cast<off_t>(readAheadStart),
+                      static_cast<off_t>(std::min<uint64_t>(readAhead, imageSize - readAheadStart)), POSIX_FADV_WILLNEED);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+uint64_t OTAImageCache::GetSize(const Image & image)
+{
+    return static_cast<uint64_t>(image.fileSize);
+}
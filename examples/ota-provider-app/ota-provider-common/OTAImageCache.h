@@ -0,0 +1,70 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Open OTA image files, shared by all the BDX transfers serving them.
+ *
+ * An image is opened when the first transfer acquires it and closed when the last one releases it. Blocks are read
+ * from the open file on demand, and the kernel is asked to read ahead the blocks that follow, so an image is never
+ * held in memory. A file replaced on disk (renamed over, or changed in size or modification time) is opened again
+ * for new transfers; running ones keep reading the file they opened, and fail if it is truncated under them.
+ *
+ * Only to be used from the Matter event loop. Serving several peers at once is out of scope: the provider example
+ * runs a single BdxOtaSender, since BDX unsolicited messages cannot be routed to a sender by peer.
+ */
+class OTAImageCache
+{
+public:
+    struct Image;
+
+    static OTAImageCache & Instance();
+
+    OTAImageCache();
+    ~OTAImageCache();
+
+    /**
+     * Returns the image at the given path, opening it if no transfer uses it yet, or nullptr if the file cannot be
+     * opened. Must be matched by a call to Release.
+     */
+    Image * Acquire(const char * path);
+
+    void Release(Image * image);
+
+    /**
+     * Reads up to block.size() bytes of the image from the given offset into block, which is reduced to the bytes
+     * read (empty past the end of the image). The kernel is also asked to read ahead the readAhead bytes that follow.
+     *
+     * Returns CHIP_ERROR_READ_FAILED if the file cannot be read or got shorter than when it was opened.
+     */
+    static CHIP_ERROR ReadBlock(const Image & image, uint64_t offset, chip::MutableByteSpan & block, size_t readAhead);
+
+    static uint64_t GetSize(const Image & image);
+
+    size_t OpenImageCount() const { return mImages.size(); }
+
+private:
+    std::vector<std::unique_ptr<Image>> mImages;
+};
@@ -108,6 +108,8 @@ private:
     SendQueryImageResponse(chip::app::CommandHandler * commandObj, const chip::app::ConcreteCommandPath & commandPath,
                            const chip::app::Clusters::OtaSoftwareUpdateProvider::Commands::QueryImage::DecodableType & commandData);
 
+    // A single sender, so one transfer at a time: BDX unsolicited messages carry no peer to pick a sender by, and
+    // QueryImage answers BUSY while another node's transfer is running.
     BdxOtaSender mBdxOtaSender;
     std::vector<DeviceSoftwareVersionModel> mCandidates;
     char mOTAFilePath[kFilepathBufLen]; // null-terminated
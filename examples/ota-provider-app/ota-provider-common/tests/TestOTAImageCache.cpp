@@ -0,0 +1,226 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ota-provider-common/OTAImageCache.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using chip::ByteSpan;
+
+namespace {
+
+constexpr size_t kImageSize = 3000;
+constexpr size_t kBlockSize = 1024;
+
+std::vector<uint8_t> MakeImage(size_t size, uint8_t seed)
+{
+    std::vector<uint8_t> image(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        image[i] = static_cast<uint8_t>(seed + i);
+    }
+    return image;
+}
+
+bool WriteFile(const std::string & path, const std::vector<uint8_t> & contents)
+{
+    FILE * file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    fclose(file);
+    return written;
+}
+
+bool BlockEquals(const OTAImageCache::Image & image, const std::vector<uint8_t> & contents, size_t offset)
+{
+    uint8_t buffer[kBlockSize];
+    chip::MutableByteSpan block(buffer);
+    size_t length = std::min(kBlockSize, contents.size() - offset);
+    return OTAImageCache::ReadBlock(image, offset, block, kBlockSize) == CHIP_NO_ERROR &&
+        block.data_equal(ByteSpan(contents.data() + offset, length));
+}
+
+size_t ReadBlockSize(const OTAImageCache::Image & image, size_t offset)
+{
+    uint8_t buffer[kBlockSize];
+    chip::MutableByteSpan block(buffer);
+    return OTAImageCache::ReadBlock(image, offset, block, 0) == CHIP_NO_ERROR ? block.size() : SIZE_MAX;
+}
+
+void TestReuseAndRelease(nlTestSuite * inSuite, void * inContext)
+{
+    char pathTemplate[] = "/tmp/ota-image-XXXXXX";
+    int fd              = mkstemp(pathTemplate);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    if (fd < 0)
+    {
+        return;
+    }
+    close(fd);
+
+    const std::vector<uint8_t> contents = MakeImage(kImageSize, 0);
+    NL_TEST_ASSERT(inSuite, WriteFile(pathTemplate, contents));
+
+    OTAImageCache cache;
+    NL_TEST_ASSERT(inSuite, cache.Acquire(nullptr) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache.Acquire("/tmp/ota-image-missing") == nullptr);
+    cache.Release(nullptr);
+
+    // A second transfer of the same file shares the image of the first.
+    OTAImageCache::Image * first  = cache.Acquire(pathTemplate);
+    OTAImageCache::Image * second = cache.Acquire(pathTemplate);
+    NL_TEST_ASSERT(inSuite, first != nullptr && first == second);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 1);
+    if (first == nullptr)
+    {
+        unlink(pathTemplate);
+        return;
+    }
+
+    NL_TEST_ASSERT(inSuite, OTAImageCache::GetSize(*first) == kImageSize);
+    NL_TEST_ASSERT(inSuite, BlockEquals(*first, contents, 0));
+    NL_TEST_ASSERT(inSuite, BlockEquals(*first, contents, 2 * kBlockSize));
+    NL_TEST_ASSERT(inSuite, ReadBlockSize(*first, 2 * kBlockSize) == kImageSize - 2 * kBlockSize);
+    NL_TEST_ASSERT(inSuite, ReadBlockSize(*first, kImageSize) == 0);
+
+    // The image is kept until the last transfer releases it.
+    cache.Release(first);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 1);
+    NL_TEST_ASSERT(inSuite, BlockEquals(*second, contents, kBlockSize));
+    cache.Release(second);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 0);
+
+    unlink(pathTemplate);
+}
+
+void TestFileReplacedDuringTransfer(nlTestSuite * inSuite, void * inContext)
+{
+    char pathTemplate[] = "/tmp/ota-image-XXXXXX";
+    int fd              = mkstemp(pathTemplate);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    if (fd < 0)
+    {
+        return;
+    }
+    close(fd);
+
+    const std::string path                 = pathTemplate;
+    const std::string replacementPath      = path + ".new";
+    const std::vector<uint8_t> original    = MakeImage(kImageSize, 0);
+    const std::vector<uint8_t> truncated   = MakeImage(100, 1);
+    const std::vector<uint8_t> replacement = MakeImage(kImageSize, 2);
+    NL_TEST_ASSERT(inSuite, WriteFile(path, original));
+
+    OTAImageCache cache;
+    OTAImageCache::Image * running = cache.Acquire(path.c_str());
+    NL_TEST_ASSERT(inSuite, running != nullptr);
+    if (running == nullptr)
+    {
+        unlink(path.c_str());
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, BlockEquals(*running, original, 0));
+
+    // Replaced by a rename: the running transfer keeps reading the original file, new ones the replacement.
+    NL_TEST_ASSERT(inSuite, WriteFile(replacementPath, replacement));
+    NL_TEST_ASSERT(inSuite, rename(replacementPath.c_str(), path.c_str()) == 0);
+    NL_TEST_ASSERT(inSuite, BlockEquals(*running, original, kBlockSize));
+
+    OTAImageCache::Image * afterRename = cache.Acquire(path.c_str());
+    NL_TEST_ASSERT(inSuite, afterRename != nullptr && afterRename != running);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 2);
+    NL_TEST_ASSERT(inSuite, afterRename != nullptr && BlockEquals(*afterRename, replacement, kBlockSize));
+    NL_TEST_ASSERT(inSuite, BlockEquals(*running, original, 2 * kBlockSize));
+
+    // Truncated and overwritten in place: the transfer reading that file fails past the new end, new ones get the
+    // new file.
+    NL_TEST_ASSERT(inSuite, WriteFile(path, truncated));
+    NL_TEST_ASSERT(inSuite, afterRename != nullptr && ReadBlockSize(*afterRename, kBlockSize) == SIZE_MAX);
+
+    OTAImageCache::Image * afterTruncation = cache.Acquire(path.c_str());
+    NL_TEST_ASSERT(inSuite, afterTruncation != nullptr && afterTruncation != running && afterTruncation != afterRename);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 3);
+    NL_TEST_ASSERT(inSuite, afterTruncation != nullptr && OTAImageCache::GetSize(*afterTruncation) == truncated.size());
+    NL_TEST_ASSERT(inSuite, afterTruncation != nullptr && BlockEquals(*afterTruncation, truncated, 0));
+    NL_TEST_ASSERT(inSuite, BlockEquals(*running, original, kBlockSize));
+
+    cache.Release(running);
+    cache.Release(afterTruncation);
+    cache.Release(afterRename);
+    NL_TEST_ASSERT(inSuite, cache.OpenImageCount() == 0);
+
+    unlink(path.c_str());
+}
+
+int TestOTAImageCache_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int TestOTAImageCache_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test image reuse and release", TestReuseAndRelease),
+    NL_TEST_DEF("Test image file replaced during a transfer", TestFileReplacedDuringTransfer),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestOTAImageCache()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "OTA Image Cache",
+        &sTests[0],
+        TestOTAImageCache_Setup,
+        TestOTAImageCache_Teardown
+    };
+    // clang-format on
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestOTAImageCache);
@@ -77,6 +77,7 @@ constexpr uint16_t kOptionPeriodicQueryTimeout = 'p';
 constexpr uint16_t kOptionUserConsentState     = 'u';
 constexpr uint16_t kOptionWatchdogTimeout      = 'w';
 constexpr uint16_t kSkipExecImageFile          = 's';
+constexpr uint16_t kOptionPipelinedWrites      = 0x100;
 constexpr size_t kMaxFilePathSize              = 256;
 
 uint32_t gPeriodicQueryTimeoutSec = 0;
@@ -86,6 +87,7 @@ static char gOtaDownloadPath[kMaxFilePathSize] = "/tmp/test.bin";
 bool gAutoApplyImage                           = false;
 bool gSendNotifyUpdateApplied                  = true;
 bool gSkipExecImageFile                        = false;
+bool gPipelinedWrites                          = false;
 
 OptionDef cmdLineOptionsDef[] = {
     { "autoApplyImage", chip::ArgParser::kNoArgument, kOptionAutoApplyImage },
@@ -96,6 +98,7 @@ OptionDef cmdLineOptionsDef[] = {
     { "userConsentState", chip::ArgParser::kArgumentRequired, kOptionUserConsentState },
     { "watchdogTimeout", chip::ArgParser::kArgumentRequired, kOptionWatchdogTimeout },
     { "skipExecImageFile", chip::ArgParser::kNoArgument, kSkipExecImageFile },
+    { "pipelinedWrites", chip::ArgParser::kNoArgument, kOptionPipelinedWrites },
     {},
 };
 
@@ -130,6 +133,8 @@ OptionSet cmdLineOptions = {
     "       If none or zero is supplied, the timeout is determined by the driver.\n"
     "  -s, --skipExecImageFile\n"
     "       To only check Notify Update Applied Command, skip the Image File execution.\n"
+    "  --pipelinedWrites\n"
+    "       If supplied, write the downloaded image from a separate thread, acknowledging each block as soon as it is queued.\n"
 };
 
 OptionSet * allOptions[] = { &cmdLineOptions, nullptr };
@@ -213,6 +218,16 @@ static void InitOTARequestor(void)
 
     gImageProcessor.SetOTAImageFile(gOtaDownloadPath);
     gImageProcessor.SetOTADownloader(&gDownloader);
+    gImageProcessor.SetPipelinedWrites(gPipelinedWrites);
+    if (gPipelinedWrites)
+    {
+        // Finalize waits for the writer thread in background work, which would otherwise run on the Matter thread.
+        CHIP_ERROR err = chip::DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(SoftwareUpdate, "Cannot start background tasks: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
 
     // Set the image processor instance used for handling image being downloaded
     gDownloader.SetImageProcessorDelegate(&gImageProcessor);
@@ -283,6 +298,9 @@ bool HandleOptions(const char * aProgram, OptionSet * aOptions, int aIdentifier,
     case kSkipExecImageFile:
         gSkipExecImageFile = true;
         break;
+    case kOptionPipelinedWrites:
+        gPipelinedWrites = true;
+        break;
     default:
         ChipLogError(SoftwareUpdate, "%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
         retval = false;
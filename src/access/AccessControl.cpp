@@ -25,6 +25,8 @@
 
 #include <lib/core/Global.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace Access {
 
@@ -190,6 +192,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateIndex();
     }
 
     return retval;
@@ -218,6 +221,7 @@ CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescripto
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
 
     size_t i = 0;
+    InvalidateIndex();
     ReturnErrorOnFailure(mDelegate->CreateEntry(&i, entry, &fabric));
 
     if (index)
@@ -234,6 +238,7 @@ CHIP_ERROR AccessControl::UpdateEntry(const SubjectDescriptor * subjectDescripto
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
+    InvalidateIndex();
     ReturnErrorOnFailure(mDelegate->UpdateEntry(index, entry, &fabric));
     NotifyEntryChanged(subjectDescriptor, fabric, index, &entry, EntryListener::ChangeType::kUpdated);
     return CHIP_NO_ERROR;
@@ -248,6 +253,7 @@ CHIP_ERROR AccessControl::DeleteEntry(const SubjectDescriptor * subjectDescripto
     {
         p = &entry;
     }
+    InvalidateIndex();
     ReturnErrorOnFailure(mDelegate->DeleteEntry(index, &fabric));
     if (p && p->HasDefaultDelegate())
     {
@@ -355,6 +361,32 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    if (mIndexEnabled && mIndexState == IndexState::kStale)
+    {
+        CHIP_ERROR err = BuildIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogProgress(DataManagement, "AccessControl: not using index %" CHIP_ERROR_FORMAT, err.Format());
+        }
+        mIndexState = (err == CHIP_NO_ERROR) ? IndexState::kValid : IndexState::kUnusable;
+    }
+
+    if (mIndexEnabled && mIndexState == IndexState::kValid)
+    {
+        if (CheckIndex(subjectDescriptor, requestPath, requestPrivilege))
+        {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            return CHIP_NO_ERROR;
+        }
+
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+        return CHIP_ERROR_ACCESS_DENIED;
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -469,6 +501,177 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+CHIP_ERROR AccessControl::BuildIndex()
+{
+    mIndex.Clear();
+
+    EntryIterator iterator;
+    ReturnErrorOnFailure(Entries(iterator));
+
+    Entry entry;
+    while (iterator.Next(entry) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(AddEntryToIndex(entry));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+// Adds one rule per (subject, target) pair of the entry. Entries which Check would reject with
+// CHIP_ERROR_INCORRECT_STATE fail to compile, so that checks keep walking the entries instead.
+CHIP_ERROR AccessControl::AddEntryToIndex(const Entry & entry)
+{
+    using Rule = AccessControlIndex::Rule;
+
+    Rule rule;
+    ReturnErrorOnFailure(entry.GetFabricIndex(rule.fabricIndex));
+    ReturnErrorOnFailure(entry.GetAuthMode(rule.authMode));
+    // Operational PASE not supported for v1.0.
+    VerifyOrReturnError(rule.authMode == AuthMode::kCase || rule.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+
+    Privilege privilege = Privilege::kView;
+    ReturnErrorOnFailure(entry.GetPrivilege(privilege));
+    for (auto requestPrivilege :
+         { Privilege::kView, Privilege::kProxyView, Privilege::kOperate, Privilege::kManage, Privilege::kAdminister })
+    {
+        if (CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, privilege))
+        {
+            rule.grants = static_cast<uint8_t>(rule.grants | to_underlying(requestPrivilege));
+        }
+    }
+
+    size_t subjectCount = 0;
+    size_t targetCount  = 0;
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+    ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+
+    // An entry without subjects (or targets) matches any subject (or target).
+    for (size_t i = 0; i < std::max<size_t>(subjectCount, 1); ++i)
+    {
+        rule.subject    = kUndefinedNodeId;
+        rule.catVersion = 0;
+        rule.flags      = 0;
+        if (subjectCount > 0)
+        {
+            NodeId subject = kUndefinedNodeId;
+            ReturnErrorOnFailure(entry.GetSubject(i, subject));
+            if (IsOperationalNodeId(subject))
+            {
+                VerifyOrReturnError(rule.authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+                rule.subject = subject;
+            }
+            else if (IsCASEAuthTag(subject))
+            {
+                VerifyOrReturnError(rule.authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+                rule.subject    = subject & ~kTagVersionMask;
+                rule.catVersion = GetCASEAuthTagVersion(CASEAuthTagFromNodeId(subject));
+                rule.flags      = Rule::kCat;
+                if (rule.catVersion == 0)
+                {
+                    // Version 0 never matches a CAT of the subject descriptor.
+                    continue;
+                }
+            }
+            else if (IsGroupId(subject))
+            {
+                VerifyOrReturnError(rule.authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+                rule.subject = subject;
+            }
+            else
+            {
+                // Operational PASE not supported for v1.0.
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+        }
+
+        const Rule::Flags subjectFlags = rule.flags;
+        for (size_t j = 0; j < std::max<size_t>(targetCount, 1); ++j)
+        {
+            rule.flags = subjectFlags;
+            if (targetCount > 0)
+            {
+                Entry::Target target;
+                ReturnErrorOnFailure(entry.GetTarget(j, target));
+                if (target.flags & Entry::Target::kCluster)
+                {
+                    rule.flags   = static_cast<Rule::Flags>(rule.flags | Rule::kCluster);
+                    rule.cluster = target.cluster;
+                }
+                if (target.flags & Entry::Target::kEndpoint)
+                {
+                    rule.flags    = static_cast<Rule::Flags>(rule.flags | Rule::kEndpoint);
+                    rule.endpoint = target.endpoint;
+                }
+                if (target.flags & Entry::Target::kDeviceType)
+                {
+                    rule.flags      = static_cast<Rule::Flags>(rule.flags | Rule::kDeviceType);
+                    rule.deviceType = target.deviceType;
+                }
+            }
+            ReturnErrorOnFailure(mIndex.Add(rule));
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool AccessControl::CheckIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                               Privilege requestPrivilege) const
+{
+    using Rule = AccessControlIndex::Rule;
+
+    // Version of the subject descriptor CAT being looked up, if any.
+    uint16_t catVersion = 0;
+
+    auto matcher = [&](const Rule & rule) {
+        if ((rule.grants & to_underlying(requestPrivilege)) == 0)
+        {
+            return false;
+        }
+        if ((rule.flags & Rule::kCat) && rule.catVersion > catVersion)
+        {
+            return false;
+        }
+        // Whether a device type is on an endpoint may change at any time, so it is resolved on each check.
+        return !(rule.flags & Rule::kDeviceType) ||
+            mDeviceTypeResolver->IsDeviceTypeOnEndpoint(rule.deviceType, requestPath.endpoint);
+    };
+
+    const FabricIndex fabricIndex = subjectDescriptor.fabricIndex;
+    const AuthMode authMode       = subjectDescriptor.authMode;
+
+    if (mIndex.Find(fabricIndex, authMode, kUndefinedNodeId, 0, requestPath, matcher))
+    {
+        return true;
+    }
+
+    if (subjectDescriptor.subject != kUndefinedNodeId &&
+        mIndex.Find(fabricIndex, authMode, subjectDescriptor.subject, 0, requestPath, matcher))
+    {
+        return true;
+    }
+
+    if (authMode == AuthMode::kCase)
+    {
+        for (auto cat : subjectDescriptor.cats.values)
+        {
+            if (cat == kUndefinedCAT)
+            {
+                continue;
+            }
+            catVersion = GetCASEAuthTagVersion(cat);
+            if (mIndex.Find(fabricIndex, authMode, NodeIdFromCASEAuthTag(cat) & ~kTagVersionMask, Rule::kCat, requestPath, matcher))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
 {
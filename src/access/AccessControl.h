@@ -26,6 +26,10 @@
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#include "AccessControlIndex.h"
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 // Dump function for use during development only (0 for disabled, non-zero for enabled).
 #define CHIP_ACCESS_CONTROL_DUMP_ENABLED 0
 
@@ -497,6 +501,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +552,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +574,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateIndex();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -641,9 +648,37 @@ public:
     CHIP_ERROR Dump(const Entry & entry);
 #endif
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    /**
+     * Enable or disable use of the compiled index by `Check`. It is enabled by default;
+     * disabling it is mostly useful for testing and benchmarking.
+     */
+    void SetIndexEnabled(bool enabled)
+    {
+        mIndexEnabled = enabled;
+        InvalidateIndex();
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 private:
     bool IsInitialized() const { return (mDelegate != nullptr); }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    enum class IndexState : uint8_t
+    {
+        kStale,    // entries may have changed since the index was built
+        kValid,    // index reflects the current entries
+        kUnusable, // entries could not be compiled, so check against entries
+    };
+
+    void InvalidateIndex() { mIndexState = IndexState::kStale; }
+    CHIP_ERROR BuildIndex();
+    CHIP_ERROR AddEntryToIndex(const Entry & entry);
+    bool CheckIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege) const;
+#else
+    void InvalidateIndex() {}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
     bool IsValid(const Entry & entry);
 
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
@@ -655,6 +690,12 @@ private:
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    AccessControlIndex mIndex;
+    IndexState mIndexState = IndexState::kStale;
+    bool mIndexEnabled     = true;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
 };
 
 /**
@@ -0,0 +1,76 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "AccessControlIndex.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+
+namespace chip {
+namespace Access {
+
+void AccessControlIndex::Clear()
+{
+    for (auto & rule : mRules)
+    {
+        rule = Rule();
+    }
+    mCount         = 0;
+    mKeyFlagsInUse = 0;
+}
+
+CHIP_ERROR AccessControlIndex::Add(const Rule & rule)
+{
+    VerifyOrReturnError(mCount < kMaxRules, CHIP_ERROR_NO_MEMORY);
+
+    Rule normalized = rule;
+    if ((normalized.flags & Rule::kEndpoint) == 0)
+    {
+        normalized.endpoint = 0;
+    }
+    if ((normalized.flags & Rule::kCluster) == 0)
+    {
+        normalized.cluster = 0;
+    }
+    normalized.flags = static_cast<Rule::Flags>(normalized.flags | Rule::kInUse);
+
+    // Rules are never removed individually, so the first free slot in the probe sequence can be used.
+    size_t slot = Hash(normalized);
+    while (mRules[slot & (kCapacity - 1)].flags & Rule::kInUse)
+    {
+        ++slot;
+    }
+    mRules[slot & (kCapacity - 1)] = normalized;
+    mKeyFlagsInUse = static_cast<uint16_t>(mKeyFlagsInUse | KeyFlagsBit(normalized.flags));
+    ++mCount;
+    return CHIP_NO_ERROR;
+}
+
+size_t AccessControlIndex::Hash(const Rule & key)
+{
+    uint64_t hash = key.subject;
+    hash ^= (static_cast<uint64_t>(key.fabricIndex) << 56) ^ (static_cast<uint64_t>(to_underlying(key.authMode)) << 48) ^
+        (static_cast<uint64_t>(key.flags & Rule::kKeyFlags) << 40) ^ (static_cast<uint64_t>(key.endpoint) << 24) ^ key.cluster;
+
+    // Fibonacci hashing, folding the well-mixed high bits into the low bits used for the slot.
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+} // namespace Access
+} // namespace chip
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "AuthMode.h"
+#include "RequestPath.h"
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Access {
+
+/**
+ * Compiled form of the access control entries, used by AccessControl::Check.
+ *
+ * Each entry is expanded into one rule per (subject, target) pair. Rules are kept in an
+ * open-addressing hash table keyed by fabric, auth mode, subject and the endpoint and cluster
+ * of the target, each of which may be a wildcard. A check is then a fixed number of lookups:
+ * one per candidate subject (the node or group, each CAT, or any subject) and target shape
+ * (endpoint and cluster, endpoint only, cluster only, or any target).
+ *
+ * The index holds no references to the entries. It is cleared and refilled as a whole.
+ */
+class AccessControlIndex
+{
+public:
+    struct Rule
+    {
+        using Flags                        = uint8_t;
+        static constexpr Flags kCluster    = 1 << 0;
+        static constexpr Flags kEndpoint   = 1 << 1;
+        static constexpr Flags kDeviceType = 1 << 2;
+        static constexpr Flags kCat        = 1 << 3; // subject is a CAT identifier, see catVersion
+        static constexpr Flags kInUse      = 1 << 7;
+
+        // Flags which are part of the hash key.
+        static constexpr Flags kKeyFlags = kCluster | kEndpoint | kCat;
+
+        NodeId subject          = kUndefinedNodeId; // kUndefinedNodeId for any subject
+        ClusterId cluster       = 0;
+        DeviceTypeId deviceType = 0;
+        EndpointId endpoint     = 0;
+        uint16_t catVersion     = 0; // minimum CAT version, if kCat
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        AuthMode authMode       = AuthMode::kNone;
+        uint8_t grants          = 0; // bitmask of request privileges allowed by this rule
+        Flags flags             = 0;
+    };
+
+    static constexpr size_t kCapacity = CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY;
+    static constexpr size_t kMaxRules = kCapacity - kCapacity / 4;
+
+    static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                  "CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY must be a power of two");
+
+    void Clear();
+
+    /**
+     * Add a rule. Unset endpoint or cluster values are ignored.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY if the index is full.
+     */
+    CHIP_ERROR Add(const Rule & rule);
+
+    size_t Count() const { return mCount; }
+
+    /**
+     * Look up the rules for a subject that apply to a request path.
+     *
+     * @param [in] fabricIndex  Fabric of the subject.
+     * @param [in] authMode     Auth mode of the subject.
+     * @param [in] subject      Subject to look up, or kUndefinedNodeId for rules which apply to any subject.
+     * @param [in] subjectFlags Rule::kCat if subject is a CAT identifier (with version 0), otherwise 0.
+     * @param [in] requestPath  Request path, also matched against rules for any endpoint and/or cluster.
+     * @param [in] matcher      Called with each candidate rule. Returns true to stop looking.
+     *
+     * @return true if `matcher` returned true for some rule.
+     */
+    template <typename Matcher>
+    bool Find(FabricIndex fabricIndex, AuthMode authMode, NodeId subject, Rule::Flags subjectFlags,
+              const RequestPath & requestPath, Matcher && matcher) const
+    {
+        static constexpr Rule::Flags kTargetShapes[] = { Rule::kEndpoint | Rule::kCluster, Rule::kEndpoint, Rule::kCluster, 0 };
+
+        Rule key;
+        key.fabricIndex = fabricIndex;
+        key.authMode    = authMode;
+        key.subject     = subject;
+        for (Rule::Flags shape : kTargetShapes)
+        {
+            key.flags = static_cast<Rule::Flags>(subjectFlags | shape);
+            if ((mKeyFlagsInUse & KeyFlagsBit(key.flags)) == 0)
+            {
+                continue;
+            }
+            key.endpoint = (shape & Rule::kEndpoint) ? requestPath.endpoint : 0;
+            key.cluster  = (shape & Rule::kCluster) ? requestPath.cluster : 0;
+
+            for (size_t slot = Hash(key), probes = 0; probes < kCapacity; ++slot, ++probes)
+            {
+                const Rule & rule = mRules[slot & (kCapacity - 1)];
+                if ((rule.flags & Rule::kInUse) == 0)
+                {
+                    break;
+                }
+                if (SameKey(rule, key) && matcher(rule))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    static size_t Hash(const Rule & key);
+    static constexpr uint16_t KeyFlagsBit(Rule::Flags flags) { return static_cast<uint16_t>(1u << (flags & Rule::kKeyFlags)); }
+
+    static bool SameKey(const Rule & a, const Rule & b)
+    {
+        return a.subject == b.subject && a.cluster == b.cluster && a.endpoint == b.endpoint && a.fabricIndex == b.fabricIndex &&
+            a.authMode == b.authMode && (a.flags & Rule::kKeyFlags) == (b.flags & Rule::kKeyFlags);
+    }
+
+    Rule mRules[kCapacity];
+    size_t mCount = 0;
+    // Combinations of key flags used by any rule, so lookups for other combinations can be skipped.
+    uint16_t mKeyFlagsInUse = 0;
+};
+
+} // namespace Access
+} // namespace chip
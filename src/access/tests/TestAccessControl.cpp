@@ -20,6 +20,9 @@
 #include "access/examples/ExampleAccessControlDelegate.h"
 
 #include <lib/core/CHIPCore.h>
+#include <system/SystemClock.h>
+
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -1754,6 +1757,55 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+TEST_F(TestAccessControl, BenchmarkCheckIndex)
+{
+    // Like a wildcard read on a bridge: every subject from checkData1 checks every cluster on many endpoints,
+    // first by walking the entries, then using the compiled index. Both must give the same results.
+    constexpr EndpointId kEndpointCount = 300;
+    constexpr ClusterId kClusters[]     = { kOnOffCluster, kLevelControlCluster, kAccessControlCluster, kColorControlCluster };
+    constexpr Privilege kPrivileges[]   = { Privilege::kView, Privilege::kProxyView, Privilege::kOperate, Privilege::kManage,
+                                            Privilege::kAdminister };
+
+    ASSERT_EQ(LoadAccessControl(accessControl, entryData1, entryData1Count), CHIP_NO_ERROR);
+
+    // Denied checks are logged, which would dominate the measurement.
+    const uint8_t logFilter = Logging::GetLogFilter();
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+
+    std::vector<bool> results[2];
+    uint64_t elapsedUs[2] = {};
+    for (size_t useIndex = 0; useIndex < 2; ++useIndex)
+    {
+        accessControl.SetIndexEnabled(useIndex != 0);
+        const uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (const auto & checkData : checkData1)
+        {
+            for (EndpointId endpoint = 0; endpoint < kEndpointCount; ++endpoint)
+            {
+                for (auto cluster : kClusters)
+                {
+                    for (auto privilege : kPrivileges)
+                    {
+                        RequestPath requestPath{ .cluster = cluster, .endpoint = endpoint };
+                        results[useIndex].push_back(accessControl.Check(checkData.subjectDescriptor, requestPath, privilege) ==
+                                                    CHIP_NO_ERROR);
+                    }
+                }
+            }
+        }
+        elapsedUs[useIndex] = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+    }
+    accessControl.SetIndexEnabled(true);
+
+    Logging::SetLogFilter(logFilter);
+
+    EXPECT_EQ(results[0], results[1]);
+    ChipLogProgress(DataManagement, "%u checks: %u us walking entries, %u us using index", static_cast<unsigned>(results[0].size()),
+                    static_cast<unsigned>(elapsedUs[0]), static_cast<unsigned>(elapsedUs[1]));
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
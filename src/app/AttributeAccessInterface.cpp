@@ -55,6 +55,23 @@ CHIP_ERROR AttributeReportBuilder::FinishAttribute(AttributeReportIBs::Builder &
     return aAttributeReportIBsBuilder.GetAttributeReport().EndOfAttributeReportIB();
 }
 
+CHIP_ERROR AttributeReportBuilder::GetFramingSize(const ConcreteDataAttributePath & aPath, DataVersion aDataVersion,
+                                                  uint32_t & aSize)
+{
+    TLV::TlvCountingWriter writer;
+    AttributeReportIBs::Builder attributeReportIBsBuilder;
+    ReturnErrorOnFailure(attributeReportIBsBuilder.Init(&writer));
+
+    // Only count what is written for the AttributeReportIB itself, not the array around it.
+    const uint32_t lengthBefore = writer.GetLengthWritten();
+    AttributeReportBuilder builder;
+    ReturnErrorOnFailure(builder.PrepareAttribute(attributeReportIBsBuilder, aPath, aDataVersion));
+    ReturnErrorOnFailure(builder.FinishAttribute(attributeReportIBsBuilder));
+
+    aSize = writer.GetLengthWritten() - lengthBefore;
+    return CHIP_NO_ERROR;
+}
+
 namespace {
 
 constexpr uint32_t kEndOfListByteCount = 1;
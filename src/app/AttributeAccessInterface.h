@@ -30,6 +30,7 @@
 #include <app/util/basic-types.h>
 #include <lib/core/Optional.h>
 #include <lib/core/TLV.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <lib/support/logging/CHIPLogging.h>
 
 /**
@@ -73,6 +74,12 @@ public:
      */
     CHIP_ERROR FinishAttribute(AttributeReportIBs::Builder & aAttributeReportIBs);
 
+    /**
+     * GetFramingSize works out, without writing anything, how many bytes PrepareAttribute and FinishAttribute together
+     * encode around the value of an attribute report for the given path and data version.
+     */
+    static CHIP_ERROR GetFramingSize(const ConcreteDataAttributePath & aPath, DataVersion aDataVersion, uint32_t & aSize);
+
     /**
      * EncodeValue encodes the value field of the report, it should be called exactly once.
      */
@@ -90,6 +97,24 @@ public:
         return DataModel::EncodeForRead(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag,
                                         accessingFabricIndex, item, std::forward<Ts>(aArgs)...);
     }
+
+    /**
+     * CheckValueFits checks, without writing anything, that the value EncodeValue would encode for the same arguments
+     * takes at most aMaxSize bytes.  Returns CHIP_ERROR_BUFFER_TOO_SMALL if it does not.
+     */
+    template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
+    static CHIP_ERROR CheckValueFits(uint32_t aMaxSize, TLV::Tag tag, T && item, Ts &&... aArgs)
+    {
+        TLV::TlvCountingWriter writer(aMaxSize);
+        return DataModel::Encode(writer, tag, item, std::forward<Ts>(aArgs)...);
+    }
+
+    template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
+    static CHIP_ERROR CheckValueFits(uint32_t aMaxSize, TLV::Tag tag, FabricIndex accessingFabricIndex, T && item, Ts &&... aArgs)
+    {
+        TLV::TlvCountingWriter writer(aMaxSize);
+        return DataModel::EncodeForRead(writer, tag, accessingFabricIndex, item, std::forward<Ts>(aArgs)...);
+    }
 };
 
 /**
@@ -273,6 +298,8 @@ private:
         CHIP_ERROR err;
         if (mEncodingInitialList)
         {
+            ReturnErrorOnFailure(CheckValueFits(TLV::AnonymousTag(), aArgs...));
+
             // Just encode a single item, with an anonymous tag.
             AttributeReportBuilder builder;
             err = builder.EncodeValue(mAttributeReportIBsBuilder, TLV::AnonymousTag(), std::forward<Ts>(aArgs)...);
@@ -307,6 +334,8 @@ private:
     template <typename... Ts>
     CHIP_ERROR EncodeAttributeReportIB(Ts &&... aArgs)
     {
+        ReturnErrorOnFailure(CheckAttributeReportIBFits(aArgs...));
+
         AttributeReportBuilder builder;
         ReturnErrorOnFailure(builder.PrepareAttribute(mAttributeReportIBsBuilder, mPath, mDataVersion));
         ReturnErrorOnFailure(builder.EncodeValue(mAttributeReportIBsBuilder, TLV::ContextTag(AttributeDataIB::Tag::kData),
@@ -315,6 +344,47 @@ private:
         return builder.FinishAttribute(mAttributeReportIBsBuilder);
     }
 
+    /**
+     * Once the report is nearly full (see CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW), checks that a value can fit
+     * in the space left before encoding it, so that one which cannot is left for the next chunk without being partly
+     * encoded and rolled back.
+     */
+    template <typename... Ts>
+    CHIP_ERROR CheckValueFits(TLV::Tag aTag, Ts &... aArgs)
+    {
+#if CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+        const TLV::TLVWriter * writer = mAttributeReportIBsBuilder.GetWriter();
+        if (writer->GetRemainingFreeLength() < CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW &&
+            writer->IsRemainingFreeLengthFinal())
+        {
+            return AttributeReportBuilder::CheckValueFits(writer->GetRemainingFreeLength(), aTag, aArgs...);
+        }
+#endif // CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Like CheckValueFits, but for a whole AttributeReportIB holding the value: the path, data version and containers
+     * EncodeAttributeReportIB writes around the value have to fit in the space left as well.
+     */
+    template <typename... Ts>
+    CHIP_ERROR CheckAttributeReportIBFits(Ts &... aArgs)
+    {
+#if CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+        const TLV::TLVWriter * writer = mAttributeReportIBsBuilder.GetWriter();
+        if (writer->GetRemainingFreeLength() < CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW &&
+            writer->IsRemainingFreeLengthFinal())
+        {
+            uint32_t framingSize;
+            ReturnErrorOnFailure(AttributeReportBuilder::GetFramingSize(mPath, mDataVersion, framingSize));
+            VerifyOrReturnError(framingSize <= writer->GetRemainingFreeLength(), CHIP_ERROR_BUFFER_TOO_SMALL);
+            return AttributeReportBuilder::CheckValueFits(writer->GetRemainingFreeLength() - framingSize,
+                                                          TLV::ContextTag(AttributeDataIB::Tag::kData), aArgs...);
+        }
+#endif // CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * EnsureListStarted sets our mCurrentEncodingListIndex to 0, and:
      *
@@ -0,0 +1,114 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeValueCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+size_t AttributeValueCache::HomeSlot(const ConcreteAttributePath & aPath)
+{
+    uint32_t hash = (static_cast<uint32_t>(aPath.mEndpointId) * 0x9E3779B1u) ^ (aPath.mClusterId * 0x85EBCA77u) ^
+        (aPath.mAttributeId * 0xC2B2AE3Du);
+    return (hash ^ (hash >> 16)) % kEntryCount;
+}
+
+ByteSpan AttributeValueCache::Find(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                                   DataVersionCheck aIsCurrent)
+{
+    size_t slot = HomeSlot(aPath);
+    for (size_t i = 0; i < kProbeWindow; ++i, slot = (slot + 1) % kEntryCount)
+    {
+        const Entry & entry = mEntries[slot];
+        if (entry.Matches(aPath, aAccessingFabricIndex, aIsFabricFiltered) && aIsCurrent(aPath, entry.version))
+        {
+            mStats.hits++;
+            return ByteSpan(entry.data, entry.length);
+        }
+    }
+
+    mStats.misses++;
+    return ByteSpan();
+}
+
+CHIP_ERROR AttributeValueCache::Store(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex,
+                                      bool aIsFabricFiltered, DataVersion aVersion, ByteSpan aEncoded)
+{
+    VerifyOrReturnError(aEncoded.size() <= kMaxValueSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(!aEncoded.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Prefer the entry for the same key, then an unused entry, then the oldest entry of the window.
+    Entry * target = nullptr;
+    size_t slot    = HomeSlot(aPath);
+    for (size_t i = 0; i < kProbeWindow; ++i, slot = (slot + 1) % kEntryCount)
+    {
+        Entry & entry = mEntries[slot];
+        if (entry.Matches(aPath, aAccessingFabricIndex, aIsFabricFiltered))
+        {
+            target = &entry;
+            break;
+        }
+        if (target == nullptr || (target->InUse() && (!entry.InUse() || IsStoredBefore(entry, *target))))
+        {
+            target = &entry;
+        }
+    }
+
+    if (target->InUse() && !target->Matches(aPath, aAccessingFabricIndex, aIsFabricFiltered))
+    {
+        mStats.evictions++;
+    }
+
+    target->path             = aPath;
+    target->fabricIndex      = aAccessingFabricIndex;
+    target->isFabricFiltered = aIsFabricFiltered;
+    target->version          = aVersion;
+    target->storedAt         = mStoreCount++;
+    target->length           = static_cast<uint16_t>(aEncoded.size());
+    memcpy(target->data, aEncoded.data(), aEncoded.size());
+    mStats.stores++;
+
+    return CHIP_NO_ERROR;
+}
+
+void AttributeValueCache::Invalidate(const AttributePathParams & aPath)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.InUse() && (aPath.HasWildcardEndpointId() || aPath.mEndpointId == entry.path.mEndpointId) &&
+            (aPath.HasWildcardClusterId() || aPath.mClusterId == entry.path.mClusterId))
+        {
+            entry.length = 0;
+        }
+    }
+}
+
+void AttributeValueCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.length = 0;
+    }
+}
+
+} // namespace app
+} // namespace chip
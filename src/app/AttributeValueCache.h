@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief Cache of encoded attribute values, used by the reporting engine.
+ *
+ * Each entry holds the TLV encoding of an AttributeReportIBs array with a single
+ * AttributeReportIB, as produced by reading one attribute for a given accessing
+ * fabric and fabric filtering. An entry is only returned while its cluster is still
+ * at the DataVersion it was encoded with, so outdated entries are never used even
+ * before they are invalidated.
+ *
+ * Entries are placed by hashing their path into a window of kProbeWindow slots;
+ * when the window is full the least recently stored entry in it is replaced.
+ */
+class AttributeValueCache
+{
+public:
+    static constexpr size_t kEntryCount   = CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES;
+    static constexpr size_t kMaxValueSize = CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE;
+    static constexpr size_t kProbeWindow  = kEntryCount < 4 ? kEntryCount : 4;
+
+    static_assert(kEntryCount > 0, "CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES must not be zero");
+    static_assert(kMaxValueSize <= UINT16_MAX, "CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE is too large");
+
+    /**
+     * Returns whether the given cluster is currently at the given DataVersion.
+     */
+    using DataVersionCheck = bool (*)(const ConcreteClusterPath & aPath, DataVersion aVersion);
+
+    struct Stats
+    {
+        uint32_t hits      = 0;
+        uint32_t misses    = 0;
+        uint32_t stores    = 0;
+        uint32_t evictions = 0;
+    };
+
+    /**
+     * Look up the encoding of an attribute read.
+     *
+     * @return The stored encoding, or an empty span if there is none for the current DataVersion of the cluster
+     *         (as reported by aIsCurrent).
+     */
+    ByteSpan Find(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                  DataVersionCheck aIsCurrent);
+
+    /**
+     * Store the encoding of an attribute read made at the given DataVersion, replacing any previous one.
+     *
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if the encoding is larger than kMaxValueSize.
+     */
+    CHIP_ERROR Store(const ConcreteAttributePath & aPath, FabricIndex aAccessingFabricIndex, bool aIsFabricFiltered,
+                     DataVersion aVersion, ByteSpan aEncoded);
+
+    /**
+     * Drop the entries for all attributes of the clusters matched by aPath. The attribute id of aPath is
+     * ignored, since a change to any attribute changes the DataVersion of the whole cluster.
+     */
+    void Invalidate(const AttributePathParams & aPath);
+
+    void Clear();
+
+    const Stats & GetStats() const { return mStats; }
+
+private:
+    struct Entry
+    {
+        ConcreteAttributePath path;
+        DataVersion version     = 0;
+        uint32_t storedAt       = 0; // Value of mStoreCount when stored, used to pick an entry to replace.
+        uint16_t length         = 0; // 0 for an unused entry.
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        bool isFabricFiltered   = false;
+        uint8_t data[kMaxValueSize];
+
+        bool InUse() const { return length != 0; }
+        bool Matches(const ConcreteAttributePath & aPath, FabricIndex aFabricIndex, bool aIsFabricFiltered) const
+        {
+            return InUse() && path == aPath && fabricIndex == aFabricIndex && isFabricFiltered == aIsFabricFiltered;
+        }
+    };
+
+    static size_t HomeSlot(const ConcreteAttributePath & aPath);
+
+    // Store counts may wrap around, so compare them as distances.
+    static bool IsStoredBefore(const Entry & a, const Entry & b) { return b.storedAt - a.storedAt - 1 < UINT32_MAX / 2; }
+
+    Entry mEntries[kEntryCount];
+    uint32_t mStoreCount = 0;
+    Stats mStats;
+};
+
+} // namespace app
+} // namespace chip
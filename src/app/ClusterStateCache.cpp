@@ -17,9 +17,9 @@
  */
 
 #include "system/SystemPacketBuffer.h"
+#include <algorithm>
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
-#include <tuple>
 
 namespace chip {
 namespace app {
@@ -64,9 +64,100 @@ CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ClusterStateCache::SetStorageMode(StorageMode aMode)
+{
+    VerifyOrReturnError(mCache.empty() && mFlatClusters.empty(), CHIP_ERROR_INCORRECT_STATE);
+    mStorageMode = aMode;
+    return CHIP_NO_ERROR;
+}
+
+ClusterStateCache::MemoryStats ClusterStateCache::GetMemoryStats() const
+{
+    MemoryStats stats;
+
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        stats.attributeCount = mFlatAttributes.size();
+        stats.clusterCount   = mFlatClusters.size();
+        stats.dataBytes      = mArena.size() - mArenaDeadBytes;
+        stats.indexBytes     = mFlatAttributes.capacity() * sizeof(FlatAttribute) + mFlatClusters.capacity() * sizeof(FlatCluster);
+        stats.allocations    = (mFlatAttributes.capacity() > 0) + (mFlatClusters.capacity() > 0) + (mArena.capacity() > 0);
+        stats.arenaBytes     = mArena.capacity();
+        stats.deadBytes      = mArenaDeadBytes;
+        stats.compactions    = mArenaCompactions;
+        return stats;
+    }
+
+    for (auto const & endpointIter : mCache)
+    {
+        stats.indexBytes += sizeof(NodeState::value_type);
+        stats.allocations++;
+
+        for (auto const & clusterIter : endpointIter.second)
+        {
+            stats.clusterCount++;
+            stats.indexBytes += sizeof(EndpointState::value_type);
+            stats.allocations++;
+
+            for (auto const & attributeIter : clusterIter.second.mAttributes)
+            {
+                stats.attributeCount++;
+                stats.indexBytes += sizeof(std::map<AttributeId, AttributeState>::value_type);
+                stats.allocations++;
+
+                if (attributeIter.second.Is<AttributeData>())
+                {
+                    stats.dataBytes += attributeIter.second.Get<AttributeData>().AllocatedSize();
+                    stats.allocations++;
+                }
+            }
+        }
+    }
+
+    return stats;
+}
+
+void ClusterStateCache::UpdateDataVersions(const ConcreteDataAttributePath & aPath)
+{
+    //
+    // Clear out the committed data version and only set it again once we have received all data for this cluster.
+    // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
+    //
+    GetClusterDataVersions(aPath.mEndpointId, aPath.mClusterId).mCommittedDataVersion.ClearValue();
+
+    // This commits a pending data version if the last report path is valid and it is different from the current path.
+    if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
+    {
+        CommitPendingDataVersion();
+    }
+
+    bool foundEncompassingWildcardPath = false;
+    for (const auto & path : mRequestPathSet)
+    {
+        if (path.IncludesAllAttributesInCluster(aPath))
+        {
+            foundEncompassingWildcardPath = true;
+            break;
+        }
+    }
+
+    // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
+    if (foundEncompassingWildcardPath)
+    {
+        GetClusterDataVersions(aPath.mEndpointId, aPath.mClusterId).mPendingDataVersion = aPath.mDataVersion;
+    }
+
+    mLastReportDataPath = aPath;
+}
+
 CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
                                           const StatusIB & aStatus)
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        return UpdateFlatCache(aPath, apData, aStatus);
+    }
+
     AttributeState state;
     bool endpointIsNew = false;
 
@@ -100,35 +191,8 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         {
             state.Set<size_t>(elementSize);
         }
-        //
-        // Clear out the committed data version and only set it again once we have received all data for this cluster.
-        // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
-        //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
 
-        // This commits a pending data version if the last report path is valid and it is different from the current path.
-        if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
-        {
-            CommitPendingDataVersion();
-        }
-
-        bool foundEncompassingWildcardPath = false;
-        for (const auto & path : mRequestPathSet)
-        {
-            if (path.IncludesAllAttributesInCluster(aPath))
-            {
-                foundEncompassingWildcardPath = true;
-                break;
-            }
-        }
-
-        // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
-        if (foundEncompassingWildcardPath)
-        {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
-        }
-
-        mLastReportDataPath = aPath;
+        UpdateDataVersions(aPath);
     }
     else
     {
@@ -155,7 +219,127 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
 
     if (mCacheData)
     {
-        mChangedAttributeSet.insert(aPath);
+        mChangedAttributes.push_back(aPath);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCache::AppendToArena(TLV::TLVReader & aData, uint32_t & aLength)
+{
+    size_t elementSize = 0;
+    ReturnErrorOnFailure(GetElementTLVSize(&aData, elementSize));
+
+    const size_t offset = mArena.size();
+    VerifyOrReturnError(elementSize <= UINT32_MAX - offset, CHIP_ERROR_NO_MEMORY);
+
+    mArena.resize(offset + elementSize);
+
+    TLV::TLVWriter writer;
+    writer.Init(mArena.data() + offset, elementSize);
+    CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), aData);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+
+    aLength = (err == CHIP_NO_ERROR) ? writer.GetLengthWritten() : 0;
+    mArena.resize(offset + aLength);
+    return err;
+}
+
+void ClusterStateCache::CompactArena()
+{
+    std::vector<uint8_t> arena;
+    arena.reserve(mArena.size() - mArenaDeadBytes);
+
+    for (auto & attribute : mFlatAttributes)
+    {
+        if (attribute.mKind != FlatValueKind::kData)
+        {
+            continue;
+        }
+
+        const uint8_t * value = mArena.data() + attribute.mOffset;
+        attribute.mOffset     = static_cast<uint32_t>(arena.size());
+        arena.insert(arena.end(), value, value + attribute.mLength);
+    }
+
+    mArena.swap(arena);
+    mArenaDeadBytes = 0;
+    mArenaCompactions++;
+}
+
+CHIP_ERROR ClusterStateCache::UpdateFlatCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                              const StatusIB & aStatus)
+{
+    const uint64_t clusterKey = FlatClusterKey(aPath.mEndpointId, aPath.mClusterId);
+    auto firstCluster         = LowerBoundFlatCluster(FlatClusterKey(aPath.mEndpointId, 0));
+
+    // As for the tree storage, remember whether this endpoint is new so that we can notify our clients about it.
+    bool endpointIsNew = (firstCluster == mFlatClusters.end() || FlatEndpointIdOf(firstCluster->mClusterKey) != aPath.mEndpointId);
+
+    FlatAttribute attribute;
+    attribute.mClusterKey  = clusterKey;
+    attribute.mAttributeId = aPath.mAttributeId;
+
+    if (apData)
+    {
+        if (mCacheData)
+        {
+            attribute.mKind   = FlatValueKind::kData;
+            attribute.mOffset = static_cast<uint32_t>(mArena.size());
+            ReturnErrorOnFailure(AppendToArena(*apData, attribute.mLength));
+        }
+        else
+        {
+            size_t elementSize = 0;
+            ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+            VerifyOrReturnError(elementSize <= UINT32_MAX, CHIP_ERROR_NO_MEMORY);
+            attribute.mLength = static_cast<uint32_t>(elementSize);
+        }
+
+        UpdateDataVersions(aPath);
+    }
+    else
+    {
+        attribute.mKind   = mCacheData ? FlatValueKind::kStatus : FlatValueKind::kSize;
+        attribute.mLength = static_cast<uint32_t>(SizeOfStatusIB(aStatus));
+        attribute.mStatus = aStatus;
+    }
+
+    if (endpointIsNew)
+    {
+        mAddedEndpoints.push_back(aPath.mEndpointId);
+    }
+
+    GetOrCreateFlatCluster(aPath.mEndpointId, aPath.mClusterId);
+
+    // Reports usually walk paths in order, so new attributes are normally appended.
+    if (mFlatAttributes.empty() || mFlatAttributes.back().IsBefore(clusterKey, aPath.mAttributeId))
+    {
+        mFlatAttributes.push_back(attribute);
+    }
+    else
+    {
+        auto iter = mFlatAttributes.begin() + (LowerBoundFlatAttribute(clusterKey, aPath.mAttributeId) - mFlatAttributes.cbegin());
+        if (iter != mFlatAttributes.end() && iter->mClusterKey == clusterKey && iter->mAttributeId == aPath.mAttributeId)
+        {
+            if (iter->mKind == FlatValueKind::kData)
+            {
+                mArenaDeadBytes += iter->mLength;
+            }
+            *iter = attribute;
+        }
+        else
+        {
+            mFlatAttributes.insert(iter, attribute);
+        }
+    }
+
+    if (mCacheData)
+    {
+        mChangedAttributes.push_back(aPath);
     }
 
     return CHIP_NO_ERROR;
@@ -211,7 +395,7 @@ CHIP_ERROR ClusterStateCache::UpdateEventCache(const EventHeader & aEventHeader,
 void ClusterStateCache::OnReportBegin()
 {
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    mChangedAttributeSet.clear();
+    mChangedAttributes.clear();
     mAddedEndpoints.clear();
     mCallback.OnReportBegin();
 }
@@ -223,7 +407,7 @@ void ClusterStateCache::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
+    auto & lastClusterInfo = GetClusterDataVersions(mLastReportDataPath.mEndpointId, mLastReportDataPath.mClusterId);
     if (lastClusterInfo.mPendingDataVersion.HasValue())
     {
         lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
@@ -235,21 +419,34 @@ void ClusterStateCache::OnReportEnd()
 {
     CommitPendingDataVersion();
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    std::set<std::tuple<EndpointId, ClusterId>> changedClusters;
 
-    //
-    // Add the EndpointId and ClusterId into a set so that we only
-    // convey unique combinations in the subsequent OnClusterChanged callback.
-    //
-    for (auto & path : mChangedAttributeSet)
+    if (mArenaDeadBytes >= kArenaCompactionMinDeadBytes && mArenaDeadBytes >= mArena.size() - mArenaDeadBytes)
+    {
+        CompactArena();
+    }
+
+    std::sort(mChangedAttributes.begin(), mChangedAttributes.end());
+    mChangedAttributes.erase(std::unique(mChangedAttributes.begin(), mChangedAttributes.end()), mChangedAttributes.end());
+
+    for (auto & path : mChangedAttributes)
     {
         mCallback.OnAttributeChanged(this, path);
-        changedClusters.insert(std::make_tuple(path.mEndpointId, path.mClusterId));
     }
 
-    for (auto & item : changedClusters)
+    //
+    // The paths are sorted, so all changed attributes of a cluster are adjacent and each
+    // cluster is conveyed only once in the OnClusterChanged callback.
+    //
+    ConcreteClusterPath lastChangedCluster(kInvalidEndpointId, kInvalidClusterId);
+    for (auto & path : mChangedAttributes)
     {
-        mCallback.OnClusterChanged(this, std::get<0>(item), std::get<1>(item));
+        if (lastChangedCluster == path)
+        {
+            continue;
+        }
+
+        lastChangedCluster = path;
+        mCallback.OnClusterChanged(this, path.mEndpointId, path.mClusterId);
     }
 
     for (auto endpoint : mAddedEndpoints)
@@ -262,6 +459,17 @@ void ClusterStateCache::OnReportEnd()
 
 CHIP_ERROR ClusterStateCache::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        auto attribute = GetFlatAttribute(path.mEndpointId, path.mClusterId, path.mAttributeId);
+        VerifyOrReturnError(attribute != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(attribute->mKind != FlatValueKind::kStatus, CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+        VerifyOrReturnError(attribute->mKind == FlatValueKind::kData, CHIP_ERROR_KEY_NOT_FOUND);
+
+        reader.Init(mArena.data() + attribute->mOffset, attribute->mLength);
+        return reader.Next();
+    }
+
     CHIP_ERROR err;
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
     ReturnErrorOnFailure(err);
@@ -348,6 +556,76 @@ const ClusterStateCache::AttributeState * ClusterStateCache::GetAttributeState(E
     return &attributeState->second;
 }
 
+std::vector<ClusterStateCache::FlatCluster>::const_iterator ClusterStateCache::LowerBoundFlatCluster(uint64_t clusterKey) const
+{
+    return std::lower_bound(mFlatClusters.begin(), mFlatClusters.end(), clusterKey,
+                            [](const FlatCluster & cluster, uint64_t key) { return cluster.mClusterKey < key; });
+}
+
+std::vector<ClusterStateCache::FlatAttribute>::const_iterator
+ClusterStateCache::LowerBoundFlatAttribute(uint64_t clusterKey, AttributeId attributeId) const
+{
+    return std::lower_bound(mFlatAttributes.begin(), mFlatAttributes.end(), std::make_pair(clusterKey, attributeId),
+                            [](const FlatAttribute & attribute, const std::pair<uint64_t, AttributeId> & key) {
+                                return attribute.IsBefore(key.first, key.second);
+                            });
+}
+
+const ClusterStateCache::FlatCluster * ClusterStateCache::GetFlatCluster(EndpointId endpointId, ClusterId clusterId) const
+{
+    const uint64_t clusterKey = FlatClusterKey(endpointId, clusterId);
+    auto iter                 = LowerBoundFlatCluster(clusterKey);
+    if (iter == mFlatClusters.end() || iter->mClusterKey != clusterKey)
+    {
+        return nullptr;
+    }
+
+    return &(*iter);
+}
+
+const ClusterStateCache::FlatAttribute * ClusterStateCache::GetFlatAttribute(EndpointId endpointId, ClusterId clusterId,
+                                                                             AttributeId attributeId) const
+{
+    const uint64_t clusterKey = FlatClusterKey(endpointId, clusterId);
+    auto iter                 = LowerBoundFlatAttribute(clusterKey, attributeId);
+    if (iter == mFlatAttributes.end() || iter->mClusterKey != clusterKey || iter->mAttributeId != attributeId)
+    {
+        return nullptr;
+    }
+
+    return &(*iter);
+}
+
+ClusterStateCache::FlatCluster & ClusterStateCache::GetOrCreateFlatCluster(EndpointId endpointId, ClusterId clusterId)
+{
+    const uint64_t clusterKey = FlatClusterKey(endpointId, clusterId);
+
+    // Reports usually walk paths in order, so new clusters are normally appended.
+    if (mFlatClusters.empty() || mFlatClusters.back().mClusterKey < clusterKey)
+    {
+        mFlatClusters.emplace_back(clusterKey);
+        return mFlatClusters.back();
+    }
+
+    auto iter = mFlatClusters.begin() + (LowerBoundFlatCluster(clusterKey) - mFlatClusters.cbegin());
+    if (iter == mFlatClusters.end() || iter->mClusterKey != clusterKey)
+    {
+        iter = mFlatClusters.insert(iter, FlatCluster(clusterKey));
+    }
+
+    return *iter;
+}
+
+ClusterStateCache::ClusterDataVersions & ClusterStateCache::GetClusterDataVersions(EndpointId endpointId, ClusterId clusterId)
+{
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        return GetOrCreateFlatCluster(endpointId, clusterId);
+    }
+
+    return mCache[endpointId][clusterId];
+}
+
 const ClusterStateCache::EventData * ClusterStateCache::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
 {
     EventData compareKey;
@@ -397,6 +675,15 @@ void ClusterStateCache::OnAttributeData(const ConcreteDataAttributePath & aPath,
 CHIP_ERROR ClusterStateCache::GetVersion(const ConcreteClusterPath & aPath, Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        auto cluster = GetFlatCluster(aPath.mEndpointId, aPath.mClusterId);
+        VerifyOrReturnError(cluster != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        aVersion = cluster->mCommittedDataVersion;
+        return CHIP_NO_ERROR;
+    }
+
     CHIP_ERROR err;
     auto clusterState = GetClusterState(aPath.mEndpointId, aPath.mClusterId, err);
     ReturnErrorOnFailure(err);
@@ -420,6 +707,16 @@ void ClusterStateCache::OnEventData(const EventHeader & aEventHeader, TLV::TLVRe
 
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        auto attribute = GetFlatAttribute(path.mEndpointId, path.mClusterId, path.mAttributeId);
+        VerifyOrReturnError(attribute != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(attribute->mKind == FlatValueKind::kStatus, CHIP_ERROR_INVALID_ARGUMENT);
+
+        status = attribute->mStatus;
+        return CHIP_NO_ERROR;
+    }
+
     CHIP_ERROR err;
 
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
@@ -447,6 +744,47 @@ CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB
 }
 
 void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
+{
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        GetFlatFilters(aVector);
+    }
+    else
+    {
+        GetTreeFilters(aVector);
+    }
+
+    std::sort(aVector.begin(), aVector.end(),
+              [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
+                  return x.second > y.second;
+              });
+}
+
+void ClusterStateCache::GetFlatFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
+{
+    // Both vectors are sorted by path, so the attributes of each cluster directly follow those of the previous one.
+    auto attribute = mFlatAttributes.begin();
+    for (auto const & cluster : mFlatClusters)
+    {
+        size_t clusterSize = 0;
+        for (; attribute != mFlatAttributes.end() && attribute->mClusterKey == cluster.mClusterKey; ++attribute)
+        {
+            clusterSize += attribute->mLength;
+        }
+
+        if (!cluster.mCommittedDataVersion.HasValue() || clusterSize == 0)
+        {
+            continue;
+        }
+
+        DataVersionFilter filter(FlatEndpointIdOf(cluster.mClusterKey), FlatClusterIdOf(cluster.mClusterKey),
+                                 cluster.mCommittedDataVersion.Value());
+
+        aVector.push_back(std::make_pair(filter, clusterSize));
+    }
+}
+
+void ClusterStateCache::GetTreeFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
     for (auto const & endpointIter : mCache)
     {
@@ -498,11 +836,6 @@ void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter
             aVector.push_back(std::make_pair(filter, clusterSize));
         }
     }
-
-    std::sort(aVector.begin(), aVector.end(),
-              [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
-                  return x.second > y.second;
-              });
 }
 
 CHIP_ERROR ClusterStateCache::OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
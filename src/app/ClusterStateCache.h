@@ -117,6 +117,56 @@ public:
     ClusterStateCache & operator=(const ClusterStateCache &) = delete;
     ClusterStateCache & operator=(ClusterStateCache &&)      = delete;
 
+    /*
+     * Selects how attribute state is stored in the cache.
+     *
+     * kTree keeps nested maps keyed on endpoint, cluster and attribute ID, with every attribute value in its own heap
+     * allocation.
+     *
+     * kFlat keeps cluster and attribute state in two vectors sorted on the packed (endpoint, cluster, attribute) path and
+     * copies attribute TLV into a single bump arena owned by the cache. This needs a handful of allocations per node instead
+     * of several per attribute, which matters for controllers caching full wildcard subscriptions of many nodes. Replaced
+     * values leave their old bytes behind in the arena; these are reclaimed by compacting the arena at the end of a report
+     * once they make up at least half of it.
+     *
+     * In kFlat mode, any TLV data retrieved through Get() points into the arena and is only valid until the cache processes
+     * further attribute data, since that may grow or compact the arena.
+     */
+    enum class StorageMode : uint8_t
+    {
+        kTree,
+        kFlat,
+    };
+
+    /*
+     * Switch the storage mode used for attribute state. This must be done before any attribute data or status has been
+     * received; otherwise CHIP_ERROR_INCORRECT_STATE is returned.
+     */
+    CHIP_ERROR SetStorageMode(StorageMode aMode);
+    StorageMode GetStorageMode() const { return mStorageMode; }
+
+    /*
+     * Memory used to hold the attribute state of the cache. Byte counts do not include allocator overhead.
+     */
+    struct MemoryStats
+    {
+        // Number of attributes (with either data or status) and clusters in the cache.
+        size_t attributeCount = 0;
+        size_t clusterCount   = 0;
+        // Bytes of attribute TLV currently held in the cache.
+        size_t dataBytes = 0;
+        // Bytes used by the structures indexing the attribute state.
+        size_t indexBytes = 0;
+        // Number of heap blocks backing the index and the attribute data.
+        size_t allocations = 0;
+        // kFlat only: arena capacity, bytes of replaced values not reclaimed yet, and compactions done so far.
+        size_t arenaBytes    = 0;
+        size_t deadBytes     = 0;
+        uint32_t compactions = 0;
+    };
+
+    MemoryStats GetMemoryStats() const;
+
     void SetHighestReceivedEventNumber(EventNumber highestReceivedEventNumber)
     {
         mHighestReceivedEventNumber.SetValue(highestReceivedEventNumber);
@@ -366,6 +416,21 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            VerifyOrReturnError(GetFlatCluster(endpointId, clusterId) != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+            const uint64_t clusterKey = FlatClusterKey(endpointId, clusterId);
+            for (auto iter = LowerBoundFlatAttribute(clusterKey, 0);
+                 iter != mFlatAttributes.end() && iter->mClusterKey == clusterKey; ++iter)
+            {
+                const ConcreteAttributePath path(endpointId, clusterId, iter->mAttributeId);
+                ReturnErrorOnFailure(func(path));
+            }
+
+            return CHIP_NO_ERROR;
+        }
+
         CHIP_ERROR err;
 
         auto clusterState = GetClusterState(endpointId, clusterId, err);
@@ -396,6 +461,20 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            for (auto & attribute : mFlatAttributes)
+            {
+                if (FlatClusterIdOf(attribute.mClusterKey) == clusterId)
+                {
+                    const ConcreteAttributePath path(FlatEndpointIdOf(attribute.mClusterKey), clusterId, attribute.mAttributeId);
+                    ReturnErrorOnFailure(func(path));
+                }
+            }
+
+            return CHIP_NO_ERROR;
+        }
+
         for (auto & endpointIter : mCache)
         {
             for (auto & clusterIter : endpointIter.second)
@@ -429,6 +508,17 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            for (auto iter = LowerBoundFlatCluster(FlatClusterKey(endpointId, 0));
+                 iter != mFlatClusters.end() && FlatEndpointIdOf(iter->mClusterKey) == endpointId; ++iter)
+            {
+                ReturnErrorOnFailure(func(FlatClusterIdOf(iter->mClusterKey)));
+            }
+
+            return CHIP_NO_ERROR;
+        }
+
         auto endpointIter = mCache.find(endpointId);
         if (endpointIter->first == endpointId)
         {
@@ -541,15 +631,63 @@ private:
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
     // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
     // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
+    struct ClusterDataVersions
     {
-        std::map<AttributeId, AttributeState> mAttributes;
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
     };
+    struct ClusterState : public ClusterDataVersions
+    {
+        std::map<AttributeId, AttributeState> mAttributes;
+    };
     using EndpointState = std::map<ClusterId, ClusterState>;
     using NodeState     = std::map<EndpointId, EndpointState>;
 
+    //
+    // Flat storage (StorageMode::kFlat). Both vectors are sorted by path, so iteration order matches that of the
+    // nested maps and the attributes of a cluster are contiguous.
+    //
+    static constexpr uint64_t FlatClusterKey(EndpointId endpointId, ClusterId clusterId)
+    {
+        return (static_cast<uint64_t>(endpointId) << 32) | clusterId;
+    }
+    static constexpr EndpointId FlatEndpointIdOf(uint64_t clusterKey) { return static_cast<EndpointId>(clusterKey >> 32); }
+    static constexpr ClusterId FlatClusterIdOf(uint64_t clusterKey) { return static_cast<ClusterId>(clusterKey); }
+
+    // Same three cases as AttributeState.
+    enum class FlatValueKind : uint8_t
+    {
+        kData,
+        kStatus,
+        kSize,
+    };
+
+    struct FlatAttribute
+    {
+        bool IsBefore(uint64_t clusterKey, AttributeId attributeId) const
+        {
+            return mClusterKey < clusterKey || (mClusterKey == clusterKey && mAttributeId < attributeId);
+        }
+
+        uint64_t mClusterKey;
+        AttributeId mAttributeId;
+        // Offset of the TLV element in mArena; only used for kData.
+        uint32_t mOffset = 0;
+        // Length of the TLV element for kData, otherwise the size of the value on the wire.
+        uint32_t mLength = 0;
+        StatusIB mStatus;
+        FlatValueKind mKind = FlatValueKind::kSize;
+    };
+
+    struct FlatCluster : public ClusterDataVersions
+    {
+        explicit FlatCluster(uint64_t clusterKey) : mClusterKey(clusterKey) {}
+        uint64_t mClusterKey;
+    };
+
+    // Dead bytes below this are never worth a compaction.
+    static constexpr size_t kArenaCompactionMinDeadBytes = 1024;
+
     struct Comparator
     {
         bool operator()(const AttributePathParams & x, const AttributePathParams & y) const
@@ -591,11 +729,28 @@ private:
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
+    std::vector<FlatCluster>::const_iterator LowerBoundFlatCluster(uint64_t clusterKey) const;
+    std::vector<FlatAttribute>::const_iterator LowerBoundFlatAttribute(uint64_t clusterKey, AttributeId attributeId) const;
+    const FlatCluster * GetFlatCluster(EndpointId endpointId, ClusterId clusterId) const;
+    const FlatAttribute * GetFlatAttribute(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId) const;
+    FlatCluster & GetOrCreateFlatCluster(EndpointId endpointId, ClusterId clusterId);
+
+    // Returns the data versions of the given cluster, creating the cluster if needed.
+    ClusterDataVersions & GetClusterDataVersions(EndpointId endpointId, ClusterId clusterId);
+
     /*
      * Updates the state of an attribute in the cache given a reader. If the reader is null, the state is updated
      * with the provided status.
      */
     CHIP_ERROR UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus);
+    CHIP_ERROR UpdateFlatCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus);
+
+    // Update the pending and committed data versions on receipt of data for aPath.
+    void UpdateDataVersions(const ConcreteDataAttributePath & aPath);
+
+    // Copy the element aData is positioned on to the end of mArena, with an anonymous tag.
+    CHIP_ERROR AppendToArena(TLV::TLVReader & aData, uint32_t & aLength);
+    void CompactArena();
 
     /*
      * If apData is not null, updates the cached event set with the specified event header + payload.
@@ -658,12 +813,21 @@ private:
     // payload for the filter's cluster.  Applying filters in this order should maximize space savings
     // on the wire if not all filters can be applied.
     void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
+    void GetTreeFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
+    void GetFlatFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
 
     CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
 
     Callback & mCallback;
     NodeState mCache;
-    std::set<ConcreteAttributePath> mChangedAttributeSet;
+    StorageMode mStorageMode = StorageMode::kTree;
+    std::vector<FlatCluster> mFlatClusters;
+    std::vector<FlatAttribute> mFlatAttributes;
+    std::vector<uint8_t> mArena;
+    size_t mArenaDeadBytes     = 0;
+    uint32_t mArenaCompactions = 0;
+    // Sorted and de-duplicated at the end of each report.
+    std::vector<ConcreteAttributePath> mChangedAttributes;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
 
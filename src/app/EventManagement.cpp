@@ -19,6 +19,7 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
@@ -66,8 +67,59 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventIndexEntry mMovedEvent; ///< Index entry for the event, if it moves to the next buffer
 };
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+/**
+ * @brief
+ *   A TLVBackingStore exposing a range of the storage of a CircularEventBuffer, wrapping around its end, so that a
+ *   TLVReader can start reading at an event located through the buffer's index.
+ */
+class CircularEventRange : public TLV::TLVBackingStore
+{
+public:
+    CircularEventRange(const CircularEventBuffer & aBuffer, uint32_t aOffset, uint32_t aLength) :
+        mStorage(aBuffer.GetQueue()), mStorageSize(aBuffer.GetTotalDataLength()), mOffset(aOffset), mLength(aLength)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mStorage + mOffset;
+        bufLen   = std::min(mLength, mStorageSize - mOffset);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        // The only other piece of the range is the one that wraps around to the start of the storage.
+        bufLen = 0;
+        if (bufStart == mStorage + mStorageSize && mLength > mStorageSize - mOffset)
+        {
+            bufStart = mStorage;
+            bufLen   = mLength - (mStorageSize - mOffset);
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mStorage;
+    uint32_t mStorageSize;
+    uint32_t mOffset;
+    uint32_t mLength;
+};
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 /**
  * @brief
  *  Internal structure for traversing event list.
@@ -126,7 +178,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mMonotonicStartupTime = aMonotonicStartupTime;
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer, const EventIndexEntry & aEvent)
 {
     CircularTLVWriter writer;
     CircularTLVReader reader;
@@ -136,7 +188,11 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
-    CircularEventBuffer backup = *nextBuffer;
+    EventIndexEntry copiedEvent = aEvent;
+    copiedEvent.mOffset         = nextBuffer->GetTailOffset();
+
+    // Only the queue state is changed by the writer; the index is updated once the copy succeeded.
+    TLVCircularBuffer backup = *nextBuffer;
 
     // Set up the next buffer s.t. it fails if needs to evict an element
     nextBuffer->mProcessEvictedElement = AlwaysFail;
@@ -155,11 +211,13 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    nextBuffer->IndexEvent(copiedEvent);
+
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
     if (err != CHIP_NO_ERROR)
     {
-        *nextBuffer = backup;
+        static_cast<TLVCircularBuffer &>(*nextBuffer) = backup;
     }
     return err;
 }
@@ -199,7 +257,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
 
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
-            err                                 = eventBuffer->EvictHead();
+            err                                 = eventBuffer->EvictHeadEvent();
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -217,11 +275,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    err = CopyToNextBuffer(eventBuffer, ctx.mMovedEvent);
                     SuccessOrExit(err);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
-                    err                                 = eventBuffer->EvictHead();
+                    err                                 = eventBuffer->EvictHeadEvent();
                     // if unconditional eviction failed, this
                     // means that we have no way of further
                     // clearing the buffer.  fail out and let the
@@ -428,6 +486,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     CircularTLVWriter checkpoint = writer;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
+    EventIndexEntry indexEntry;
 
     Timestamp timestamp;
 #if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
@@ -465,9 +524,16 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
+    indexEntry.mEventNumber = mLastEventNumber;
+    indexEntry.mOffset      = mpEventBuffer->GetTailOffset();
+    indexEntry.mClusterId   = opts.mPath.mClusterId;
+    indexEntry.mEventId     = opts.mPath.mEventId;
+    indexEntry.mEndpointId  = opts.mPath.mEndpointId;
+
     err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
+    mpEventBuffer->IndexEvent(indexEntry);
     mBytesWritten += writer.GetLengthWritten();
 
 exit:
@@ -643,16 +709,19 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
 {
-    // TODO: Add particular set of event Paths in FetchEventsSince so that we can filter the interested paths
-    CHIP_ERROR err     = CHIP_NO_ERROR;
-    const bool recurse = false;
-    TLVReader reader;
-    CircularEventBufferWrapper bufWrapper;
+    CHIP_ERROR err = CHIP_NO_ERROR;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    err = FetchIndexedEventsSince(context);
+#else
+    const bool recurse = false;
+    TLVReader reader;
+    CircularEventBufferWrapper bufWrapper;
+    err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -662,6 +731,7 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
     }
 
 exit:
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
     if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
     {
         // We failed to fetch the current event because the buffer is too small, we will start from this one the next time.
@@ -676,6 +746,76 @@ exit:
     return err;
 }
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+CHIP_ERROR EventManagement::FetchIndexedEventsSince(EventLoadOutContext & aContext)
+{
+    // Same order as the reader returned by GetEventReader: oldest events, in the critical buffer, first.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        const size_t indexedCount = buffer->GetIndexedEventCount();
+        const uint32_t dataLength = buffer->DataLength();
+        uint32_t indexedStart     = dataLength;
+        if (indexedCount > 0)
+        {
+            indexedStart = buffer->GetDistanceFromHead(buffer->GetIndexedEvent(0).mOffset);
+        }
+
+        // Events that are not indexed have lower numbers than the indexed ones, so they only need to be read when the
+        // first indexed event may not be the first one to report.
+        if (indexedStart > 0 && (indexedCount == 0 || buffer->GetIndexedEvent(0).mEventNumber > aContext.mStartingEventNumber))
+        {
+            ReturnErrorOnFailure(CopyEventsInRange(*buffer, buffer->GetHeadOffset(), indexedStart, aContext));
+        }
+
+        for (size_t i = 0; i < indexedCount; i++)
+        {
+            const EventIndexEntry & entry = buffer->GetIndexedEvent(i);
+            const ConcreteEventPath path(entry.mEndpointId, entry.mClusterId, entry.mEventId);
+            bool interested = false;
+            for (auto * interestedPath = aContext.mpInterestedEventPaths; interestedPath != nullptr && !interested;
+                 interestedPath        = interestedPath->mpNext)
+            {
+                interested = interestedPath->mValue.IsEventPathSupersetOf(path);
+            }
+
+            // Track skipped events as CopyEventsSince would, so that the next fetch starts after them.
+            aContext.mCurrentEventNumber = entry.mEventNumber;
+            if (entry.mEventNumber < aContext.mStartingEventNumber || !interested)
+            {
+                continue;
+            }
+
+            // The event ends where the next one starts
+            uint32_t start = buffer->GetDistanceFromHead(entry.mOffset);
+            uint32_t end   = dataLength;
+            if (i + 1 < indexedCount)
+            {
+                end = buffer->GetDistanceFromHead(buffer->GetIndexedEvent(i + 1).mOffset);
+            }
+            ReturnErrorOnFailure(CopyEventsInRange(*buffer, entry.mOffset, end - start, aContext));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::CopyEventsInRange(const CircularEventBuffer & aBuffer, uint32_t aOffset, uint32_t aLength,
+                                              EventLoadOutContext & aContext)
+{
+    const bool recurse = false;
+    CircularEventRange range(aBuffer, aOffset, aLength);
+    TLVReader reader;
+    ReturnErrorOnFailure(reader.Init(range, aLength));
+
+    CHIP_ERROR err = TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, recurse);
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    return err;
+}
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 CHIP_ERROR EventManagement::FabricRemovedCB(const TLV::TLVReader & aReader, size_t aDepth, void * apContext)
 {
     // the function does not actually remove the event, instead, it sets the fabric index to an invalid value.
@@ -828,6 +968,10 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
+    ctx->mMovedEvent.mEventNumber           = context.mEventNumber;
+    ctx->mMovedEvent.mClusterId             = context.mClusterId;
+    ctx->mMovedEvent.mEventId               = context.mEventId;
+    ctx->mMovedEvent.mEndpointId            = context.mEndpointId;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
         ChipLogProgress(EventLogging,
@@ -857,6 +1001,49 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mpPrev    = apPrev;
     mpNext    = apNext;
     mPriority = aPriorityLevel;
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    mIndexFirst = 0;
+    mIndexCount = 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+}
+
+CHIP_ERROR CircularEventBuffer::EvictHeadEvent()
+{
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    const uint32_t head = GetHeadOffset();
+    ReturnErrorOnFailure(EvictHead());
+    // The head event has no entry if it is older than every indexed event.
+    if (mIndexCount > 0 && mIndex[mIndexFirst].mOffset == head)
+    {
+        mIndexFirst = static_cast<uint16_t>((mIndexFirst + 1) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+        mIndexCount--;
+    }
+    return CHIP_NO_ERROR;
+#else
+    return EvictHead();
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+}
+
+void CircularEventBuffer::IndexEvent(const EventIndexEntry & aEntry)
+{
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    if (mIndexCount == CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE)
+    {
+        mIndexFirst = static_cast<uint16_t>((mIndexFirst + 1) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+        mIndexCount--;
+    }
+    mIndex[(mIndexFirst + mIndexCount) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE] = aEntry;
+    mIndexCount++;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+}
+
+size_t CircularEventBuffer::GetIndexedEventCount() const
+{
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    return mIndexCount;
+#else
+    return 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -875,6 +1062,21 @@ CHIP_ERROR CircularEventBuffer::OnInit(TLV::TLVWriter & writer, uint8_t *& bufSt
     return CHIP_NO_ERROR;
 }
 
+/**
+ * @brief
+ * Same as TLVCircularBuffer::GetNewBuffer, but evicting through EvictHeadEvent so that the index stays in sync.
+ */
+CHIP_ERROR CircularEventBuffer::GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    if (DataLength() >= GetTotalDataLength())
+    {
+        ReturnErrorOnFailure(EvictHeadEvent());
+    }
+
+    GetCurrentWritableBuffer(bufStart, bufLen);
+    return CHIP_NO_ERROR;
+}
+
 void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 {
     CircularEventBuffer * prev;
@@ -76,6 +76,20 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   Entry of the index a CircularEventBuffer keeps over the events it holds, so that events can be located and filtered
+ *   without decoding them.
+ */
+struct EventIndexEntry
+{
+    EventNumber mEventNumber = 0;
+    uint32_t mOffset         = 0; ///< Offset of the first byte of the event in the buffer storage
+    ClusterId mClusterId     = kInvalidClusterId;
+    EventId mEventId         = kInvalidEventId;
+    EndpointId mEndpointId   = kInvalidEndpointId;
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -128,6 +142,52 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Evict the head event, as TLVCircularBuffer::EvictHead does, and drop its index entry.
+     */
+    CHIP_ERROR EvictHeadEvent();
+
+    /**
+     * @brief
+     *   Add the event that was just written at the tail of the buffer to the index.
+     *
+     * The index covers the newest events of the buffer. When it is full, the entry of the oldest indexed event is
+     * dropped, and that event can then only be found by reading the buffer from its head.
+     *
+     * @param[in] aEntry  Number, path and offset of the event.
+     */
+    void IndexEvent(const EventIndexEntry & aEntry);
+
+    /**
+     * @brief
+     *   Number of events in the index. Events of the buffer that are not indexed all come before the indexed ones.
+     */
+    size_t GetIndexedEventCount() const;
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    /**
+     * @brief
+     *   Get an index entry, 0 being the oldest indexed event.
+     */
+    const EventIndexEntry & GetIndexedEvent(size_t aIndex) const
+    {
+        return mIndex[(mIndexFirst + aIndex) % CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+    uint32_t GetHeadOffset() const { return static_cast<uint32_t>(QueueHead() - GetQueue()) % GetTotalDataLength(); }
+    uint32_t GetTailOffset() const { return static_cast<uint32_t>(QueueTail() - GetQueue()); }
+
+    /**
+     * @brief
+     *   Number of bytes between the head of the buffer and the given offset in its storage.
+     */
+    uint32_t GetDistanceFromHead(uint32_t aOffset) const
+    {
+        return (aOffset + GetTotalDataLength() - GetHeadOffset()) % GetTotalDataLength();
+    }
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -139,7 +199,14 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    EventIndexEntry mIndex[CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE]; ///< Ring of index entries, oldest event first
+    uint16_t mIndexFirst = 0;
+    uint16_t mIndexCount = 0;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+    CHIP_ERROR GetNewBuffer(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
 class CircularEventReader;
@@ -436,9 +503,11 @@ private:
      * @brief copy the event outright to next buffer with higher priority
      *
      * @param[in] apEventBuffer  CircularEventBuffer
+     * @param[in] aEvent         Index entry describing the head event of apEventBuffer, added to the next buffer's index
+     *                           once the event is copied.
      *
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer, const EventIndexEntry & aEvent);
 
     /**
      * @brief Ensure that:
@@ -484,6 +553,22 @@ private:
      */
     static CHIP_ERROR CopyEventsSince(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    /**
+     * @brief
+     *   Internal API used to implement #FetchEventsSince using the buffer indexes: events that are older than the
+     *   starting event number or outside the interested paths are skipped without being read from the buffers.
+     */
+    CHIP_ERROR FetchIndexedEventsSince(EventLoadOutContext & aContext);
+
+    /**
+     * @brief
+     *   Run #CopyEventsSince over the events stored in aLength bytes of aBuffer, starting at aOffset in its storage.
+     */
+    static CHIP_ERROR CopyEventsInRange(const CircularEventBuffer & aBuffer, uint32_t aOffset, uint32_t aLength,
+                                        EventLoadOutContext & aContext);
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     /**
      * @brief Internal iterator function used to scan and filter though event logs
      *
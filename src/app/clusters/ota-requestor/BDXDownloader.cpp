@@ -61,6 +61,7 @@ System::Clock::Timeout BDXDownloader::GetTimeout()
 void BDXDownloader::Reset()
 {
     mPrevBlockCounter = 0;
+    mFinalizePending  = false;
     DeviceLayer::SystemLayer().CancelTimer(TransferTimeoutCheckHandler, this);
 }
 
@@ -150,6 +151,24 @@ CHIP_ERROR BDXDownloader::OnPreparedForDownload(CHIP_ERROR status)
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR BDXDownloader::OnFinalized(CHIP_ERROR status)
+{
+    VerifyOrReturnError(mState == State::kInProgress && mFinalizePending, CHIP_ERROR_INCORRECT_STATE);
+    mFinalizePending = false;
+
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(BDX, "failed to finalize download: %" CHIP_ERROR_FORMAT, status.Format());
+        EndDownload(status);
+        return CHIP_NO_ERROR;
+    }
+
+    ReturnErrorOnFailure(mBdxTransfer.PrepareBlockAck());
+    PollTransferSession();
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR BDXDownloader::FetchNextData()
 {
     VerifyOrReturnError(mState == State::kInProgress, CHIP_ERROR_INCORRECT_STATE);
@@ -271,8 +290,21 @@ CHIP_ERROR BDXDownloader::HandleBdxEvent(const chip::bdx::TransferSession::Outpu
         // TODO: this will cause problems if Finalize() is not guaranteed to do its work after ProcessBlock().
         if (outEvent.blockdata.IsEof)
         {
+            // Finalize before acknowledging the last block, so that an image the processor could not store ends the
+            // transfer with an error instead of completing it.
+            CHIP_ERROR err = mImageProcessor->Finalize();
+            if (err == CHIP_ERROR_IN_PROGRESS)
+            {
+                // The block is acknowledged by OnFinalized().
+                mFinalizePending = true;
+                break;
+            }
+            if (err != CHIP_NO_ERROR)
+            {
+                EndDownload(err);
+                break;
+            }
             mBdxTransfer.PrepareBlockAck();
-            ReturnErrorOnFailure(mImageProcessor->Finalize());
         }
 
         break;
@@ -20,8 +20,6 @@
  * It should not execute any logic that is application specific.
  */
 
-// TODO: unit tests
-
 #pragma once
 
 #include "OTADownloader.h"
@@ -68,6 +66,7 @@ public:
     // OTADownloader Overrides
     CHIP_ERROR BeginPrepareDownload() override;
     CHIP_ERROR OnPreparedForDownload(CHIP_ERROR status) override;
+    CHIP_ERROR OnFinalized(CHIP_ERROR status) override;
     void OnDownloadTimeout() override;
     // BDX does not provide a mechanism for the driver of a transfer to gracefully end the exchange, so it will abort the transfer
     // instead.
@@ -94,6 +93,8 @@ private:
     System::Clock::Timeout mTimeout = System::Clock::kZero;
     // Tracks the last block counter used during the transfer session as of the previous check.
     uint32_t mPrevBlockCounter = 0;
+    // The last block is acknowledged once the image processor reports that Finalize() has completed.
+    bool mFinalizePending = false;
 };
 
 } // namespace chip
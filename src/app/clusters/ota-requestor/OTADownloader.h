@@ -60,6 +60,10 @@ public:
     // The reason parameter should be used to indicate if this is a graceful end or a forceful abort.
     void virtual EndDownload(CHIP_ERROR reason = CHIP_NO_ERROR) = 0;
 
+    // Platform calls this method when a Finalize() that returned CHIP_ERROR_IN_PROGRESS has completed.
+    // Upon this call, the OTADownloader may complete the download, or end it if status is an error.
+    CHIP_ERROR virtual OnFinalized(CHIP_ERROR status) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
     // Fetch the next set of data. May be a no-op for asynchronous protocols.
     CHIP_ERROR virtual FetchNextData() { return CHIP_ERROR_NOT_IMPLEMENTED; }
 
@@ -23,6 +23,7 @@
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/Optional.h>
 #include <lib/core/TLV.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <protocols/interaction_model/Constants.h>
 
 #include <type_traits>
@@ -253,6 +254,39 @@ CHIP_ERROR EncodeForRead(TLV::TLVWriter & writer, TLV::Tag tag, FabricIndex acce
 #pragma GCC diagnostic pop
 }
 
+/*
+ * @brief
+ *
+ * Work out the size of the TLV encoding of x, as written by Encode, without
+ * writing it anywhere.  If the encoding is larger than maxSize, counting stops
+ * and CHIP_ERROR_BUFFER_TOO_SMALL is returned.
+ */
+template <typename X>
+CHIP_ERROR EncodedSize(TLV::Tag tag, const X & x, uint32_t & size, uint32_t maxSize = UINT32_MAX)
+{
+    TLV::TlvCountingWriter writer(maxSize);
+    ReturnErrorOnFailure(Encode(writer, tag, x));
+    size = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * @brief
+ *
+ * Work out the size of the TLV encoding of x, as written by EncodeForRead,
+ * without writing it anywhere.  If the encoding is larger than maxSize,
+ * counting stops and CHIP_ERROR_BUFFER_TOO_SMALL is returned.
+ */
+template <typename X>
+CHIP_ERROR EncodedSizeForRead(TLV::Tag tag, FabricIndex accessingFabricIndex, const X & x, uint32_t & size,
+                              uint32_t maxSize = UINT32_MAX)
+{
+    TLV::TlvCountingWriter writer(maxSize);
+    ReturnErrorOnFailure(EncodeForRead(writer, tag, accessingFabricIndex, x));
+    size = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
 } // namespace DataModel
 } // namespace app
 } // namespace chip
@@ -0,0 +1,77 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeInterestIndex.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+size_t AttributeInterestIndex::BucketIndex(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    uint32_t hash = (static_cast<uint32_t>(aEndpointId) * 0x9E3779B1u) ^ (aClusterId * 0x85EBCA77u);
+    return (hash ^ (hash >> 16)) % kBucketCount;
+}
+
+AttributeInterestIndex::Entry *& AttributeInterestIndex::ChainFor(const AttributePathParams & aPath)
+{
+    if (aPath.HasWildcardClusterId())
+    {
+        return mWildcardClusterEntries;
+    }
+    return mBuckets[BucketIndex(aPath.mEndpointId, aPath.mClusterId)];
+}
+
+CHIP_ERROR AttributeInterestIndex::Add(ReadHandler * apReadHandler, const SingleLinkedListNode<AttributePathParams> * apPathList)
+{
+    for (auto path = apPathList; path != nullptr; path = path->mpNext)
+    {
+        Entry * entry = mEntryPool.CreateObject(&path->mValue, apReadHandler);
+        if (entry == nullptr)
+        {
+            Remove(apReadHandler, apPathList);
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        Entry *& chain = ChainFor(path->mValue);
+        entry->mpNext  = chain;
+        chain          = entry;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void AttributeInterestIndex::Remove(ReadHandler * apReadHandler, const SingleLinkedListNode<AttributePathParams> * apPathList)
+{
+    for (auto path = apPathList; path != nullptr; path = path->mpNext)
+    {
+        for (Entry ** link = &ChainFor(path->mValue); *link != nullptr; link = &(*link)->mpNext)
+        {
+            Entry * entry = *link;
+            if (entry->mpPath == &path->mValue && entry->mpReadHandler == apReadHandler)
+            {
+                *link = entry->mpNext;
+                mEntryPool.ReleaseObject(entry);
+                break;
+            }
+        }
+    }
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
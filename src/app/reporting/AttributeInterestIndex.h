@@ -0,0 +1,136 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/Pool.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/**
+ * @brief Index from attribute paths to the read handlers interested in them, used by the reporting engine to find
+ * the handlers affected by a dirty attribute without walking the path list of every handler.
+ *
+ * Each path of a handler gets one entry. Paths with a concrete cluster are hashed by endpoint (which may be the
+ * wildcard endpoint) and cluster; paths with a wildcard cluster are kept in a separate list. A concrete dirty path is
+ * then only checked against the buckets of its own endpoint and of the wildcard endpoint for its cluster, and against
+ * the wildcard cluster list, with the attribute (and any bucket collision) filtered by AttributePathParams::Intersects.
+ * A dirty path with a wildcard endpoint or cluster is checked against every entry.
+ *
+ * Entries point into the path lists of the handlers, so a handler must be removed before its path list is changed or
+ * released.
+ */
+class AttributeInterestIndex
+{
+public:
+    static constexpr size_t kBucketCount = CHIP_IM_ATTRIBUTE_INTEREST_INDEX_BUCKETS;
+
+    static_assert(kBucketCount > 0, "CHIP_IM_ATTRIBUTE_INTEREST_INDEX_BUCKETS must not be zero");
+
+    /**
+     * Add an entry for each path of apPathList, on behalf of apReadHandler.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY if there are not enough entries, in which case none of the paths are added.
+     */
+    CHIP_ERROR Add(ReadHandler * apReadHandler, const SingleLinkedListNode<AttributePathParams> * apPathList);
+
+    /**
+     * Remove the entries added for apPathList on behalf of apReadHandler. Paths without an entry are ignored.
+     */
+    void Remove(ReadHandler * apReadHandler, const SingleLinkedListNode<AttributePathParams> * apPathList);
+
+    /**
+     * Call aFunction with the handler of each entry whose path intersects aPath. A handler is passed once for each
+     * of its paths that intersects aPath. aFunction must not add or remove entries.
+     */
+    template <typename Function>
+    Loop ForEachInterested(const AttributePathParams & aPath, Function && aFunction)
+    {
+        if (aPath.HasWildcardEndpointId() || aPath.HasWildcardClusterId())
+        {
+            for (Entry * chain : mBuckets)
+            {
+                VerifyOrReturnValue(ForEachIntersecting(chain, aPath, aFunction) == Loop::Continue, Loop::Break);
+            }
+        }
+        else
+        {
+            size_t bucket         = BucketIndex(aPath.mEndpointId, aPath.mClusterId);
+            size_t wildcardBucket = BucketIndex(kInvalidEndpointId, aPath.mClusterId);
+            VerifyOrReturnValue(ForEachIntersecting(mBuckets[bucket], aPath, aFunction) == Loop::Continue, Loop::Break);
+            if (wildcardBucket != bucket)
+            {
+                VerifyOrReturnValue(ForEachIntersecting(mBuckets[wildcardBucket], aPath, aFunction) == Loop::Continue,
+                                    Loop::Break);
+            }
+        }
+        return ForEachIntersecting(mWildcardClusterEntries, aPath, aFunction);
+    }
+
+    size_t Allocated() const { return mEntryPool.Allocated(); }
+
+private:
+    struct Entry
+    {
+        Entry(const AttributePathParams * apPath, ReadHandler * apReadHandler) : mpPath(apPath), mpReadHandler(apReadHandler) {}
+
+        const AttributePathParams * mpPath;
+        ReadHandler * mpReadHandler;
+        Entry * mpNext = nullptr;
+    };
+
+    static size_t BucketIndex(EndpointId aEndpointId, ClusterId aClusterId);
+
+    Entry *& ChainFor(const AttributePathParams & aPath);
+
+    template <typename Function>
+    static Loop ForEachIntersecting(Entry * apChain, const AttributePathParams & aPath, Function & aFunction)
+    {
+        for (Entry * entry = apChain; entry != nullptr; entry = entry->mpNext)
+        {
+            if (entry->mpPath->Intersects(aPath) && aFunction(entry->mpReadHandler) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Continue;
+    }
+
+    Entry * mBuckets[kBucketCount]  = {};
+    Entry * mWildcardClusterEntries = nullptr;
+    ObjectPool<Entry, CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+        mEntryPool;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
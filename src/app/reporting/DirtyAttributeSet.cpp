@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtyAttributeSet.h>
+
+#include <string.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+DirtyAttributeSet::ClusterEntry * DirtyAttributeSet::FindCluster(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    for (auto & cluster : mClusters)
+    {
+        if (cluster.mInUse && cluster.mEndpointId == aEndpointId && cluster.mClusterId == aClusterId)
+        {
+            return &cluster;
+        }
+    }
+    return nullptr;
+}
+
+const DirtyAttributeSet::ClusterEntry * DirtyAttributeSet::FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const
+{
+    return const_cast<DirtyAttributeSet *>(this)->FindCluster(aEndpointId, aClusterId);
+}
+
+bool DirtyAttributeSet::Insert(const ConcreteAttributePath & aPath, uint64_t aGeneration)
+{
+    uint16_t index = mLookup(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (index >= kMaxAttributes || (mBaseGeneration != 0 && aGeneration - mBaseGeneration >= UINT32_MAX))
+    {
+        mStats.rejected++;
+        return false;
+    }
+
+    ClusterEntry * cluster = FindCluster(aPath.mEndpointId, aPath.mClusterId);
+    if (cluster == nullptr)
+    {
+        for (auto & entry : mClusters)
+        {
+            if (!entry.mInUse)
+            {
+                cluster = &entry;
+                break;
+            }
+        }
+        if (cluster == nullptr)
+        {
+            mStats.rejected++;
+            return false;
+        }
+        cluster->mEndpointId = aPath.mEndpointId;
+        cluster->mClusterId  = aPath.mClusterId;
+        cluster->mInUse      = true;
+        memset(cluster->mGenerations, 0, sizeof(cluster->mGenerations));
+    }
+
+    if (mBaseGeneration == 0)
+    {
+        mBaseGeneration = aGeneration;
+    }
+    cluster->mGenerations[index] = static_cast<uint32_t>(aGeneration - mBaseGeneration + 1);
+    mStats.inserts++;
+    return true;
+}
+
+bool DirtyAttributeSet::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    const ClusterEntry * cluster = FindCluster(aPath.mEndpointId, aPath.mClusterId);
+    if (cluster == nullptr)
+    {
+        return false;
+    }
+
+    uint16_t index = mLookup(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    if (index >= kMaxAttributes || cluster->mGenerations[index] == 0)
+    {
+        return false;
+    }
+    return mBaseGeneration + cluster->mGenerations[index] - 1 > aGeneration;
+}
+
+void DirtyAttributeSet::Clear()
+{
+    for (auto & cluster : mClusters)
+    {
+        cluster.mInUse = false;
+    }
+    mBaseGeneration = 0;
+}
+
+size_t DirtyAttributeSet::ClusterCount() const
+{
+    size_t count = 0;
+    for (const auto & cluster : mClusters)
+    {
+        count += cluster.mInUse ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
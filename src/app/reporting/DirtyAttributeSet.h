@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @brief Set of dirty concrete attribute paths, used by the reporting engine next to its global dirty set.
+ *
+ * Each dirty cluster takes one entry, holding the dirty generation of each of its attributes indexed by the position
+ * of the attribute in the cluster metadata. Dirty attributes are therefore kept exactly, with their own generation,
+ * however many of them there are in a cluster, instead of being merged into a wildcard path when the global dirty set
+ * runs out of entries.
+ *
+ * Paths that cannot be kept (unknown attribute, attribute index of kMaxAttributes or more, no free cluster entry) are
+ * rejected by Insert, and the caller is expected to track them in some other way.
+ */
+class DirtyAttributeSet
+{
+public:
+    static constexpr size_t kClusterCount  = CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS;
+    static constexpr size_t kMaxAttributes = CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES;
+
+    static_assert(kClusterCount > 0, "CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS must not be zero");
+    static_assert(kMaxAttributes > 0 && kMaxAttributes < UINT16_MAX, "CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES is out of range");
+
+    /**
+     * Returns the index of the attribute in the metadata of its cluster, or UINT16_MAX if there is no such attribute.
+     */
+    using AttributeIndexLookup = uint16_t (*)(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
+
+    struct Stats
+    {
+        uint32_t inserts  = 0; // Paths inserted (or whose generation was updated).
+        uint32_t rejected = 0; // Paths that could not be kept.
+    };
+
+    explicit DirtyAttributeSet(AttributeIndexLookup aLookup) : mLookup(aLookup) {}
+
+    /**
+     * Mark the attribute dirty at the given generation, which must not be lower than any generation passed before
+     * since the last Clear.
+     *
+     * @return Whether the path is kept by the set.
+     */
+    bool Insert(const ConcreteAttributePath & aPath, uint64_t aGeneration);
+
+    /**
+     * Returns whether the attribute was marked dirty at a generation later than aGeneration.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    void Clear();
+
+    size_t ClusterCount() const;
+
+    const Stats & GetStats() const { return mStats; }
+
+private:
+    struct ClusterEntry
+    {
+        EndpointId mEndpointId = kInvalidEndpointId;
+        ClusterId mClusterId   = kInvalidClusterId;
+        bool mInUse            = false;
+        // Generation of each attribute as an offset from mBaseGeneration plus one, 0 for a clean attribute.
+        uint32_t mGenerations[kMaxAttributes];
+    };
+
+    ClusterEntry * FindCluster(EndpointId aEndpointId, ClusterId aClusterId);
+    const ClusterEntry * FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const;
+
+    AttributeIndexLookup mLookup;
+    ClusterEntry mClusters[kClusterCount];
+    uint64_t mBaseGeneration = 0; // Generation of the first insert since the last Clear, 0 while empty.
+    Stats mStats;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
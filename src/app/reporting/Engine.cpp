@@ -33,6 +33,7 @@
 #include <app/reporting/Engine.h>
 #include <app/util/MatterCallbacks.h>
 #include <app/util/ember-compatibility-functions.h>
+#include <app/util/endpoint-config-api.h>
 
 using namespace chip::Access;
 
@@ -40,7 +41,12 @@ namespace chip {
 namespace app {
 namespace reporting {
 
-Engine::Engine(InteractionModelEngine * apImEngine) : mpImEngine(apImEngine) {}
+Engine::Engine(InteractionModelEngine * apImEngine) :
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    mDirtyAttributeSet(emberAfGetServerAttributeIndexByAttributeId),
+#endif
+    mpImEngine(apImEngine)
+{}
 
 CHIP_ERROR Engine::Init()
 {
@@ -57,6 +63,15 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    mDirtyAttributeSet.Clear();
+#endif
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    mAttributeValueCache.Clear();
+#endif
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    ReleaseSharedReport();
+#endif
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -79,6 +94,11 @@ bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFil
     return existPathMatch && !existVersionMismatch;
 }
 
+static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+{
+    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
 CHIP_ERROR
 Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
                             AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteReadAttributePath & aPath,
@@ -90,7 +110,19 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
     DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
                                                           DataModelCallbacks::OperationOrder::Pre, aPath);
 
-    ReturnErrorOnFailure(ReadSingleClusterData(aSubjectDescriptor, aIsFabricFiltered, aPath, aAttributeReportIBs, aEncoderState));
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    // Only complete values are cached, so a list which is being chunked across reports is read directly.
+    if (aEncoderState == nullptr || !aEncoderState->AllowPartialData())
+    {
+        ReturnErrorOnFailure(
+            RetrieveCachedClusterData(aSubjectDescriptor, aIsFabricFiltered, aAttributeReportIBs, aPath, aEncoderState));
+    }
+    else
+#endif // CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    {
+        ReturnErrorOnFailure(
+            ReadSingleClusterData(aSubjectDescriptor, aIsFabricFiltered, aPath, aAttributeReportIBs, aEncoderState));
+    }
 
     DataModelCallbacks::GetInstance()->AttributeOperation(DataModelCallbacks::OperationType::Read,
                                                           DataModelCallbacks::OperationOrder::Post, aPath);
@@ -98,10 +130,103 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
     return CHIP_NO_ERROR;
 }
 
-static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+namespace {
+
+// Copy every AttributeReportIB of an encoded AttributeReportIBs array.
+CHIP_ERROR CopyAttributeReports(ByteSpan aEncoded, AttributeReportIBs::Builder & aAttributeReportIBs)
 {
-    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+    TLV::TLVReader reader;
+    TLV::TLVType outerType;
+    reader.Init(aEncoded);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(outerType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(aAttributeReportIBs.GetWriter()->CopyContainer(reader));
+    }
+    return err == CHIP_END_OF_TLV ? CHIP_NO_ERROR : err;
+}
+
+// Returns true, with the DataVersion of the value, if an encoded AttributeReportIBs array holds a single
+// AttributeDataIB (rather than a status, or nothing).
+bool HoldsSingleAttributeData(ByteSpan aEncoded, DataVersion & aVersion)
+{
+    TLV::TLVReader reader;
+    reader.Init(aEncoded);
+    VerifyOrReturnValue(reader.Next() == CHIP_NO_ERROR, false);
+
+    AttributeReportIBs::Parser reports;
+    VerifyOrReturnValue(reports.Init(reader) == CHIP_NO_ERROR, false);
+    TLV::TLVReader reportsReader;
+    reports.GetReader(&reportsReader);
+    VerifyOrReturnValue(reportsReader.Next() == CHIP_NO_ERROR, false);
+
+    AttributeReportIB::Parser report;
+    AttributeDataIB::Parser data;
+    VerifyOrReturnValue(report.Init(reportsReader) == CHIP_NO_ERROR, false);
+    VerifyOrReturnValue(report.GetAttributeData(&data) == CHIP_NO_ERROR, false);
+    VerifyOrReturnValue(data.GetDataVersion(&aVersion) == CHIP_NO_ERROR, false);
+
+    return reportsReader.Next() == CHIP_END_OF_TLV;
+}
+
+} // namespace
+
+CHIP_ERROR Engine::RetrieveCachedClusterData(const SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
+                                             AttributeReportIBs::Builder & aAttributeReportIBs,
+                                             const ConcreteReadAttributePath & aPath,
+                                             AttributeValueEncoder::AttributeEncodeState * aEncoderState)
+{
+    ByteSpan encoded =
+        mAttributeValueCache.Find(aPath, aSubjectDescriptor.fabricIndex, aIsFabricFiltered, IsClusterDataVersionEqual);
+    if (!encoded.empty())
+    {
+        // The cached value was read by some subject; check that this one may read it too. On failure,
+        // ReadSingleClusterData produces the right status (or nothing, for an expanded path).
+        RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+        if (GetAccessControl().Check(aSubjectDescriptor, requestPath, RequiredPrivilege::ForReadAttribute(aPath)) ==
+            CHIP_NO_ERROR)
+        {
+            return CopyAttributeReports(encoded, aAttributeReportIBs);
+        }
+        return ReadSingleClusterData(aSubjectDescriptor, aIsFabricFiltered, aPath, aAttributeReportIBs, aEncoderState);
+    }
+
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder reports;
+    AttributeValueEncoder::AttributeEncodeState state;
+    writer.Init(mAttributeValueScratch);
+    ReturnErrorOnFailure(reports.Init(&writer));
+
+    CHIP_ERROR err = ReadSingleClusterData(aSubjectDescriptor, aIsFabricFiltered, aPath, reports, &state);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = reports.EndOfAttributeReportIBs();
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+    if (IsOutOfWriterSpaceError(err))
+    {
+        // Too large to cache; read it directly so that a list can still be chunked.
+        return ReadSingleClusterData(aSubjectDescriptor, aIsFabricFiltered, aPath, aAttributeReportIBs, aEncoderState);
+    }
+    ReturnErrorOnFailure(err);
+
+    encoded = ByteSpan(mAttributeValueScratch, writer.GetLengthWritten());
+
+    DataVersion version;
+    if (HoldsSingleAttributeData(encoded, version))
+    {
+        mAttributeValueCache.Store(aPath, aSubjectDescriptor.fabricIndex, aIsFabricFiltered, version, encoded);
+    }
+    return CopyAttributeReports(encoded, aAttributeReportIBs);
 }
+#endif // CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
 
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
@@ -153,25 +278,12 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         for (; apReadHandler->GetAttributePathExpandIterator()->Get(readPath);
              apReadHandler->GetAttributePathExpandIterator()->Next())
         {
+            bool isAmplified = false;
             if (!apReadHandler->IsPriming())
             {
-                bool concretePathDirty = false;
-                // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
-                    if (dirtyPath->IsAttributePathSupersetOf(readPath))
-                    {
-                        // We don't need to worry about paths that were already marked dirty before the last time this read handler
-                        // started a report that it completed: those paths already got reported.
-                        if (dirtyPath->mGeneration > apReadHandler->mPreviousReportsBeginGeneration)
-                        {
-                            concretePathDirty = true;
-                            return Loop::Break;
-                        }
-                    }
-                    return Loop::Continue;
-                });
-
-                if (!concretePathDirty)
+                // We don't need to worry about paths that were already marked dirty before the last time this read handler
+                // started a report that it completed: those paths already got reported.
+                if (!IsDirtySince(readPath, apReadHandler->mPreviousReportsBeginGeneration, &isAmplified))
                 {
                     // This attribute is not dirty, we just skip this one.
                     continue;
@@ -225,6 +337,12 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
                 {
                     // We met a error during writing reports, one common case is we are running out of buffer, rollback the
                     // attributeReportIB to avoid any partial data.
+                    if (IsOutOfWriterSpaceError(err))
+                    {
+                        mReportEncodeStats.rollbacks++;
+                        mReportEncodeStats.rolledBackBytes +=
+                            attributeReportIBs.GetWriter()->GetLengthWritten() - attributeBackup.GetLengthWritten();
+                    }
                     attributeReportIBs.Rollback(attributeBackup);
                     apReadHandler->SetAttributeEncodeState(AttributeValueEncoder::AttributeEncodeState());
 
@@ -255,6 +373,12 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
                 }
             }
             SuccessOrExit(err);
+            if (isAmplified)
+            {
+                mReportEncodeStats.amplifiedReports++;
+                mReportEncodeStats.amplifiedBytes +=
+                    attributeReportIBs.GetWriter()->GetLengthWritten() - attributeBackup.GetLengthWritten();
+            }
             // Successfully encoded the attribute, clear the internal state.
             apReadHandler->SetAttributeEncodeState(AttributeValueEncoder::AttributeEncodeState());
         }
@@ -487,6 +611,147 @@ exit:
     return err;
 }
 
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+bool Engine::IsShareableReport(const ReadHandler * apReadHandler)
+{
+    // Priming reports depend on data version filters, chunked reports on the progress of the handler, and event
+    // reports on the events the handler has already been sent.
+    return apReadHandler->IsType(ReadHandler::InteractionType::Subscribe) && !apReadHandler->IsPriming() &&
+        !apReadHandler->IsReporting() && apReadHandler->GetEventPathList() == nullptr;
+}
+
+bool Engine::CanUseSharedReport(const ReadHandler * apReadHandler) const
+{
+    const ReadHandler * sharedHandler = mSharedReport.mpReadHandler;
+    VerifyOrReturnValue(sharedHandler != nullptr && sharedHandler != apReadHandler, false);
+    VerifyOrReturnValue(IsShareableReport(apReadHandler), false);
+
+    // Without new dirty paths since the shared report was built, both handlers consider the same paths dirty.
+    VerifyOrReturnValue(mSharedReport.mDirtyGeneration == mDirtyGeneration &&
+                            mSharedReport.mPreviousReportsBeginGeneration == apReadHandler->mPreviousReportsBeginGeneration,
+                        false);
+
+    // Fabric-scoped data is encoded for the accessing fabric.
+    const Access::SubjectDescriptor subject       = apReadHandler->GetSubjectDescriptor();
+    const Access::SubjectDescriptor sharedSubject = sharedHandler->GetSubjectDescriptor();
+    VerifyOrReturnValue(subject.fabricIndex == sharedSubject.fabricIndex && subject.authMode == sharedSubject.authMode &&
+                            apReadHandler->IsFabricFiltered() == sharedHandler->IsFabricFiltered(),
+                        false);
+
+    auto path       = apReadHandler->GetAttributePathList();
+    auto sharedPath = sharedHandler->GetAttributePathList();
+    for (; path != nullptr && sharedPath != nullptr; path = path->mpNext, sharedPath = sharedPath->mpNext)
+    {
+        VerifyOrReturnValue(path->mValue == sharedPath->mValue, false);
+    }
+    VerifyOrReturnValue(path == nullptr && sharedPath == nullptr, false);
+
+    if (subject.subject == sharedSubject.subject && subject.cats == sharedSubject.cats)
+    {
+        return true;
+    }
+    // Different subjects, such as controllers with their own node IDs, get the same report when access control
+    // gives them the same decision for every path in it.
+    return HasSameReadAccess(apReadHandler, subject, sharedSubject);
+}
+
+bool Engine::HasSameReadAccess(const ReadHandler * apReadHandler, const Access::SubjectDescriptor & aSubject,
+                               const Access::SubjectDescriptor & aOtherSubject)
+{
+    // Concrete paths are returned as they are, so paths that do not exist get the same access status too.
+    AttributePathExpandIterator iterator(apReadHandler->mpAttributePathList);
+    ConcreteAttributePath path;
+    ConcreteAttributePath checkedPath(kInvalidEndpointId, kInvalidClusterId, kInvalidAttributeId);
+    Access::Privilege checkedPrivilege = Access::Privilege::kView;
+    for (; iterator.Get(path); iterator.Next())
+    {
+        Access::Privilege privilege = RequiredPrivilege::ForReadAttribute(path);
+        // Access is decided per cluster and privilege, and expanded paths come cluster by cluster.
+        if (path.mEndpointId == checkedPath.mEndpointId && path.mClusterId == checkedPath.mClusterId &&
+            privilege == checkedPrivilege)
+        {
+            continue;
+        }
+
+        Access::RequestPath requestPath{ .cluster = path.mClusterId, .endpoint = path.mEndpointId };
+        VerifyOrReturnValue(GetAccessControl().Check(aSubject, requestPath, privilege) ==
+                                GetAccessControl().Check(aOtherSubject, requestPath, privilege),
+                            false);
+        checkedPath      = path;
+        checkedPrivilege = privilege;
+    }
+    return true;
+}
+
+void Engine::KeepSharedReport(const ReadHandler * apReadHandler, const System::PacketBufferHandle & aPayload)
+{
+    // Replace the kept report only if no other handler has used it; reports shared by a group of subscriptions are
+    // kept through the run.
+    VerifyOrReturn(mSharedReport.mpReadHandler == nullptr || !mSharedReport.mReused);
+
+    // The payload is encrypted in place when sent, so keep a copy.
+    System::PacketBufferHandle payload = aPayload.CloneData();
+    VerifyOrReturn(!payload.IsNull());
+
+    mSharedReport.mpReadHandler                   = apReadHandler;
+    mSharedReport.mPreviousReportsBeginGeneration = apReadHandler->mPreviousReportsBeginGeneration;
+    mSharedReport.mDirtyGeneration                = mDirtyGeneration;
+    mSharedReport.mReused                         = false;
+    mSharedReport.mPayload                        = std::move(payload);
+    mSharedReportStats.kept++;
+}
+
+CHIP_ERROR Engine::BuildSharedReport(const ReadHandler * apReadHandler, System::PacketBufferHandle & aBuffer)
+{
+    // Apply the same limits as BuildAndSendSingleReportData.
+    size_t maxLength =
+        std::min<size_t>(aBuffer->AvailableDataLength(), kMaxSecureSduLengthBytes) - Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    VerifyOrReturnError(maxLength > mReservedSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    maxLength -= mReservedSize;
+#endif
+
+    SubscriptionId subscriptionId = 0;
+    apReadHandler->GetSubscriptionId(subscriptionId);
+
+    TLV::TLVReader reader;
+    TLV::TLVWriter writer;
+    TLV::TLVType readerOuterType;
+    TLV::TLVType writerOuterType;
+    reader.Init(mSharedReport.mPayload->Start(), mSharedReport.mPayload->DataLength());
+    writer.Init(aBuffer->Start(), maxLength);
+
+    // Copy the report, which only differs from the one for apReadHandler by its SubscriptionId.
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(readerOuterType));
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, writerOuterType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == TLV::ContextTag(ReportDataMessage::Tag::kSubscriptionId))
+        {
+            ReturnErrorOnFailure(writer.Put(reader.GetTag(), subscriptionId));
+        }
+        else
+        {
+            ReturnErrorOnFailure(writer.CopyElement(reader));
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(writer.EndContainer(writerOuterType));
+    ReturnErrorOnFailure(writer.Finalize());
+    aBuffer->SetDataLength(static_cast<uint16_t>(writer.GetLengthWritten()));
+    return CHIP_NO_ERROR;
+}
+
+void Engine::ReleaseSharedReport()
+{
+    mSharedReport = SharedReport();
+}
+#endif // CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+
 CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -514,6 +779,25 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     VerifyOrExit(apReadHandler->GetSession() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(!bufHandle.IsNull(), err = CHIP_ERROR_NO_MEMORY);
 
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    // If a report built for another subscription in this run is also the report for this one, send a copy of it
+    // rather than building it again. Otherwise (or if it does not fit), build the report as usual.
+    if (CanUseSharedReport(apReadHandler) && BuildSharedReport(apReadHandler, bufHandle) == CHIP_NO_ERROR)
+    {
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+        app::ICDNotifier::GetInstance().NotifySubscriptionReport();
+#endif // CHIP_CONFIG_ENABLE_ICD_SERVER
+        mSharedReport.mReused = true;
+        mSharedReportStats.shared++;
+
+        ChipLogDetail(DataManagement, "<RE> Sending shared report (payload has %" PRIu16 " bytes)...", bufHandle->DataLength());
+        err = SendReport(apReadHandler, std::move(bufHandle), false);
+        VerifyOrExit(err == CHIP_NO_ERROR,
+                     ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
+        ExitNow();
+    }
+#endif // CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+
     if (bufHandle->AvailableDataLength() > kMaxSecureSduLengthBytes)
     {
         reservedSize = static_cast<uint16_t>(bufHandle->AvailableDataLength() - kMaxSecureSduLengthBytes);
@@ -602,6 +886,13 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     err = reportDataWriter.Finalize(&bufHandle);
     SuccessOrExit(err);
 
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    if (!hasMoreChunks && IsShareableReport(apReadHandler))
+    {
+        KeepSharedReport(apReadHandler, bufHandle);
+    }
+#endif
+
     ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", reportDataWriter.GetLengthWritten());
     err = SendReport(apReadHandler, std::move(bufHandle), hasMoreChunks);
     VerifyOrExit(err == CHIP_NO_ERROR,
@@ -680,6 +971,9 @@ void Engine::Run()
             mRunningReadHandler = nullptr;
             if (err != CHIP_NO_ERROR)
             {
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+                ReleaseSharedReport();
+#endif
                 return;
             }
         }
@@ -701,6 +995,11 @@ void Engine::Run()
         mCurReadHandlerIdx = 0;
     }
 
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    // Reports are only shared within a run; later runs may see different dirty paths.
+    ReleaseSharedReport();
+#endif
+
     bool allReadClean = true;
 
     mpImEngine->mReadHandlers.ForEachActiveObject([&allReadClean](ReadHandler * handler) {
@@ -718,6 +1017,9 @@ void Engine::Run()
         ChipLogDetail(DataManagement, "All ReadHandler-s are clean, clear GlobalDirtySet");
 
         mGlobalDirtySet.ReleaseAll();
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+        mDirtyAttributeSet.Clear();
+#endif
     }
 }
 
@@ -856,11 +1158,68 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
     return CHIP_NO_ERROR;
 }
 
+bool Engine::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration, bool * apIsAmplified)
+{
+    if (apIsAmplified != nullptr)
+    {
+        *apIsAmplified = false;
+    }
+
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    // An exact entry means the attribute itself changed, whatever wildcard paths also cover it.
+    VerifyOrReturnValue(!mDirtyAttributeSet.IsDirtySince(aPath, aGeneration), true);
+#endif
+
+    bool exactMatch    = false;
+    bool wildcardMatch = false;
+    // TODO: Optimize this implementation by making the iterator only emit intersected paths.
+    mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+        if (dirtyPath->IsAttributePathSupersetOf(aPath) && dirtyPath->mGeneration > aGeneration)
+        {
+            if (dirtyPath->IsWildcardPath())
+            {
+                wildcardMatch = true;
+            }
+            else
+            {
+                exactMatch = true;
+            }
+            // Later matches cannot change the answer once a concrete path matched, or if amplification is not asked for.
+            return (exactMatch || apIsAmplified == nullptr) ? Loop::Break : Loop::Continue;
+        }
+        return Loop::Continue;
+    });
+    if (apIsAmplified != nullptr)
+    {
+        *apIsAmplified = wildcardMatch && !exactMatch;
+    }
+    return exactMatch || wildcardMatch;
+}
+
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    // The DataVersion has moved on, so cached values for the cluster are no longer used; free their entries.
+    mAttributeValueCache.Invalidate(aAttributePath);
+#endif
+
     bool intersectsInterestPath = false;
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    const uint64_t generation = GetDirtySetGeneration();
+    mAttributeInterestIndex.ForEachInterested(aAttributePath, [&](ReadHandler * handler) {
+        // A handler is visited once for each of its paths that intersects the dirty path. The generation was bumped
+        // above, so a handler already at this generation has been marked dirty by this call.
+        if (handler->mDirtyGeneration != generation && (handler->CanStartReporting() || handler->IsAwaitingReportResponse()))
+        {
+            handler->AttributePathIsDirty(aAttributePath);
+            intersectsInterestPath = true;
+        }
+
+        return Loop::Continue;
+    });
+#else
     mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
@@ -880,16 +1239,43 @@ CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 
         return Loop::Continue;
     });
+#endif
 
     if (!intersectsInterestPath)
     {
         return CHIP_NO_ERROR;
     }
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    // Concrete paths are kept exactly, the global dirty set only gets wildcards and the paths the table cannot hold.
+    if (!aAttributePath.IsWildcardPath() &&
+        mDirtyAttributeSet.Insert(ConcreteAttributePath(aAttributePath.mEndpointId, aAttributePath.mClusterId,
+                                                         aAttributePath.mAttributeId),
+                                  GetDirtySetGeneration()))
+    {
+        return CHIP_NO_ERROR;
+    }
+#endif
     ReturnErrorOnFailure(InsertPathIntoDirtySet(aAttributePath));
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR Engine::AddAttributeInterest(ReadHandler & aReadHandler)
+{
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    return mAttributeInterestIndex.Add(&aReadHandler, aReadHandler.GetAttributePathList());
+#else
+    return CHIP_NO_ERROR;
+#endif
+}
+
+void Engine::RemoveAttributeInterest(ReadHandler & aReadHandler)
+{
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    mAttributeInterestIndex.Remove(&aReadHandler, aReadHandler.GetAttributePathList());
+#endif
+}
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
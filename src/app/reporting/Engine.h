@@ -25,8 +25,11 @@
 #pragma once
 
 #include <access/AccessControl.h>
+#include <app/AttributeValueCache.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <app/reporting/DirtyAttributeSet.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -95,6 +98,14 @@ public:
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Register the attribute paths of a read handler, once its path list is complete, so that SetDirty finds it.
+     * Must be matched by a RemoveAttributeInterest before the path list is released.
+     */
+    CHIP_ERROR AddAttributeInterest(ReadHandler & aReadHandler);
+
+    void RemoveAttributeInterest(ReadHandler & aReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -109,6 +120,12 @@ public:
      */
     void ResetReadHandlerTracker(ReadHandler * apReadHandlerBeingDeleted)
     {
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        if (apReadHandlerBeingDeleted == mSharedReport.mpReadHandler)
+        {
+            ReleaseSharedReport();
+        }
+#endif
         if (apReadHandlerBeingDeleted == mRunningReadHandler)
         {
             // Just decrement, so our increment after we finish running it will
@@ -140,6 +157,41 @@ public:
     size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
 #endif
 
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    const AttributeValueCache & GetAttributeValueCache() const { return mAttributeValueCache; }
+#endif
+
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    const AttributeInterestIndex & GetAttributeInterestIndex() const { return mAttributeInterestIndex; }
+#endif
+
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    const DirtyAttributeSet & GetDirtyAttributeSet() const { return mDirtyAttributeSet; }
+#endif
+
+    struct ReportEncodeStats
+    {
+        uint32_t rollbacks       = 0; // Attribute reports rolled back because they did not fit in the current chunk.
+        uint64_t rolledBackBytes = 0; // Bytes discarded by those rollbacks, which are encoded again in a later chunk.
+        // Attribute reports in non-priming reports that only a wildcard path of the global dirty set marked dirty, and
+        // their bytes. This includes the paths widened when the global dirty set ran out of entries, whose attributes may
+        // not have changed at all. Attributes also marked dirty by their own concrete path are not counted.
+        uint32_t amplifiedReports = 0;
+        uint64_t amplifiedBytes   = 0;
+    };
+
+    const ReportEncodeStats & GetReportEncodeStats() const { return mReportEncodeStats; }
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    struct SharedReportStats
+    {
+        uint32_t kept   = 0; // Subscription reports kept after being built, for other subscriptions to reuse.
+        uint32_t shared = 0; // Subscription reports sent by reusing a kept report instead of building one.
+    };
+
+    const SharedReportStats & GetSharedReportStats() const { return mSharedReportStats; }
+#endif
+
 private:
     /**
      * Main work-horse function that executes the run-loop.
@@ -172,6 +224,48 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    /**
+     * Read an attribute through mAttributeValueCache: copy the cached encoding if there is a current one the subject
+     * may read, otherwise encode the attribute into mAttributeValueScratch, store it in the cache if it holds a
+     * single attribute value, and copy it out.
+     */
+    CHIP_ERROR RetrieveCachedClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
+                                         AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteReadAttributePath & aPath,
+                                         AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#endif
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    /**
+     * Whether the next report of apReadHandler is a whole subscription report made of attribute data only, so that
+     * it is the same for all subscriptions with the same fabric, access control decisions, fabric filtering,
+     * attribute paths and last reported generation.
+     */
+    static bool IsShareableReport(const ReadHandler * apReadHandler);
+
+    /**
+     * Whether the next report of apReadHandler would be the same as mSharedReport, other than its SubscriptionId.
+     */
+    bool CanUseSharedReport(const ReadHandler * apReadHandler) const;
+
+    /**
+     * Whether access control gives aSubject and aOtherSubject the same decision for every attribute path of
+     * apReadHandler, once expanded.
+     */
+    static bool HasSameReadAccess(const ReadHandler * apReadHandler, const Access::SubjectDescriptor & aSubject,
+                                  const Access::SubjectDescriptor & aOtherSubject);
+
+    /**
+     * Keep a copy of the report about to be sent to apReadHandler in mSharedReport.
+     */
+    void KeepSharedReport(const ReadHandler * apReadHandler, const System::PacketBufferHandle & aPayload);
+
+    /**
+     * Write the report in mSharedReport to aBuffer, with the SubscriptionId of apReadHandler.
+     */
+    CHIP_ERROR BuildSharedReport(const ReadHandler * apReadHandler, System::PacketBufferHandle & aBuffer);
+
+    void ReleaseSharedReport();
+#endif
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -230,6 +324,13 @@ private:
 
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
+    /**
+     * Returns whether the concrete path was marked dirty after the given generation. If apIsAmplified is not null, it
+     * is set to whether the path was only matched by wildcard dirty paths, with no exact entry of the dirty attribute
+     * set or concrete path of the global dirty set.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration, bool * apIsAmplified = nullptr);
+
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
 
     /**
@@ -281,6 +382,39 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    /**
+     * The last shareable report built in the current run, while it may still be reused. The generations are the
+     * ones of the ReadHandler and the engine when the report was built.
+     */
+    struct SharedReport
+    {
+        const ReadHandler * mpReadHandler        = nullptr;
+        uint64_t mPreviousReportsBeginGeneration = 0;
+        uint64_t mDirtyGeneration                = 0;
+        bool mReused                             = false;
+        System::PacketBufferHandle mPayload;
+    };
+
+    SharedReport mSharedReport;
+    SharedReportStats mSharedReportStats;
+#endif
+
+    ReportEncodeStats mReportEncodeStats;
+
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    AttributeInterestIndex mAttributeInterestIndex;
+#endif
+
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    DirtyAttributeSet mDirtyAttributeSet;
+#endif
+
+#if CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+    AttributeValueCache mAttributeValueCache;
+    uint8_t mAttributeValueScratch[AttributeValueCache::kMaxValueSize];
+#endif
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -595,6 +595,9 @@ void Server::Shutdown()
     mICDManager.Shutdown();
 #endif // CHIP_CONFIG_ENABLE_ICD_SERVER
     mAttributePersister.Shutdown();
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    System::PacketBuffer::ReleaseHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
     // TODO(16969): Remove chip::Platform::MemoryInit() call from Server class, it belongs to outer code
     chip::Platform::MemoryShutdown();
 }
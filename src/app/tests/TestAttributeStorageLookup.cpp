@@ -0,0 +1,251 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/util/attribute-storage-lookup.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+using LookupTables = AttributeStoreLookupTables<16, 64>;
+
+constexpr EmberAfAttributeMetadata Attribute(AttributeId id, uint16_t size, EmberAfAttributeMask mask = 0)
+{
+    return { EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)), id, size, ZCL_INT32U_ATTRIBUTE_TYPE, mask };
+}
+
+constexpr EmberAfCluster Cluster(ClusterId id, const EmberAfAttributeMetadata * attributes, uint16_t attributeCount,
+                                 uint16_t clusterSize, EmberAfClusterMask mask)
+{
+    return { id, attributes, attributeCount, clusterSize, mask, nullptr, nullptr, nullptr, nullptr, 0 };
+}
+
+// Attribute 2 is external and attribute 4 a singleton, so neither takes storage. Attribute 1 is listed twice.
+const EmberAfAttributeMetadata kOnOffAttributes[] = {
+    Attribute(0, 1), Attribute(1, 2), Attribute(2, 4, ATTRIBUTE_MASK_EXTERNAL_STORAGE),
+    Attribute(3, 4), Attribute(4, 2, ATTRIBUTE_MASK_SINGLETON), Attribute(1, 8),
+};
+const EmberAfAttributeMetadata kLevelAttributes[]      = { Attribute(0, 2), Attribute(5, 1) };
+const EmberAfAttributeMetadata kOtherLevelAttributes[] = { Attribute(0, 4), Attribute(6, 1) };
+
+// Cluster 8 is listed as a client, then twice as a server: only the first server one is ever matched.
+const EmberAfCluster kClusters[] = {
+    Cluster(6, kOnOffAttributes, 6, 15, CLUSTER_MASK_SERVER),
+    Cluster(8, kOtherLevelAttributes, 2, 5, CLUSTER_MASK_CLIENT),
+    Cluster(8, kLevelAttributes, 2, 3, CLUSTER_MASK_SERVER),
+    Cluster(8, kOtherLevelAttributes, 2, 5, CLUSTER_MASK_SERVER),
+};
+const EmberAfEndpointType kEndpointType = { kClusters, 4, 28 };
+
+const EmberAfCluster kSmallClusters[]        = { Cluster(8, kLevelAttributes, 2, 3, CLUSTER_MASK_SERVER) };
+const EmberAfEndpointType kSmallEndpointType = { kSmallClusters, 1, 3 };
+
+constexpr uint16_t kFixedEndpointCount = 4;
+
+EmberAfDefinedEndpoint DefinedEndpoint(EndpointId id, const EmberAfEndpointType * type, bool enabled)
+{
+    EmberAfDefinedEndpoint endpoint;
+    endpoint.endpoint     = id;
+    endpoint.endpointType = type;
+    if (enabled)
+    {
+        endpoint.bitmask.Set(EmberAfEndpointOptions::isEnabled);
+    }
+    return endpoint;
+}
+
+// Fixed endpoint 1 is defined twice, disabled first. Endpoint 3 is dynamic.
+void MakeEndpoints(EmberAfDefinedEndpoint (&endpoints)[5])
+{
+    endpoints[0] = DefinedEndpoint(0, &kSmallEndpointType, true);
+    endpoints[1] = DefinedEndpoint(1, &kEndpointType, false);
+    endpoints[2] = DefinedEndpoint(1, &kEndpointType, true);
+    endpoints[3] = DefinedEndpoint(2, &kEndpointType, true);
+    endpoints[4] = DefinedEndpoint(3, &kEndpointType, true);
+}
+
+struct ScanResult
+{
+    const EmberAfAttributeMetadata * metadata = nullptr;
+    uint16_t endpointIndex                    = 0;
+    uint16_t storageOffset                    = 0;
+};
+
+// The scan of emAfReadOrWriteAttribute.
+ScanResult Scan(const EmberAfDefinedEndpoint * endpoints, uint16_t endpointCount, EndpointId endpoint, ClusterId clusterId,
+                AttributeId attributeId)
+{
+    uint16_t offset = 0;
+    for (uint16_t ep = 0; ep < endpointCount; ep++)
+    {
+        if (endpoints[ep].endpoint == endpoint)
+        {
+            if (!endpoints[ep].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+            {
+                continue;
+            }
+            for (uint8_t c = 0; c < endpoints[ep].endpointType->clusterCount; c++)
+            {
+                const EmberAfCluster & cluster = endpoints[ep].endpointType->cluster[c];
+                if (cluster.clusterId == clusterId && (cluster.mask & CLUSTER_MASK_SERVER))
+                {
+                    for (uint16_t a = 0; a < cluster.attributeCount; a++)
+                    {
+                        const EmberAfAttributeMetadata & am = cluster.attributes[a];
+                        if (am.attributeId == attributeId)
+                        {
+                            return { &am, ep, offset };
+                        }
+                        if (!(am.mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am.mask & ATTRIBUTE_MASK_SINGLETON))
+                        {
+                            offset = static_cast<uint16_t>(offset + am.size);
+                        }
+                    }
+                    return {};
+                }
+                offset = static_cast<uint16_t>(offset + cluster.clusterSize);
+            }
+            return {};
+        }
+        if (ep < kFixedEndpointCount)
+        {
+            offset = static_cast<uint16_t>(offset + endpoints[ep].endpointType->endpointSize);
+        }
+    }
+    return {};
+}
+
+void TestEndpointLookup(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfDefinedEndpoint endpoints[5];
+    MakeEndpoints(endpoints);
+
+    LookupTables tables;
+    NL_TEST_ASSERT(inSuite, tables.IsStale());
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(0, false) == LookupTables::kInvalidIndex);
+
+    tables.Build(Span<const EmberAfDefinedEndpoint>(endpoints), kFixedEndpointCount);
+    NL_TEST_ASSERT(inSuite, !tables.IsStale());
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(0, true) == 0);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(1, false) == 1);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(1, true) == 2);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(3, true) == 4);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(4, false) == LookupTables::kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(kInvalidEndpointId, false) == LookupTables::kInvalidIndex);
+
+    // Disabling the only endpoint with an id leaves it visible to lookups that consider disabled endpoints.
+    endpoints[3].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+    tables.Invalidate();
+    NL_TEST_ASSERT(inSuite, tables.IsStale());
+    tables.Build(Span<const EmberAfDefinedEndpoint>(endpoints), kFixedEndpointCount);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(2, false) == 3);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(2, true) == LookupTables::kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, tables.FindAttribute(2, 6, 0) == nullptr);
+}
+
+void TestAttributeOffsets(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfDefinedEndpoint endpoints[5];
+    MakeEndpoints(endpoints);
+
+    LookupTables tables;
+    tables.Build(Span<const EmberAfDefinedEndpoint>(endpoints), kFixedEndpointCount);
+
+    // Endpoint 1 starts after endpoint 0 (3 bytes): its disabled duplicate is skipped.
+    const auto * entry = tables.FindAttribute(1, 6, 3);
+    NL_TEST_ASSERT(inSuite, entry != nullptr && entry->endpointIndex == 2 && entry->storageOffset == 3 + 1 + 2);
+    // After the first server cluster 8, past cluster 6 (15 bytes) and the client cluster 8 (5 bytes).
+    entry = tables.FindAttribute(2, 8, 5);
+    NL_TEST_ASSERT(inSuite, entry != nullptr && entry->metadata == &kLevelAttributes[1]);
+    NL_TEST_ASSERT(inSuite, entry != nullptr && entry->storageOffset == 3 + 28 + 28 + 15 + 5 + 2);
+
+    // Every path, including those that are not there, is resolved as the scan resolves it.
+    const ClusterId kClusterIds[] = { 6, 7, 8 };
+    for (EndpointId endpoint = 0; endpoint <= 4; endpoint++)
+    {
+        for (ClusterId clusterId : kClusterIds)
+        {
+            for (AttributeId attributeId = 0; attributeId <= 7; attributeId++)
+            {
+                ScanResult expected = Scan(endpoints, 5, endpoint, clusterId, attributeId);
+                entry               = tables.FindAttribute(endpoint, clusterId, attributeId);
+                NL_TEST_ASSERT(inSuite, (entry != nullptr) == (expected.metadata != nullptr));
+                if (entry != nullptr && expected.metadata != nullptr)
+                {
+                    NL_TEST_ASSERT(inSuite, entry->metadata == expected.metadata);
+                    NL_TEST_ASSERT(inSuite, entry->endpointIndex == expected.endpointIndex);
+                    // Dynamic endpoints have no storage, so their offset is not used.
+                    NL_TEST_ASSERT(inSuite,
+                                   entry->endpointIndex >= kFixedEndpointCount || entry->storageOffset == expected.storageOffset);
+                }
+            }
+        }
+    }
+
+    // The first of two attributes with the same id is matched, as by the scan.
+    entry = tables.FindAttribute(2, 6, 1);
+    NL_TEST_ASSERT(inSuite, entry != nullptr && entry->metadata == &kOnOffAttributes[1]);
+}
+
+void TestAttributeTableOverflow(nlTestSuite * inSuite, void * inContext)
+{
+    EmberAfDefinedEndpoint endpoints[5];
+    MakeEndpoints(endpoints);
+
+    // Room for 6 attributes only: attribute lookups miss, so that the scan is used, but endpoints are still found.
+    AttributeStoreLookupTables<16, 8> tables;
+    tables.Build(Span<const EmberAfDefinedEndpoint>(endpoints), kFixedEndpointCount);
+    NL_TEST_ASSERT(inSuite, tables.FindAttribute(0, 8, 0) == nullptr);
+    NL_TEST_ASSERT(inSuite, tables.FindEndpointIndex(2, true) == 3);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Endpoint lookup", TestEndpointLookup),
+    NL_TEST_DEF("Attribute offsets and first matches", TestAttributeOffsets),
+    NL_TEST_DEF("Attribute table overflow", TestAttributeTableOverflow),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestAttributeStorageLookup()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Test for the attribute store lookup tables",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeStorageLookup)
@@ -0,0 +1,183 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeValueCache.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+DataVersion gCurrentVersion = 1;
+
+bool IsCurrentVersion(const ConcreteClusterPath & aPath, DataVersion aVersion)
+{
+    return aVersion == gCurrentVersion;
+}
+
+const uint8_t kValue[]      = { 0x15, 0x24, 0x00, 0x01, 0x18 };
+const uint8_t kOtherValue[] = { 0x15, 0x24, 0x00, 0x02, 0x18 };
+
+void TestStoreAndFind(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeValueCache cache;
+    ConcreteAttributePath path(1, 6, 0);
+    gCurrentVersion = 1;
+
+    NL_TEST_ASSERT(inSuite, cache.Find(path, 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+
+    ByteSpan found = cache.Find(path, 1, true, IsCurrentVersion);
+    NL_TEST_ASSERT(inSuite, found.data_equal(ByteSpan(kValue)));
+
+    // Other attributes, fabrics and fabric filtering do not share the entry.
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(1, 6, 1), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(2, 6, 0), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Find(path, 2, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Find(path, 1, false, IsCurrentVersion).empty());
+
+    // Storing again replaces the value.
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 1, ByteSpan(kOtherValue)) == CHIP_NO_ERROR);
+    found = cache.Find(path, 1, true, IsCurrentVersion);
+    NL_TEST_ASSERT(inSuite, found.data_equal(ByteSpan(kOtherValue)));
+
+    NL_TEST_ASSERT(inSuite, cache.GetStats().hits == 2);
+    NL_TEST_ASSERT(inSuite, cache.GetStats().misses == 5);
+    NL_TEST_ASSERT(inSuite, cache.GetStats().stores == 2);
+    NL_TEST_ASSERT(inSuite, cache.GetStats().evictions == 0);
+}
+
+void TestDataVersionChange(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeValueCache cache;
+    ConcreteAttributePath path(1, 6, 0);
+    gCurrentVersion = 10;
+
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 10, ByteSpan(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !cache.Find(path, 1, true, IsCurrentVersion).empty());
+
+    // A version change hides the entry even without an invalidation.
+    gCurrentVersion = 11;
+    NL_TEST_ASSERT(inSuite, cache.Find(path, 1, true, IsCurrentVersion).empty());
+
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 11, ByteSpan(kOtherValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Find(path, 1, true, IsCurrentVersion).data_equal(ByteSpan(kOtherValue)));
+}
+
+void TestInvalidate(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeValueCache cache;
+    gCurrentVersion = 1;
+
+    NL_TEST_ASSERT(inSuite, cache.Store(ConcreteAttributePath(1, 6, 0), 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Store(ConcreteAttributePath(1, 6, 1), 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Store(ConcreteAttributePath(1, 8, 0), 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Store(ConcreteAttributePath(2, 6, 0), 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+
+    // Invalidating one attribute drops the whole cluster on that endpoint.
+    cache.Invalidate(AttributePathParams(1, 6, 1));
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(1, 6, 0), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(1, 6, 1), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, !cache.Find(ConcreteAttributePath(1, 8, 0), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, !cache.Find(ConcreteAttributePath(2, 6, 0), 1, true, IsCurrentVersion).empty());
+
+    // Wildcard endpoint.
+    AttributePathParams wildcard;
+    wildcard.mClusterId = 6;
+    cache.Invalidate(wildcard);
+    NL_TEST_ASSERT(inSuite, !cache.Find(ConcreteAttributePath(1, 8, 0), 1, true, IsCurrentVersion).empty());
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(2, 6, 0), 1, true, IsCurrentVersion).empty());
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Find(ConcreteAttributePath(1, 8, 0), 1, true, IsCurrentVersion).empty());
+}
+
+void TestRejectedValues(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeValueCache cache;
+    ConcreteAttributePath path(1, 6, 0);
+    uint8_t large[AttributeValueCache::kMaxValueSize + 1] = {};
+
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 1, ByteSpan(large)) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, cache.Store(path, 1, true, 1, ByteSpan()) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, cache.GetStats().stores == 0);
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    AttributeValueCache cache;
+    gCurrentVersion = 1;
+
+    // Store more attributes than there are entries; every one stays findable until replaced.
+    constexpr AttributeId kCount = static_cast<AttributeId>(AttributeValueCache::kEntryCount * 2);
+    for (AttributeId id = 0; id < kCount; ++id)
+    {
+        NL_TEST_ASSERT(inSuite, cache.Store(ConcreteAttributePath(1, 6, id), 1, true, 1, ByteSpan(kValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !cache.Find(ConcreteAttributePath(1, 6, id), 1, true, IsCurrentVersion).empty());
+    }
+
+    NL_TEST_ASSERT(inSuite, cache.GetStats().stores == kCount);
+    NL_TEST_ASSERT(inSuite, cache.GetStats().evictions >= kCount - AttributeValueCache::kEntryCount);
+
+    size_t found = 0;
+    for (AttributeId id = 0; id < kCount; ++id)
+    {
+        found += cache.Find(ConcreteAttributePath(1, 6, id), 1, true, IsCurrentVersion).empty() ? 0 : 1;
+    }
+    NL_TEST_ASSERT(inSuite, found <= AttributeValueCache::kEntryCount);
+    NL_TEST_ASSERT(inSuite, found == kCount - cache.GetStats().evictions);
+
+    // The most recently stored attribute always survives.
+    NL_TEST_ASSERT(inSuite, !cache.Find(ConcreteAttributePath(1, 6, kCount - 1), 1, true, IsCurrentVersion).empty());
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Store and find", TestStoreAndFind),
+    NL_TEST_DEF("DataVersion change", TestDataVersionChange),
+    NL_TEST_DEF("Invalidate", TestInvalidate),
+    NL_TEST_DEF("Rejected values", TestRejectedValues),
+    NL_TEST_DEF("Eviction", TestEviction),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestAttributeValueCache()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Test for the encoded attribute value cache",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeValueCache)
@@ -560,6 +560,36 @@ void TestEncodeListChunking2(nlTestSuite * aSuite, void * aContext)
     }
 }
 
+void TestEncodeValueSizedUpFront(nlTestSuite * aSuite, void * aContext)
+{
+    const uint32_t items[] = { 0x10000, 0x20000, 0x30000, 0x40000, 0x50000, 0x60000, 0x70000, 0x80000 };
+    DataModel::List<const uint32_t> list(items);
+
+    // Each item is an anonymous 4 byte integer, and the list an array with a context tag.
+    uint32_t size = 0;
+    NL_TEST_ASSERT(aSuite, DataModel::EncodedSize(TLV::ContextTag(AttributeDataIB::Tag::kData), list, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, size == 2 + 8 * 5 + 1);
+    NL_TEST_ASSERT(aSuite,
+                   DataModel::EncodedSize(TLV::ContextTag(AttributeDataIB::Tag::kData), list, size, 42) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+
+#if CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+    // A value which cannot fit in a nearly full report fails without anything being written for it.
+    LimitedTestSetup<40> test(aSuite);
+    const uint32_t lengthBefore = test.writer.GetLengthWritten();
+    CHIP_ERROR err              = test.encoder.Encode(list);
+    NL_TEST_ASSERT(aSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(aSuite, test.writer.GetLengthWritten() == lengthBefore);
+
+    // The 6 byte value fits in the 17 bytes left, but not with the 20 bytes of AttributeReportIB framing around it.
+    LimitedTestSetup<20> framingTest(aSuite);
+    const uint32_t framingLengthBefore = framingTest.writer.GetLengthWritten();
+    err                                = framingTest.encoder.Encode(static_cast<uint32_t>(0x12345678));
+    NL_TEST_ASSERT(aSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(aSuite, framingTest.writer.GetLengthWritten() == framingLengthBefore);
+#endif // CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW > 0
+}
+
 void TestEncodePreEncoded(nlTestSuite * aSuite, void * aContext)
 {
     TestSetup test(aSuite);
@@ -858,6 +888,7 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestEncodeListChunking", TestEncodeListChunking),
     NL_TEST_DEF("TestEncodeListChunking2", TestEncodeListChunking2),
     NL_TEST_DEF("TestEncodeFabricScoped", TestEncodeFabricScoped),
+    NL_TEST_DEF("TestEncodeValueSizedUpFront", TestEncodeValueSizedUpFront),
     NL_TEST_DEF("TestEncodePreEncoded", TestEncodePreEncoded),
     NL_TEST_DEF("TestEncodeListOfPreEncoded", TestEncodeListOfPreEncoded),
     NL_TEST_DEF("TestEncodeListFabricScopedPreEncoded", TestEncodeListOfPreEncoded),
@@ -0,0 +1,283 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/ota-requestor/BDXDownloader.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/bdx/BdxMessages.h>
+#include <protocols/bdx/BdxTransferSession.h>
+#include <protocols/secure_channel/Constants.h>
+#include <transport/raw/MessageHeader.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::bdx;
+using chip::app::Clusters::OtaSoftwareUpdateRequestor::OTAChangeReasonEnum;
+
+namespace {
+
+constexpr uint16_t kBlockSize                 = 64;
+constexpr System::Clock::Timestamp kNoAdvance = System::Clock::kZero;
+const char kFileDesignator[]                  = "test.bin";
+
+class FakeImageProcessor : public OTAImageProcessorInterface
+{
+public:
+    CHIP_ERROR PrepareDownload() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR Finalize() override
+    {
+        finalizeCalls++;
+        return finalizeResult;
+    }
+    CHIP_ERROR Apply() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR Abort() override
+    {
+        abortCalls++;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR ProcessBlock(ByteSpan & block) override
+    {
+        blocksProcessed++;
+        return CHIP_NO_ERROR;
+    }
+    bool IsFirstImageRun() override { return false; }
+    CHIP_ERROR ConfirmCurrentImage() override { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR finalizeResult = CHIP_NO_ERROR;
+    int finalizeCalls         = 0;
+    int abortCalls            = 0;
+    int blocksProcessed       = 0;
+};
+
+class FakeMessagingDelegate : public BDXDownloader::MessagingDelegate
+{
+public:
+    CHIP_ERROR SendMessage(const TransferSession::OutputEvent & msgEvent) override
+    {
+        sentTypes.push_back(msgEvent.msgTypeData);
+        lastType = msgEvent.msgTypeData;
+        lastMsg  = msgEvent.MsgData.CloneData();
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename TMessageType>
+    bool HasSent(TMessageType type) const
+    {
+        for (const auto & sent : sentTypes)
+        {
+            if (sent.HasMessageType(type))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<TransferSession::MessageTypeData> sentTypes;
+    TransferSession::MessageTypeData lastType;
+    System::PacketBufferHandle lastMsg;
+};
+
+class FakeStateDelegate : public BDXDownloader::StateDelegate
+{
+public:
+    void OnDownloadStateChanged(OTADownloader::State state, OTAChangeReasonEnum reason) override { lastState = state; }
+    void OnUpdateProgressChanged(app::DataModel::Nullable<uint8_t> percent) override {}
+
+    OTADownloader::State lastState = OTADownloader::State::kIdle;
+};
+
+// A BDXDownloader driven by a provider TransferSession, up to the point where the provider is to send the last block.
+struct DownloadFixture
+{
+    BDXDownloader downloader;
+    FakeImageProcessor processor;
+    FakeMessagingDelegate messages;
+    FakeStateDelegate states;
+    TransferSession provider;
+
+    // Passes the last message sent by the downloader to the provider and returns the provider's next event.
+    TransferSession::OutputEventType DeliverToProvider()
+    {
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(messages.lastType.ProtocolId, messages.lastType.MessageType);
+        provider.HandleMessageReceived(payloadHeader, std::move(messages.lastMsg), kNoAdvance);
+
+        TransferSession::OutputEvent event;
+        provider.PollOutput(event, kNoAdvance);
+        return event.EventType;
+    }
+
+    // Passes the next message of the provider to the downloader.
+    bool DeliverToDownloader()
+    {
+        TransferSession::OutputEvent event;
+        provider.PollOutput(event, kNoAdvance);
+        VerifyOrReturnValue(event.EventType == TransferSession::OutputEventType::kMsgToSend, false);
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(event.msgTypeData.ProtocolId, event.msgTypeData.MessageType);
+        downloader.OnMessageReceived(payloadHeader, std::move(event.MsgData));
+        return true;
+    }
+
+    void Start(nlTestSuite * inSuite)
+    {
+        downloader.SetMessageDelegate(&messages);
+        downloader.SetStateDelegate(&states);
+        downloader.SetImageProcessorDelegate(&processor);
+
+        TransferSession::TransferInitData initData;
+        initData.TransferCtlFlags = TransferControlFlags::kReceiverDrive;
+        initData.MaxBlockSize     = kBlockSize;
+        initData.FileDesignator   = reinterpret_cast<const uint8_t *>(kFileDesignator);
+        initData.FileDesLength    = static_cast<uint16_t>(strlen(kFileDesignator));
+        NL_TEST_ASSERT(inSuite, downloader.SetBDXParams(initData, System::Clock::Seconds16(60)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       provider.WaitForTransfer(TransferRole::kSender, TransferControlFlags::kReceiverDrive, kBlockSize,
+                                                System::Clock::Seconds16(60)) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, downloader.BeginPrepareDownload() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, downloader.OnPreparedForDownload(CHIP_NO_ERROR) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, messages.lastType.HasMessageType(MessageType::ReceiveInit));
+        NL_TEST_ASSERT(inSuite, DeliverToProvider() == TransferSession::OutputEventType::kInitReceived);
+
+        TransferSession::TransferAcceptData acceptData;
+        acceptData.ControlMode  = TransferControlFlags::kReceiverDrive;
+        acceptData.MaxBlockSize = kBlockSize;
+        NL_TEST_ASSERT(inSuite, provider.AcceptTransfer(acceptData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, DeliverToDownloader());
+        NL_TEST_ASSERT(inSuite, messages.lastType.HasMessageType(MessageType::BlockQuery));
+        NL_TEST_ASSERT(inSuite, DeliverToProvider() == TransferSession::OutputEventType::kQueryReceived);
+    }
+
+    void SendLastBlock(nlTestSuite * inSuite)
+    {
+        uint8_t data[kBlockSize / 2] = { 0 };
+
+        TransferSession::BlockData blockData;
+        blockData.Data   = data;
+        blockData.Length = sizeof(data);
+        blockData.IsEof  = true;
+        NL_TEST_ASSERT(inSuite, provider.PrepareBlock(blockData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, DeliverToDownloader());
+        NL_TEST_ASSERT(inSuite, processor.blocksProcessed == 1);
+        NL_TEST_ASSERT(inSuite, processor.finalizeCalls == 1);
+    }
+};
+
+void TestFinalizeSucceeds(nlTestSuite * inSuite, void * inContext)
+{
+    DownloadFixture fixture;
+    fixture.Start(inSuite);
+    fixture.SendLastBlock(inSuite);
+
+    NL_TEST_ASSERT(inSuite, fixture.messages.lastType.HasMessageType(MessageType::BlockAckEOF));
+    NL_TEST_ASSERT(inSuite, fixture.downloader.GetState() == OTADownloader::State::kComplete);
+    NL_TEST_ASSERT(inSuite, fixture.processor.abortCalls == 0);
+    NL_TEST_ASSERT(inSuite, fixture.DeliverToProvider() == TransferSession::OutputEventType::kAckEOFReceived);
+}
+
+void TestFinalizeFails(nlTestSuite * inSuite, void * inContext)
+{
+    DownloadFixture fixture;
+    fixture.processor.finalizeResult = CHIP_ERROR_WRITE_FAILED;
+    fixture.Start(inSuite);
+    fixture.SendLastBlock(inSuite);
+
+    // The transfer is aborted instead of completed.
+    NL_TEST_ASSERT(inSuite, !fixture.messages.HasSent(MessageType::BlockAckEOF));
+    NL_TEST_ASSERT(inSuite, fixture.messages.lastType.HasMessageType(Protocols::SecureChannel::MsgType::StatusReport));
+    NL_TEST_ASSERT(inSuite, fixture.downloader.GetState() == OTADownloader::State::kIdle);
+    NL_TEST_ASSERT(inSuite, fixture.processor.abortCalls == 1);
+    NL_TEST_ASSERT(inSuite, fixture.DeliverToProvider() == TransferSession::OutputEventType::kStatusReceived);
+}
+
+void TestFinalizeInProgress(nlTestSuite * inSuite, void * inContext)
+{
+    for (CHIP_ERROR result : { CHIP_NO_ERROR, CHIP_ERROR_INTEGRITY_CHECK_FAILED })
+    {
+        DownloadFixture fixture;
+        fixture.processor.finalizeResult = CHIP_ERROR_IN_PROGRESS;
+        fixture.Start(inSuite);
+        NL_TEST_ASSERT(inSuite, fixture.downloader.OnFinalized(CHIP_NO_ERROR) == CHIP_ERROR_INCORRECT_STATE);
+        fixture.SendLastBlock(inSuite);
+
+        // The last block is only acknowledged once the processor reports that Finalize completed.
+        NL_TEST_ASSERT(inSuite, !fixture.messages.HasSent(MessageType::BlockAckEOF));
+        NL_TEST_ASSERT(inSuite, fixture.downloader.GetState() == OTADownloader::State::kInProgress);
+
+        NL_TEST_ASSERT(inSuite, fixture.downloader.OnFinalized(result) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, fixture.messages.HasSent(MessageType::BlockAckEOF) == (result == CHIP_NO_ERROR));
+        NL_TEST_ASSERT(inSuite, fixture.processor.abortCalls == (result == CHIP_NO_ERROR ? 0 : 1));
+        NL_TEST_ASSERT(inSuite,
+                       fixture.downloader.GetState() ==
+                           (result == CHIP_NO_ERROR ? OTADownloader::State::kComplete : OTADownloader::State::kIdle));
+        NL_TEST_ASSERT(inSuite, fixture.downloader.OnFinalized(result) == CHIP_ERROR_INCORRECT_STATE);
+    }
+}
+
+int TestBDXDownloader_Setup(void * inContext)
+{
+    VerifyOrReturnError(chip::Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    VerifyOrReturnError(DeviceLayer::PlatformMgr().InitChipStack() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int TestBDXDownloader_Teardown(void * inContext)
+{
+    DeviceLayer::PlatformMgr().Shutdown();
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Test Finalize completing the download", TestFinalizeSucceeds),
+    NL_TEST_DEF("Test Finalize failing the download", TestFinalizeFails),
+    NL_TEST_DEF("Test Finalize in progress", TestFinalizeInProgress),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestBDXDownloader()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "BDXDownloader",
+        &sTests[0],
+        TestBDXDownloader_Setup,
+        TestBDXDownloader_Teardown
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestBDXDownloader)
@@ -34,6 +34,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
 #include <string.h>
+#include <system/SystemClock.h>
 #include <vector>
 
 using TestContext = chip::Test::AppContext;
@@ -44,6 +45,9 @@ namespace {
 
 nlTestSuite * gSuite = nullptr;
 
+// Storage mode used by RunAndValidateSequence().
+ClusterStateCache::StorageMode gStorageMode = ClusterStateCache::StorageMode::kTree;
+
 struct AttributeInstruction
 {
     enum AttributeType
@@ -543,6 +547,7 @@ void RunAndValidateSequence(AttributeInstructionListType list)
     ForwardedDataCallbackValidator dataCallbackValidator;
     CacheValidator client(list, dataCallbackValidator);
     ClusterStateCache cache(client);
+    NL_TEST_ASSERT(gSuite, cache.SetStorageMode(gStorageMode) == CHIP_NO_ERROR);
 
     // In order for the cache to track our data versions, we need to claim to it
     // that we are dealing with a wildcard path.  And we need to do that before
@@ -684,10 +689,329 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+void TestFlatCache(nlTestSuite * apSuite, void * apContext)
+{
+    gStorageMode = ClusterStateCache::StorageMode::kFlat;
+    TestCache(apSuite, apContext);
+    gStorageMode = ClusterStateCache::StorageMode::kTree;
+}
+
+class NullCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+struct RecordedAttributeReport
+{
+    ConcreteDataAttributePath mPath;
+    // Anonymous TLV element holding the value, or empty if the report carried a status.
+    std::vector<uint8_t> mData;
+};
+
+using RecordedReport = std::vector<RecordedAttributeReport>;
+
+constexpr EndpointId kRecordedEndpoints    = 8;
+constexpr ClusterId kRecordedClusters      = 16;
+constexpr AttributeId kRecordedAttributes  = 24;
+constexpr size_t kRecordedUpdateReports    = 40;
+constexpr size_t kRecordedUpdateStride     = 5;
+constexpr AttributeId kRecordedStatusEvery = 37;
+
+/*
+ * Encode the value reported for an attribute in a given report: scalars, strings of varying length,
+ * structs and short lists, roughly the mix seen when subscribing to a whole node.
+ */
+void RecordAttributeValue(AttributeId attributeId, uint32_t reportIndex, std::vector<uint8_t> & aData)
+{
+    uint8_t buf[128];
+    TLV::TLVWriter writer;
+    TLV::TLVType container;
+    writer.Init(buf);
+
+    switch (attributeId % 4)
+    {
+    case 0:
+        NL_TEST_ASSERT(gSuite, writer.Put(TLV::AnonymousTag(), reportIndex * 1000 + attributeId) == CHIP_NO_ERROR);
+        break;
+    case 1: {
+        char str[64];
+        size_t length = 8 + (reportIndex + attributeId) % 40;
+        memset(str, static_cast<char>('a' + reportIndex % 26), length);
+        NL_TEST_ASSERT(gSuite, writer.PutString(TLV::AnonymousTag(), str, static_cast<uint32_t>(length)) == CHIP_NO_ERROR);
+        break;
+    }
+    case 2:
+        NL_TEST_ASSERT(gSuite, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, container) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, writer.Put(TLV::ContextTag(0), reportIndex) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, writer.PutBoolean(TLV::ContextTag(1), (reportIndex % 2) == 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, writer.EndContainer(container) == CHIP_NO_ERROR);
+        break;
+    default:
+        NL_TEST_ASSERT(gSuite, writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, container) == CHIP_NO_ERROR);
+        for (uint32_t i = 0; i < 1 + (reportIndex % 6); i++)
+        {
+            NL_TEST_ASSERT(gSuite, writer.Put(TLV::AnonymousTag(), static_cast<uint8_t>(i + attributeId)) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(gSuite, writer.EndContainer(container) == CHIP_NO_ERROR);
+        break;
+    }
+
+    NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+    aData.assign(buf, buf + writer.GetLengthWritten());
+}
+
+/*
+ * Record a priming report for a wildcard subscription to a large node, followed by update reports
+ * that each change a different fifth of its attributes.
+ */
+void RecordReportStream(std::vector<RecordedReport> & aStream)
+{
+    for (uint32_t reportIndex = 0; reportIndex <= kRecordedUpdateReports; reportIndex++)
+    {
+        RecordedReport report;
+        for (EndpointId endpoint = 0; endpoint < kRecordedEndpoints; endpoint++)
+        {
+            for (ClusterId cluster = 0; cluster < kRecordedClusters; cluster++)
+            {
+                for (AttributeId attribute = 0; attribute < kRecordedAttributes; attribute++)
+                {
+                    if (reportIndex > 0 && (attribute + cluster + reportIndex) % kRecordedUpdateStride != 0)
+                    {
+                        continue;
+                    }
+
+                    RecordedAttributeReport item;
+                    item.mPath = ConcreteDataAttributePath(endpoint, cluster, attribute,
+                                                           MakeOptional(static_cast<DataVersion>(reportIndex + 1)));
+                    if ((attribute + cluster * kRecordedAttributes) % kRecordedStatusEvery != 0)
+                    {
+                        RecordAttributeValue(attribute, reportIndex, item.mData);
+                    }
+                    report.push_back(std::move(item));
+                }
+            }
+        }
+        aStream.push_back(std::move(report));
+    }
+}
+
+void IngestReport(ClusterStateCache & cache, const RecordedReport & report)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    callback.OnReportBegin();
+    for (const auto & item : report)
+    {
+        if (item.mData.empty())
+        {
+            StatusIB status;
+            status.mStatus = Protocols::InteractionModel::Status::UnsupportedAttribute;
+            callback.OnAttributeData(item.mPath, nullptr, status);
+            continue;
+        }
+
+        TLV::TLVReader reader;
+        reader.Init(item.mData.data(), item.mData.size());
+        NL_TEST_ASSERT(gSuite, reader.Next() == CHIP_NO_ERROR);
+        callback.OnAttributeData(item.mPath, &reader, StatusIB());
+    }
+    callback.OnReportEnd();
+}
+
+// Claim a wildcard subscription, so that the cache tracks data versions, and return the encoded DataVersionFilterIBs.
+size_t EncodeDataVersionFilters(ClusterStateCache & cache, uint8_t * buf, size_t bufSize)
+{
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+
+    TLV::TLVWriter writer;
+    writer.Init(buf, bufSize);
+    DataVersionFilterIBs::Builder builder;
+    NL_TEST_ASSERT(gSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    NL_TEST_ASSERT(gSuite,
+                   cache.GetBufferedCallback().OnUpdateDataVersionFilterList(builder, pathSpan, encodedDataVersionList) ==
+                       CHIP_NO_ERROR);
+    return writer.GetLengthWritten();
+}
+
+/*
+ * Copy the cached value at a path out as an anonymous TLV element so it can be compared across caches.
+ */
+CHIP_ERROR CopyCachedValue(const ClusterStateCache & cache, const ConcreteAttributePath & path, std::vector<uint8_t> & aData)
+{
+    uint8_t buf[128];
+    TLV::TLVReader reader;
+    ReturnErrorOnFailure(cache.Get(path, reader));
+
+    TLV::TLVWriter writer;
+    writer.Init(buf);
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    ReturnErrorOnFailure(writer.Finalize());
+    aData.assign(buf, buf + writer.GetLengthWritten());
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Ingest the same recorded report stream into a cache using each storage mode, check that both end up
+ * with identical content, and log throughput and memory use.
+ */
+// The arena slot of a value is sized by the value, not by the rest of the report it is read from.
+void TestFlatCacheArenaSize(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t report[1024];
+    TLV::TLVWriter writer;
+    writer.Init(report, sizeof(report));
+    NL_TEST_ASSERT(apSuite, writer.Put(TLV::AnonymousTag(), static_cast<uint32_t>(0x12345678)) == CHIP_NO_ERROR);
+    while (writer.GetRemainingFreeLength() > 32)
+    {
+        NL_TEST_ASSERT(apSuite, writer.PutString(TLV::AnonymousTag(), "rest of the report") == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    NullCacheCallback callback;
+    ClusterStateCache cache(callback);
+    NL_TEST_ASSERT(apSuite, cache.SetStorageMode(ClusterStateCache::StorageMode::kFlat) == CHIP_NO_ERROR);
+
+    ConcreteDataAttributePath path(1, 2, 3);
+    TLV::TLVReader reader;
+    reader.Init(report, writer.GetLengthWritten());
+    NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR);
+
+    ReadClient::Callback & bufferedCallback = cache.GetBufferedCallback();
+    bufferedCallback.OnReportBegin();
+    bufferedCallback.OnAttributeData(path, &reader, StatusIB());
+    bufferedCallback.OnReportEnd();
+
+    const ClusterStateCache::MemoryStats stats = cache.GetMemoryStats();
+    NL_TEST_ASSERT(apSuite, stats.dataBytes == 1 + sizeof(uint32_t));
+    NL_TEST_ASSERT(apSuite, stats.arenaBytes < sizeof(report) / 2);
+
+    uint32_t value = 0;
+    TLV::TLVReader cached;
+    NL_TEST_ASSERT(apSuite, cache.Get(path, cached) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cached.Get(value) == CHIP_NO_ERROR && value == 0x12345678);
+}
+
+void BenchmarkReportIngestion(nlTestSuite * apSuite, void * apContext)
+{
+    std::vector<RecordedReport> stream;
+    RecordReportStream(stream);
+
+    size_t attributeReports = 0;
+    for (const auto & report : stream)
+    {
+        attributeReports += report.size();
+    }
+
+    NullCacheCallback treeCallback;
+    NullCacheCallback flatCallback;
+    ClusterStateCache treeCache(treeCallback);
+    ClusterStateCache flatCache(flatCallback);
+    NL_TEST_ASSERT(apSuite, flatCache.SetStorageMode(ClusterStateCache::StorageMode::kFlat) == CHIP_NO_ERROR);
+
+    uint8_t treeFilters[64];
+    uint8_t flatFilters[64];
+    NL_TEST_ASSERT(apSuite, EncodeDataVersionFilters(treeCache, treeFilters, sizeof(treeFilters)) > 0);
+    NL_TEST_ASSERT(apSuite, EncodeDataVersionFilters(flatCache, flatFilters, sizeof(flatFilters)) > 0);
+
+    for (ClusterStateCache * cache : { &treeCache, &flatCache })
+    {
+        const uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (const auto & report : stream)
+        {
+            IngestReport(*cache, report);
+        }
+        const uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+        const ClusterStateCache::MemoryStats stats = cache->GetMemoryStats();
+        ChipLogProgress(Test,
+                        "Report ingestion, %s storage: %u attribute reports in %u us (%u reports/s), %u attributes, "
+                        "%u data bytes, %u index bytes, %u allocations, %u compactions",
+                        cache == &flatCache ? "flat" : "tree", static_cast<unsigned>(attributeReports),
+                        static_cast<unsigned>(elapsedUs),
+                        static_cast<unsigned>(elapsedUs ? (attributeReports * 1000000) / elapsedUs : 0),
+                        static_cast<unsigned>(stats.attributeCount), static_cast<unsigned>(stats.dataBytes),
+                        static_cast<unsigned>(stats.indexBytes), static_cast<unsigned>(stats.allocations),
+                        static_cast<unsigned>(stats.compactions));
+    }
+
+    const ClusterStateCache::MemoryStats treeStats = treeCache.GetMemoryStats();
+    const ClusterStateCache::MemoryStats flatStats = flatCache.GetMemoryStats();
+    NL_TEST_ASSERT(apSuite, treeStats.attributeCount == kRecordedEndpoints * kRecordedClusters * kRecordedAttributes);
+    NL_TEST_ASSERT(apSuite, flatStats.attributeCount == treeStats.attributeCount);
+    NL_TEST_ASSERT(apSuite, flatStats.clusterCount == treeStats.clusterCount);
+    NL_TEST_ASSERT(apSuite, flatStats.dataBytes == treeStats.dataBytes);
+    NL_TEST_ASSERT(apSuite, flatStats.allocations < treeStats.allocations);
+    NL_TEST_ASSERT(apSuite, flatStats.compactions > 0);
+    NL_TEST_ASSERT(apSuite, flatStats.deadBytes < flatStats.arenaBytes);
+
+    // Every path must read back the same value or status from both caches, in the same order.
+    std::vector<ConcreteAttributePath> treePaths;
+    std::vector<ConcreteAttributePath> flatPaths;
+    for (EndpointId endpoint = 0; endpoint < kRecordedEndpoints; endpoint++)
+    {
+        NL_TEST_ASSERT(apSuite, treeCache.ForEachCluster(endpoint, [&](ClusterId cluster) {
+            return treeCache.ForEachAttribute(endpoint, cluster, [&](const ConcreteAttributePath & path) {
+                treePaths.push_back(path);
+                return CHIP_NO_ERROR;
+            });
+        }) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, flatCache.ForEachCluster(endpoint, [&](ClusterId cluster) {
+            return flatCache.ForEachAttribute(endpoint, cluster, [&](const ConcreteAttributePath & path) {
+                flatPaths.push_back(path);
+                return CHIP_NO_ERROR;
+            });
+        }) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, treePaths.size() == treeStats.attributeCount);
+    NL_TEST_ASSERT(apSuite, treePaths == flatPaths);
+
+    for (const auto & path : treePaths)
+    {
+        std::vector<uint8_t> treeValue;
+        std::vector<uint8_t> flatValue;
+        CHIP_ERROR treeErr = CopyCachedValue(treeCache, path, treeValue);
+        NL_TEST_ASSERT(apSuite, CopyCachedValue(flatCache, path, flatValue) == treeErr);
+        NL_TEST_ASSERT(apSuite, treeValue == flatValue);
+
+        if (treeErr == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
+        {
+            StatusIB status;
+            NL_TEST_ASSERT(apSuite, flatCache.GetStatus(path, status) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, status.mStatus == Protocols::InteractionModel::Status::UnsupportedAttribute);
+        }
+    }
+
+    size_t clusterOneAttributes = 0;
+    NL_TEST_ASSERT(apSuite, flatCache.ForEachAttribute(ClusterId(1), [&](const ConcreteAttributePath &) {
+        clusterOneAttributes++;
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, clusterOneAttributes == kRecordedEndpoints * kRecordedAttributes);
+
+    Optional<DataVersion> treeVersion;
+    Optional<DataVersion> flatVersion;
+    NL_TEST_ASSERT(apSuite, treeCache.GetVersion(ConcreteClusterPath(3, 5), treeVersion) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, flatCache.GetVersion(ConcreteClusterPath(3, 5), flatVersion) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, treeVersion.HasValue() && treeVersion == flatVersion);
+
+    // Both caches must pick the same data version filters.
+    const size_t treeLength = EncodeDataVersionFilters(treeCache, treeFilters, sizeof(treeFilters));
+    const size_t flatLength = EncodeDataVersionFilters(flatCache, flatFilters, sizeof(flatFilters));
+    NL_TEST_ASSERT(apSuite, treeLength == flatLength && memcmp(treeFilters, flatFilters, treeLength) == 0);
+
+    // The storage mode can only be changed while the cache is empty.
+    NL_TEST_ASSERT(apSuite, flatCache.SetStorageMode(ClusterStateCache::StorageMode::kTree) == CHIP_ERROR_INCORRECT_STATE);
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestFlatCache", TestFlatCache),
+    NL_TEST_DEF("TestFlatCacheArenaSize", TestFlatCacheArenaSize),
+    NL_TEST_DEF("BenchmarkReportIngestion", BenchmarkReportIngestion),
     NL_TEST_SENTINEL()
 };
 
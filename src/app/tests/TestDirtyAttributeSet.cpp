@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtyAttributeSet.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr EndpointId kUnknownEndpointId = 0xFFFE;
+
+// Every cluster of every endpoint but kUnknownEndpointId has attributes 0 to 0xFFFF at index = id.
+uint16_t AttributeIndex(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    if (aEndpointId == kUnknownEndpointId || aAttributeId >= UINT16_MAX)
+    {
+        return UINT16_MAX;
+    }
+    return static_cast<uint16_t>(aAttributeId);
+}
+
+void TestInsertAndCheck(nlTestSuite * inSuite, void * inContext)
+{
+    DirtyAttributeSet set(AttributeIndex);
+
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 0));
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 6, 0), 10));
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 6, 2), 12));
+    NL_TEST_ASSERT(inSuite, set.ClusterCount() == 1);
+
+    // Each attribute keeps its own generation.
+    NL_TEST_ASSERT(inSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 9));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 10));
+    NL_TEST_ASSERT(inSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 2), 11));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 2), 12));
+
+    // Other attributes of the cluster, and other clusters, are not dirty.
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 1), 0));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 8, 0), 0));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(2, 6, 0), 0));
+
+    // Marking an attribute again moves its generation.
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 6, 0), 15));
+    NL_TEST_ASSERT(inSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 12));
+    NL_TEST_ASSERT(inSuite, set.GetStats().inserts == 3);
+
+    set.Clear();
+    NL_TEST_ASSERT(inSuite, set.ClusterCount() == 0);
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 0));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 2), 0));
+
+    // The generations after a Clear are independent of the ones before.
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 6, 2), 100));
+    NL_TEST_ASSERT(inSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, 2), 99));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(ConcreteAttributePath(1, 6, 0), 0));
+}
+
+void TestManyAttributesStayExact(nlTestSuite * inSuite, void * inContext)
+{
+    DirtyAttributeSet set(AttributeIndex);
+    uint64_t generation = 1;
+
+    // More dirty attributes than CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, all in the same cluster.
+    for (AttributeId id = 0; id < DirtyAttributeSet::kMaxAttributes; id += 2)
+    {
+        NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 6, id), generation++));
+    }
+    for (AttributeId id = 0; id < DirtyAttributeSet::kMaxAttributes; id++)
+    {
+        NL_TEST_ASSERT(inSuite, set.IsDirtySince(ConcreteAttributePath(1, 6, id), 0) == (id % 2 == 0));
+    }
+    NL_TEST_ASSERT(inSuite, set.ClusterCount() == 1);
+}
+
+void TestRejectedPaths(nlTestSuite * inSuite, void * inContext)
+{
+    DirtyAttributeSet set(AttributeIndex);
+    const ConcreteAttributePath pastLastAttribute(1, 6, static_cast<AttributeId>(DirtyAttributeSet::kMaxAttributes));
+
+    // Unknown attributes and attributes past kMaxAttributes are not kept.
+    NL_TEST_ASSERT(inSuite, !set.Insert(ConcreteAttributePath(kUnknownEndpointId, 6, 0), 1));
+    NL_TEST_ASSERT(inSuite, !set.Insert(pastLastAttribute, 1));
+    NL_TEST_ASSERT(inSuite, !set.IsDirtySince(pastLastAttribute, 0));
+    NL_TEST_ASSERT(inSuite, set.ClusterCount() == 0);
+
+    // Neither are attributes of a new cluster once every cluster entry is used.
+    for (ClusterId id = 0; id < DirtyAttributeSet::kClusterCount; id++)
+    {
+        NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, id, 0), 2));
+    }
+    NL_TEST_ASSERT(inSuite, !set.Insert(ConcreteAttributePath(2, 0, 0), 3));
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 0, 1), 3));
+    NL_TEST_ASSERT(inSuite, set.GetStats().rejected == 3);
+
+    // Generations too far from the first one since the last Clear are not kept either.
+    NL_TEST_ASSERT(inSuite, !set.Insert(ConcreteAttributePath(1, 0, 2), 2 + static_cast<uint64_t>(UINT32_MAX)));
+    set.Clear();
+    NL_TEST_ASSERT(inSuite, set.Insert(ConcreteAttributePath(1, 0, 2), 2 + static_cast<uint64_t>(UINT32_MAX)));
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Insert and check", TestInsertAndCheck),
+    NL_TEST_DEF("Many attributes stay exact", TestManyAttributesStayExact),
+    NL_TEST_DEF("Rejected paths", TestRejectedPaths),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestDirtyAttributeSet()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "Test for the dirty attribute set",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDirtyAttributeSet)
@@ -47,6 +47,8 @@
 
 #include <nlunit-test.h>
 
+#include <vector>
+
 namespace {
 
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
@@ -60,6 +62,12 @@ static uint8_t gInfoEventBuffer[120];
 static uint8_t gCritEventBuffer[120];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
+// Large enough to hold more events than CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+static uint8_t gLargeDebugEventBuffer[2048];
+static uint8_t gLargeInfoEventBuffer[1024];
+static uint8_t gLargeCritEventBuffer[1024];
+static chip::app::CircularEventBuffer gLargeCircularEventBuffer[3];
+
 class TestContext : public chip::Test::AppContext
 {
 public:
@@ -311,9 +319,106 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+// Append the numbers of the events read by aReader that are in aPath and not older than aEventMin.
+static void CollectEventNumbers(chip::TLV::TLVReader & aReader, const chip::app::EventPathParams & aPath,
+                                chip::EventNumber aEventMin, std::vector<chip::EventNumber> & aEventNumbers)
+{
+    while (aReader.Next() == CHIP_NO_ERROR)
+    {
+        chip::app::EventReportIB::Parser report;
+        chip::app::EventDataIB::Parser data;
+        chip::app::EventPathIB::Parser pathParser;
+        chip::app::ConcreteEventPath path;
+        chip::EventNumber eventNumber;
+
+        VerifyOrDie(report.Init(aReader) == CHIP_NO_ERROR);
+        VerifyOrDie(report.GetEventData(&data) == CHIP_NO_ERROR);
+        VerifyOrDie(data.GetEventNumber(&eventNumber) == CHIP_NO_ERROR);
+        VerifyOrDie(data.GetPath(&pathParser) == CHIP_NO_ERROR);
+        VerifyOrDie(pathParser.GetEventPath(&path) == CHIP_NO_ERROR);
+        if (eventNumber >= aEventMin && aPath.IsEventPathSupersetOf(path))
+        {
+            aEventNumbers.push_back(eventNumber);
+        }
+    }
+}
+
+static void CheckFetchEventsSinceMatchesLog(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    const chip::app::LogStorageResources logStorageResources[] = {
+        { &gLargeDebugEventBuffer[0], sizeof(gLargeDebugEventBuffer), chip::app::PriorityLevel::Debug },
+        { &gLargeInfoEventBuffer[0], sizeof(gLargeInfoEventBuffer), chip::app::PriorityLevel::Info },
+        { &gLargeCritEventBuffer[0], sizeof(gLargeCritEventBuffer), chip::app::PriorityLevel::Critical },
+    };
+
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(0) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gLargeCircularEventBuffer, logStorageResources, &eventCounter);
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // Mix priorities and endpoints so that events get moved to the next buffers, dropped, and interleaved across paths.
+    TestEventGenerator testEventGenerator;
+    chip::EventNumber lastEventNumber = 0;
+    for (int32_t i = 0; i < 300; i++)
+    {
+        chip::app::EventOptions options;
+        options.mPath     = { (i % 3 == 0) ? kTestEndpointId2 : kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        options.mPriority = static_cast<chip::app::PriorityLevel>((i / 2) % 3);
+        testEventGenerator.SetStatus(i);
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, lastEventNumber) == CHIP_NO_ERROR);
+    }
+
+    chip::app::EventPathParams paths[3];
+    paths[0].mEndpointId = kTestEndpointId1;
+    paths[0].mClusterId  = kLivenessClusterId;
+    paths[1].mEndpointId = kTestEndpointId2;
+    paths[1].mClusterId  = kLivenessClusterId;
+    paths[1].mEventId    = kLivenessChangeEvent;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> backingStore;
+    VerifyOrDie(backingStore.Alloc(8192));
+
+    for (const auto & path : paths)
+    {
+        chip::SingleLinkedListNode<chip::app::EventPathParams> pathList;
+        pathList.mValue = path;
+
+        for (chip::EventNumber eventMin = 0; eventMin <= lastEventNumber + 1; eventMin += 7)
+        {
+            std::vector<chip::EventNumber> expected;
+            chip::TLV::TLVReader logReader;
+            chip::app::CircularEventBufferWrapper bufWrapper;
+            NL_TEST_ASSERT(apSuite,
+                           logMgmt.GetEventReader(logReader, chip::app::PriorityLevel::Critical, &bufWrapper) == CHIP_NO_ERROR);
+            CollectEventNumbers(logReader, path, eventMin, expected);
+
+            chip::TLV::TLVWriter writer;
+            size_t eventCount              = 0;
+            chip::EventNumber nextEventMin = eventMin;
+            writer.Init(backingStore.Get(), 8192);
+            NL_TEST_ASSERT(apSuite,
+                           logMgmt.FetchEventsSince(writer, &pathList, nextEventMin, eventCount,
+                                                    chip::Access::SubjectDescriptor{}) == CHIP_NO_ERROR);
+
+            std::vector<chip::EventNumber> fetched;
+            chip::TLV::TLVReader reportReader;
+            reportReader.Init(backingStore.Get(), writer.GetLengthWritten());
+            CollectEventNumbers(reportReader, path, 0, fetched);
+
+            NL_TEST_ASSERT(apSuite, fetched == expected);
+            NL_TEST_ASSERT(apSuite, eventCount == expected.size());
+            NL_TEST_ASSERT(apSuite, nextEventMin == lastEventNumber + 1);
+        }
+    }
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckFetchEventsSinceMatchesLog", CheckFetchEventsSinceMatchesLog),
     NL_TEST_SENTINEL(),
 };
 
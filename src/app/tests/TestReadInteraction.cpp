@@ -292,6 +292,30 @@ public:
     }
 };
 
+// Denies one subject reading one endpoint, and allows everything else.
+class DenyEndpointAccessControlDelegate : public chip::Access::AccessControl::Delegate
+{
+public:
+    CHIP_ERROR Check(const chip::Access::SubjectDescriptor & subjectDescriptor, const chip::Access::RequestPath & requestPath,
+                     chip::Access::Privilege requestPrivilege) override
+    {
+        if (subjectDescriptor.subject == mDeniedSubject && requestPath.endpoint == mDeniedEndpoint)
+        {
+            return CHIP_ERROR_ACCESS_DENIED;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    chip::NodeId mDeniedSubject      = chip::kUndefinedNodeId;
+    chip::EndpointId mDeniedEndpoint = chip::kInvalidEndpointId;
+};
+
+class TestDeviceTypeResolver : public chip::Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(chip::DeviceTypeId deviceType, chip::EndpointId endpoint) override { return false; }
+} gDeviceTypeResolver;
+
 } // namespace
 
 using ReportScheduler     = chip::app::reporting::ReportScheduler;
@@ -388,6 +412,8 @@ public:
     static void TestSubscribeWildcard(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribePartialOverlap(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeSetDirtyFullyOverlap(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeSharedReport(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeSharedReportDifferentSubjects(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeEarlyShutdown(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext);
     static void TestReadInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext);
@@ -2891,6 +2917,203 @@ void TestReadInteraction::TestSubscribeSetDirtyFullyOverlap(nlTestSuite * apSuit
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+// Verify that subscriptions with the same paths get the same report, each with their own subscription id.
+void TestReadInteraction::TestSubscribeSharedReport(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    MockInteractionModelApp delegates[3];
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    err           = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+    uint32_t sharedBefore = engine->GetReportingEngine().GetSharedReportStats().shared;
+#endif
+
+    {
+        // The first two subscriptions have the same paths, the last one has the same attribute with a different endpoint.
+        std::unique_ptr<app::ReadClient> readClients[ArraySize(delegates)];
+        for (size_t i = 0; i < ArraySize(delegates); i++)
+        {
+            ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+            AttributePathParams attributePathParams(i < 2 ? Test::kMockEndpoint2 : Test::kMockEndpoint3, Test::MockClusterId(2),
+                                                    Test::MockAttributeId(1));
+            readPrepareParams.mpAttributePathParamsList    = &attributePathParams;
+            readPrepareParams.mAttributePathParamsListSize = 1;
+            readPrepareParams.mMinIntervalFloorSeconds     = 0;
+            readPrepareParams.mMaxIntervalCeilingSeconds   = 1;
+            readPrepareParams.mKeepSubscriptions           = true;
+
+            readClients[i] = std::make_unique<app::ReadClient>(engine, &ctx.GetExchangeManager(), delegates[i],
+                                                               chip::app::ReadClient::InteractionType::Subscribe);
+            err = readClients[i]->SendRequest(readPrepareParams);
+            NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        }
+
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe) == 3);
+        for (auto & delegate : delegates)
+        {
+            NL_TEST_ASSERT(apSuite, delegate.mGotReport && delegate.mNumAttributeResponse == 1);
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+        }
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        // Priming reports are never shared.
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().GetSharedReportStats().shared == sharedBefore);
+#endif
+
+        AttributePathParams dirtyPath;
+        err = engine->GetReportingEngine().SetDirty(dirtyPath);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        for (size_t i = 0; i < ArraySize(delegates); i++)
+        {
+            NL_TEST_ASSERT(apSuite, delegates[i].mGotReport);
+            NL_TEST_ASSERT(apSuite, delegates[i].mNumAttributeResponse == 1);
+            NL_TEST_ASSERT(apSuite, delegates[i].mReceivedAttributePaths.back().mEndpointId ==
+                               (i < 2 ? Test::kMockEndpoint2 : Test::kMockEndpoint3));
+        }
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        // The report built for one of the first two subscriptions was sent to the other one as well.
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().GetSharedReportStats().shared == sharedBefore + 1);
+#endif
+    }
+
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadClients() == 0);
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+// Verify that subscriptions from different controllers share a report when access control gives them the same
+// decisions for its paths, and do not once it does not.
+void TestReadInteraction::TestSubscribeSharedReportDifferentSubjects(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    const NodeId kControllerNodeIds[] = { 0x0000000000A1B001, 0x0000000000A1B002 };
+    const NodeId aliceNodeId          = ctx.GetAliceFabric()->GetNodeId();
+
+    // One CASE session pair per controller, each with a controller node ID of its own on Alice's fabric.
+    SessionHolder controllerSessions[ArraySize(kControllerNodeIds)];
+    SessionHolder deviceSessions[ArraySize(kControllerNodeIds)];
+    for (size_t i = 0; i < ArraySize(kControllerNodeIds); i++)
+    {
+        uint16_t controllerKeyId = static_cast<uint16_t>(10 + 2 * i);
+        uint16_t deviceKeyId     = static_cast<uint16_t>(11 + 2 * i);
+
+        err = ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+            controllerSessions[i], controllerKeyId, deviceKeyId, kControllerNodeIds[i], aliceNodeId, ctx.GetBobFabricIndex(),
+            ctx.GetAliceAddress(), CryptoContext::SessionRole::kInitiator);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+            deviceSessions[i], deviceKeyId, controllerKeyId, aliceNodeId, kControllerNodeIds[i], ctx.GetAliceFabricIndex(),
+            ctx.GetBobAddress(), CryptoContext::SessionRole::kResponder);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    DenyEndpointAccessControlDelegate accessControlDelegate;
+    Access::GetAccessControl().Finish();
+    err = Access::GetAccessControl().Init(&accessControlDelegate, gDeviceTypeResolver);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    MockInteractionModelApp delegates[ArraySize(kControllerNodeIds)];
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    err           = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    {
+        // MockAttributeId(1) of MockClusterId(2) is on all three mock endpoints.
+        std::unique_ptr<app::ReadClient> readClients[ArraySize(delegates)];
+        for (size_t i = 0; i < ArraySize(delegates); i++)
+        {
+            ReadPrepareParams readPrepareParams(controllerSessions[i].Get().Value());
+            AttributePathParams attributePathParams(Test::MockClusterId(2), Test::MockAttributeId(1));
+            readPrepareParams.mpAttributePathParamsList    = &attributePathParams;
+            readPrepareParams.mAttributePathParamsListSize = 1;
+            readPrepareParams.mMinIntervalFloorSeconds     = 0;
+            readPrepareParams.mMaxIntervalCeilingSeconds   = 1;
+            readPrepareParams.mKeepSubscriptions           = true;
+
+            readClients[i] = std::make_unique<app::ReadClient>(engine, &ctx.GetExchangeManager(), delegates[i],
+                                                               chip::app::ReadClient::InteractionType::Subscribe);
+            err = readClients[i]->SendRequest(readPrepareParams);
+            NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        }
+
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe) == 2);
+        for (auto & delegate : delegates)
+        {
+            NL_TEST_ASSERT(apSuite, delegate.mGotReport && delegate.mNumAttributeResponse == 3);
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+        }
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        uint32_t sharedBefore = engine->GetReportingEngine().GetSharedReportStats().shared;
+#endif
+
+        AttributePathParams dirtyPath;
+        err = engine->GetReportingEngine().SetDirty(dirtyPath);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        for (auto & delegate : delegates)
+        {
+            NL_TEST_ASSERT(apSuite, delegate.mGotReport && delegate.mNumAttributeResponse == 3);
+            delegate.mGotReport            = false;
+            delegate.mNumAttributeResponse = 0;
+        }
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        // Both subjects may read all paths, so one encoded report went to both subscriptions.
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().GetSharedReportStats().shared == sharedBefore + 1);
+#endif
+
+        // Once the second controller may no longer read one endpoint, its report is built for it alone.
+        accessControlDelegate.mDeniedSubject  = kControllerNodeIds[1];
+        accessControlDelegate.mDeniedEndpoint = Test::kMockEndpoint3;
+
+        err = engine->GetReportingEngine().SetDirty(dirtyPath);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, delegates[0].mGotReport && delegates[0].mNumAttributeResponse == 3);
+        NL_TEST_ASSERT(apSuite, delegates[1].mGotReport && delegates[1].mNumAttributeResponse == 2);
+        NL_TEST_ASSERT(apSuite, delegates[1].mReceivedAttributePaths.back().mEndpointId != Test::kMockEndpoint3);
+
+#if CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+        NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().GetSharedReportStats().shared == sharedBefore + 1);
+#endif
+    }
+
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadClients() == 0);
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    for (size_t i = 0; i < ArraySize(kControllerNodeIds); i++)
+    {
+        controllerSessions[i]->AsSecureSession()->MarkForEviction();
+        deviceSessions[i]->AsSecureSession()->MarkForEviction();
+    }
+
+    Access::GetAccessControl().Finish();
+    err = Access::GetAccessControl().Init(chip::Access::Examples::GetPermissiveAccessControlDelegate(), gDeviceTypeResolver);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
 // Verify that subscription can be shut down just after receiving SUBSCRIBE RESPONSE,
 // before receiving any subsequent REPORT DATA.
 void TestReadInteraction::TestSubscribeEarlyShutdown(nlTestSuite * apSuite, void * apContext)
@@ -5126,6 +5349,9 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestSubscribeWildcard", chip::app::TestReadInteraction::TestSubscribeWildcard),
     NL_TEST_DEF("TestSubscribePartialOverlap", chip::app::TestReadInteraction::TestSubscribePartialOverlap),
     NL_TEST_DEF("TestSubscribeSetDirtyFullyOverlap", chip::app::TestReadInteraction::TestSubscribeSetDirtyFullyOverlap),
+    NL_TEST_DEF("TestSubscribeSharedReport", chip::app::TestReadInteraction::TestSubscribeSharedReport),
+    NL_TEST_DEF("TestSubscribeSharedReportDifferentSubjects",
+                chip::app::TestReadInteraction::TestSubscribeSharedReportDifferentSubjects),
     NL_TEST_DEF("TestSubscribeEarlyShutdown", chip::app::TestReadInteraction::TestSubscribeEarlyShutdown),
     NL_TEST_DEF("TestSubscribeInvalidAttributePathRoundtrip",
                 chip::app::TestReadInteraction::TestSubscribeInvalidAttributePathRoundtrip),
@@ -27,15 +27,18 @@
 #include <app/reporting/Engine.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/core/TLVUtilities.h>
+#include <lib/support/Span.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
+#include <system/SystemClock.h>
 
 #include <cinttypes>
 #include <nlunit-test.h>
@@ -57,10 +60,22 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestIsDirtySince(nlTestSuite * apSuite, void * apContext);
+    static void TestSetDirtyMarksInterestedHandlers(nlTestSuite * apSuite, void * apContext);
+    static void TestSetDirtyBenchmark(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
 
+    static ReadHandler * CreateSubscriptionHandler(ReadHandler::ManagementCallback & aCallback,
+                                                   Messaging::ExchangeContext * apExchangeCtx, ReadHandler::Observer & aObserver,
+                                                   Span<const AttributePathParams> aPaths);
+    static bool IsMarkedDirty(const ReadHandler * apReadHandler)
+    {
+        const Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+        return apReadHandler->mDirtyGeneration == engine.GetDirtySetGeneration();
+    }
+
     struct ExpectedDirtySetContent : public AttributePathParams
     {
         ExpectedDirtySetContent(const AttributePathParams & path) : AttributePathParams(path) {}
@@ -126,6 +141,35 @@ public:
     }
 };
 
+class NullReadHandlerObserver : public ReadHandler::Observer
+{
+public:
+    void OnSubscriptionEstablished(ReadHandler * apReadHandler) override {}
+    void OnBecameReportable(ReadHandler * apReadHandler) override {}
+    void OnSubscriptionReportSent(ReadHandler * apReadHandler) override {}
+    void OnReadHandlerDestroyed(ReadHandler * apReadHandler) override {}
+};
+
+ReadHandler * TestReportingEngine::CreateSubscriptionHandler(ReadHandler::ManagementCallback & aCallback,
+                                                             Messaging::ExchangeContext * apExchangeCtx,
+                                                             ReadHandler::Observer & aObserver,
+                                                             Span<const AttributePathParams> aPaths)
+{
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    ReadHandler * handler =
+        imEngine->GetReadHandlerPool().CreateObject(aCallback, apExchangeCtx, ReadHandler::InteractionType::Subscribe, &aObserver);
+    VerifyOrReturnValue(handler != nullptr, nullptr);
+
+    for (const auto & path : aPaths)
+    {
+        VerifyOrReturnValue(imEngine->PushFrontAttributePathList(handler->mpAttributePathList, path) == CHIP_NO_ERROR, handler);
+    }
+    VerifyOrReturnValue(imEngine->GetReportingEngine().AddAttributeInterest(*handler) == CHIP_NO_ERROR, handler);
+    handler->ClearStateFlag(ReadHandler::ReadHandlerFlags::PrimingReports);
+    handler->MoveToState(ReadHandler::HandlerState::CanStartReporting);
+    return handler;
+}
+
 void TestReportingEngine::TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -330,6 +374,197 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestIsDirtySince(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.ReleaseAll();
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    engine.mDirtyAttributeSet.Clear();
+#endif
+    const uint64_t before = engine.GetDirtySetGeneration();
+    engine.BumpDirtySetGeneration();
+
+    const ConcreteAttributePath path(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(2), chip::Test::MockAttributeId(1));
+    bool isAmplified = true;
+    NL_TEST_ASSERT(apSuite, !engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+
+    // Only a wildcard match amplifies the path; a concrete match, before or after it, means the attribute changed.
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(path.mEndpointId, path.mClusterId, path.mAttributeId)));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(path.mEndpointId, path.mClusterId)));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+
+    engine.mGlobalDirtySet.ReleaseAll();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(path.mEndpointId, path.mClusterId)));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, isAmplified);
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(path.mEndpointId, path.mClusterId, path.mAttributeId)));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+
+    // Paths marked dirty at the given generation are not dirty since then.
+    NL_TEST_ASSERT(apSuite, !engine.IsDirtySince(path, engine.GetDirtySetGeneration(), &isAmplified));
+
+#if CHIP_IM_DIRTY_ATTRIBUTE_SET
+    // Attributes kept by the dirty attribute set are found exactly, and a wildcard of the global dirty set covering
+    // them does not amplify them.
+    engine.mGlobalDirtySet.ReleaseAll();
+    engine.BumpDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, engine.mDirtyAttributeSet.Insert(path, engine.GetDirtySetGeneration()));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before));
+    const ConcreteAttributePath otherPath(path.mEndpointId, path.mClusterId, chip::Test::MockAttributeId(2));
+    NL_TEST_ASSERT(apSuite, !engine.IsDirtySince(otherPath, before));
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(path.mEndpointId, kInvalidClusterId)));
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(path, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, !isAmplified);
+    NL_TEST_ASSERT(apSuite, engine.IsDirtySince(otherPath, before, &isAmplified));
+    NL_TEST_ASSERT(apSuite, isAmplified);
+#endif
+
+    engine.Shutdown();
+}
+
+void TestReportingEngine::TestSetDirtyMarksInterestedHandlers(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    DummyDelegate dummy;
+    NullReadHandlerObserver observer;
+
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler()) ==
+                       CHIP_NO_ERROR);
+    Engine & engine                          = imEngine->GetReportingEngine();
+    Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+    const AttributePathParams concretePaths[] = {
+        AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1),
+        AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId1),
+    };
+    const AttributePathParams wildcardEndpointPaths[] = { AttributePathParams(kInvalidEndpointId, kTestClusterId) };
+    const AttributePathParams wildcardClusterPaths[]  = { AttributePathParams(kTestEndpointId + 1, kInvalidClusterId) };
+
+    ReadHandler * concreteHandler =
+        CreateSubscriptionHandler(dummy, exchangeCtx, observer, Span<const AttributePathParams>(concretePaths));
+    ReadHandler * wildcardEndpointHandler =
+        CreateSubscriptionHandler(dummy, exchangeCtx, observer, Span<const AttributePathParams>(wildcardEndpointPaths));
+    ReadHandler * wildcardClusterHandler =
+        CreateSubscriptionHandler(dummy, exchangeCtx, observer, Span<const AttributePathParams>(wildcardClusterPaths));
+    NL_TEST_ASSERT(apSuite, concreteHandler != nullptr && wildcardEndpointHandler != nullptr && wildcardClusterHandler != nullptr);
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.GetAttributeInterestIndex().Allocated() == 4);
+#endif
+
+    AttributePathParams path(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(concreteHandler));
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(wildcardEndpointHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardClusterHandler));
+
+    // Only the attribute differs from the path of concreteHandler.
+    path = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(concreteHandler));
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(wildcardEndpointHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardClusterHandler));
+
+    path = AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardEndpointHandler));
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(wildcardClusterHandler));
+
+    path = AttributePathParams(kInvalidEndpointId, kTestClusterId + 1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardEndpointHandler));
+    NL_TEST_ASSERT(apSuite, IsMarkedDirty(wildcardClusterHandler));
+
+    // A path no handler is interested in is not added to the dirty set.
+    engine.mGlobalDirtySet.ReleaseAll();
+    path = AttributePathParams(kTestEndpointId + 2, kTestClusterId + 2, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, engine.SetDirty(path) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(concreteHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardEndpointHandler));
+    NL_TEST_ASSERT(apSuite, !IsMarkedDirty(wildcardClusterHandler));
+    NL_TEST_ASSERT(apSuite, engine.GetGlobalDirtySetSize() == 0);
+
+    imEngine->GetReadHandlerPool().ReleaseAll();
+#if CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+    NL_TEST_ASSERT(apSuite, engine.GetAttributeInterestIndex().Allocated() == 0);
+#endif
+    exchangeCtx->Close();
+    engine.Shutdown();
+}
+
+void TestReportingEngine::TestSetDirtyBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    DummyDelegate dummy;
+    NullReadHandlerObserver observer;
+
+    InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite,
+                   imEngine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), app::reporting::GetDefaultReportScheduler()) ==
+                       CHIP_NO_ERROR);
+    Engine & engine                          = imEngine->GetReportingEngine();
+    Messaging::ExchangeContext * exchangeCtx = ctx.NewExchangeToAlice(nullptr, false);
+
+    // Each of N handlers subscribes to M attributes of its own endpoint, like controllers watching the devices of a bridge.
+    // The sizes ({ N, M }) are bounded by the read handler and attribute path pools.
+    constexpr uint16_t kMaxPaths              = 16;
+    constexpr uint16_t kSizes[][2]            = { { 4, 4 }, { 16, kMaxPaths }, { 64, 4 } };
+    constexpr uint32_t kSetDirtys             = 20000;
+    AttributePathParams subscribed[kMaxPaths] = {};
+
+    for (const auto & size : kSizes)
+    {
+        const uint16_t handlers = size[0];
+        const uint16_t paths    = size[1];
+        for (uint16_t i = 0; i < handlers; i++)
+        {
+            for (uint16_t j = 0; j < paths; j++)
+            {
+                subscribed[j] = AttributePathParams(static_cast<EndpointId>(i + 1), kTestClusterId, j);
+            }
+            ReadHandler * handler =
+                CreateSubscriptionHandler(dummy, exchangeCtx, observer, Span<const AttributePathParams>(subscribed, paths));
+            NL_TEST_ASSERT(apSuite, handler != nullptr && handler->CanStartReporting());
+        }
+
+        // Mark the attributes of every endpoint dirty in turn, half of them being subscribed to.
+        const uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (uint32_t n = 0; n < kSetDirtys; n++)
+        {
+            AttributePathParams path(static_cast<EndpointId>(n % handlers + 1), kTestClusterId,
+                                     static_cast<AttributeId>((n / handlers) % (paths * 2)));
+            engine.SetDirty(path);
+        }
+        const uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+        ChipLogProgress(Test, "SetDirty, %u handlers x %u paths: %u calls in %u us (%u calls/s)",
+                        static_cast<unsigned>(handlers), static_cast<unsigned>(paths),
+                        static_cast<unsigned>(kSetDirtys), static_cast<unsigned>(elapsedUs),
+                        static_cast<unsigned>(elapsedUs ? (kSetDirtys * 1000000ull) / elapsedUs : 0));
+
+        imEngine->GetReadHandlerPool().ReleaseAll();
+        engine.mGlobalDirtySet.ReleaseAll();
+    }
+
+    exchangeCtx->Close();
+    engine.Shutdown();
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -341,6 +576,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestIsDirtySince", chip::app::reporting::TestReportingEngine::TestIsDirtySince),
+    NL_TEST_DEF("TestSetDirtyMarksInterestedHandlers", chip::app::reporting::TestReportingEngine::TestSetDirtyMarksInterestedHandlers),
+    NL_TEST_DEF("TestSetDirtyBenchmark", chip::app::reporting::TestReportingEngine::TestSetDirtyBenchmark),
     NL_TEST_SENTINEL()
 };
 // clang-format on
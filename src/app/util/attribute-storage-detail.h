@@ -76,11 +76,6 @@ emAfClusterPreAttributeChangedCallback(const chip::app::ConcreteAttributePath &
 // Returns 0 if the cluster does not exist.
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
 
-// Get the index of the given attribute of the specific cluster under the endpoint.
-// Returns UINT16_MAX if the attribute does not exist.
-uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint, chip::ClusterId cluster,
-                                                     chip::AttributeId attributeId);
-
 // Get the attribute id at the attributeIndex of the cluster under the endpoint. This function is useful for iterating over the
 // attributes.
 // Returns Optional<chip::AttributeId>::Missing() if the attribute does not exist.
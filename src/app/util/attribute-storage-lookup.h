@@ -0,0 +1,307 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/util/af-types.h>
+#include <app/util/att-storage.h>
+#include <app/util/attribute-metadata.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief Hash tables replacing the scans over the defined endpoints done by the ember attribute store to find an
+ * endpoint index from an endpoint id, and an attribute (with its storage offset) from an attribute path.
+ *
+ * The tables are built from the defined endpoints by Build(), and must be invalidated whenever the endpoint ids,
+ * endpoint types, endpoint count or enabled state of the defined endpoints change. Entries follow the first-match
+ * rules of the scans: the first endpoint with a given id (or the first enabled one), and the first server cluster with
+ * a given id on that endpoint.
+ *
+ * If the attributes do not fit in the attribute table, only endpoints are looked up, and every attribute lookup
+ * misses so that the caller falls back to its scan.
+ *
+ * @tparam kEndpointTableSize  number of endpoint slots, a power of two larger than the number of endpoints
+ * @tparam kAttributeTableSize number of attribute slots, a power of two
+ */
+template <size_t kEndpointTableSize, size_t kAttributeTableSize>
+class AttributeStoreLookupTables
+{
+public:
+    static constexpr uint16_t kInvalidIndex = 0xFFFF;
+
+    static_assert(kEndpointTableSize > 0 && (kEndpointTableSize & (kEndpointTableSize - 1)) == 0,
+                  "The endpoint lookup table size must be a power of two");
+    static_assert(kAttributeTableSize > 0 && (kAttributeTableSize & (kAttributeTableSize - 1)) == 0,
+                  "The attribute lookup table size must be a power of two");
+
+    struct AttributeEntry
+    {
+        const EmberAfAttributeMetadata * metadata = nullptr; // nullptr if the slot is free
+        ClusterId clusterId                       = 0;
+        AttributeId attributeId                   = 0;
+        EndpointId endpoint                       = kInvalidEndpointId;
+        uint16_t endpointIndex                    = 0;
+        uint16_t storageOffset                    = 0; // offset in the attribute storage of the fixed endpoints
+    };
+
+    void Invalidate() { mState = State::kStale; }
+
+    bool IsStale() const { return mState == State::kStale; }
+
+    /**
+     * Build the tables from the defined endpoints, the first fixedEndpointCount of which have their non-external,
+     * non-singleton attributes stored one after the other, in endpoint order.
+     */
+    void Build(Span<const EmberAfDefinedEndpoint> endpoints, uint16_t fixedEndpointCount);
+
+    /**
+     * @return the index of the first endpoint with this id (the first enabled one if ignoreDisabledEndpoints), or
+     *         kInvalidIndex if there is none.
+     */
+    uint16_t FindEndpointIndex(EndpointId endpoint, bool ignoreDisabledEndpoints) const;
+
+    /**
+     * @return the attribute, or nullptr if it was not found, in which case the scan must be used.
+     */
+    const AttributeEntry * FindAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId) const;
+
+private:
+    enum class State : uint8_t
+    {
+        kStale,
+        kValid,
+        kEndpointsOnly, // the attributes did not fit in mAttributes
+    };
+
+    struct EndpointEntry
+    {
+        EndpointId endpoint   = kInvalidEndpointId; // kInvalidEndpointId if the slot is free
+        uint16_t index        = kInvalidIndex;      // first index with this endpoint id
+        uint16_t enabledIndex = kInvalidIndex;      // first enabled index with this endpoint id
+    };
+
+    // The attribute table is kept at most three quarters full.
+    static constexpr size_t kMaxAttributeCount = kAttributeTableSize - kAttributeTableSize / 4;
+
+    static size_t HashEndpoint(EndpointId endpoint)
+    {
+        uint32_t hash = endpoint * 0x9E3779B1u;
+        return hash ^ (hash >> 16);
+    }
+
+    static size_t HashAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+    {
+        uint64_t hash = ((static_cast<uint64_t>(clusterId) << 32) | attributeId) ^ (static_cast<uint64_t>(endpoint) << 16);
+        hash *= 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    // Returns the slot holding the endpoint, or the free slot where it would be added.
+    EndpointEntry & EndpointSlot(EndpointId endpoint)
+    {
+        return const_cast<EndpointEntry &>(static_cast<const AttributeStoreLookupTables *>(this)->EndpointSlot(endpoint));
+    }
+    const EndpointEntry & EndpointSlot(EndpointId endpoint) const
+    {
+        for (size_t slot = HashEndpoint(endpoint);; ++slot)
+        {
+            const EndpointEntry & entry = mEndpoints[slot & (kEndpointTableSize - 1)];
+            if (entry.endpoint == endpoint || entry.endpoint == kInvalidEndpointId)
+            {
+                return entry;
+            }
+        }
+    }
+
+    // Returns the slot holding the attribute, or the free slot where it would be added.
+    AttributeEntry & AttributeSlot(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+    {
+        return const_cast<AttributeEntry &>(
+            static_cast<const AttributeStoreLookupTables *>(this)->AttributeSlot(endpoint, clusterId, attributeId));
+    }
+    const AttributeEntry & AttributeSlot(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId) const
+    {
+        for (size_t slot = HashAttribute(endpoint, clusterId, attributeId);; ++slot)
+        {
+            const AttributeEntry & entry = mAttributes[slot & (kAttributeTableSize - 1)];
+            if (entry.metadata == nullptr ||
+                (entry.endpoint == endpoint && entry.clusterId == clusterId && entry.attributeId == attributeId))
+            {
+                return entry;
+            }
+        }
+    }
+
+    bool AddEndpointAttributes(const EmberAfDefinedEndpoint & definedEndpoint, uint16_t endpointIndex, uint16_t storageOffset);
+
+    EndpointEntry mEndpoints[kEndpointTableSize];
+    AttributeEntry mAttributes[kAttributeTableSize];
+    size_t mAttributeCount = 0;
+    State mState           = State::kStale;
+};
+
+template <size_t kEndpointTableSize, size_t kAttributeTableSize>
+void AttributeStoreLookupTables<kEndpointTableSize, kAttributeTableSize>::Build(Span<const EmberAfDefinedEndpoint> endpoints,
+                                                                                uint16_t fixedEndpointCount)
+{
+    for (auto & entry : mEndpoints)
+    {
+        entry = EndpointEntry();
+    }
+    for (auto & entry : mAttributes)
+    {
+        entry = AttributeEntry();
+    }
+    mAttributeCount = 0;
+
+    for (uint16_t ep = 0; ep < endpoints.size(); ep++)
+    {
+        const EndpointId endpoint = endpoints[ep].endpoint;
+        if (endpoint == kInvalidEndpointId)
+        {
+            continue;
+        }
+
+        EndpointEntry & entry = EndpointSlot(endpoint);
+        if (entry.endpoint == kInvalidEndpointId)
+        {
+            entry.endpoint = endpoint;
+            entry.index    = ep;
+        }
+        if (entry.enabledIndex == kInvalidIndex && endpoints[ep].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+        {
+            entry.enabledIndex = ep;
+        }
+    }
+
+    // Storage offsets follow emAfReadOrWriteAttribute: only fixed endpoints have storage, and the
+    // (disabled) endpoints with the same id that precede the matched endpoint are skipped.
+    mState                         = State::kValid;
+    uint16_t fixedEndpointsStorage = 0;
+    for (uint16_t ep = 0; ep < endpoints.size(); ep++)
+    {
+        const EndpointId endpoint = endpoints[ep].endpoint;
+        if (endpoint != kInvalidEndpointId && EndpointSlot(endpoint).enabledIndex == ep)
+        {
+            uint16_t storageOffset = fixedEndpointsStorage;
+            for (uint16_t i = 0; i < ep && i < fixedEndpointCount; i++)
+            {
+                if (endpoints[i].endpoint == endpoint)
+                {
+                    storageOffset = static_cast<uint16_t>(storageOffset - endpoints[i].endpointType->endpointSize);
+                }
+            }
+
+            if (!AddEndpointAttributes(endpoints[ep], ep, storageOffset))
+            {
+                ChipLogError(DataManagement, "Too many attributes for the attribute lookup table");
+                mState = State::kEndpointsOnly;
+                return;
+            }
+        }
+
+        if (ep < fixedEndpointCount)
+        {
+            fixedEndpointsStorage = static_cast<uint16_t>(fixedEndpointsStorage + endpoints[ep].endpointType->endpointSize);
+        }
+    }
+}
+
+// Adds the server attributes of the endpoint at the given index, whose attribute storage starts at storageOffset.
+template <size_t kEndpointTableSize, size_t kAttributeTableSize>
+bool AttributeStoreLookupTables<kEndpointTableSize, kAttributeTableSize>::AddEndpointAttributes(
+    const EmberAfDefinedEndpoint & definedEndpoint, uint16_t endpointIndex, uint16_t storageOffset)
+{
+    const EmberAfEndpointType * endpointType = definedEndpoint.endpointType;
+
+    for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+
+        // Only the first server cluster with a given id is ever matched.
+        bool isFirstServerCluster = (cluster->mask & CLUSTER_MASK_SERVER) != 0;
+        for (uint8_t i = 0; isFirstServerCluster && i < clusterIndex; i++)
+        {
+            isFirstServerCluster = !((endpointType->cluster[i].mask & CLUSTER_MASK_SERVER) &&
+                                     endpointType->cluster[i].clusterId == cluster->clusterId);
+        }
+
+        if (isFirstServerCluster)
+        {
+            uint16_t attributeOffset = storageOffset;
+            for (uint16_t attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+            {
+                const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                AttributeEntry & entry              = AttributeSlot(definedEndpoint.endpoint, cluster->clusterId, am->attributeId);
+                if (entry.metadata == nullptr)
+                {
+                    VerifyOrReturnValue(mAttributeCount < kMaxAttributeCount, false);
+                    entry.metadata      = am;
+                    entry.clusterId     = cluster->clusterId;
+                    entry.attributeId   = am->attributeId;
+                    entry.endpoint      = definedEndpoint.endpoint;
+                    entry.endpointIndex = endpointIndex;
+                    entry.storageOffset = attributeOffset;
+                    mAttributeCount++;
+                }
+
+                if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                {
+                    attributeOffset = static_cast<uint16_t>(attributeOffset + am->size);
+                }
+            }
+        }
+
+        storageOffset = static_cast<uint16_t>(storageOffset + cluster->clusterSize);
+    }
+
+    return true;
+}
+
+template <size_t kEndpointTableSize, size_t kAttributeTableSize>
+uint16_t AttributeStoreLookupTables<kEndpointTableSize, kAttributeTableSize>::FindEndpointIndex(EndpointId endpoint,
+                                                                                                bool ignoreDisabledEndpoints) const
+{
+    VerifyOrReturnValue(mState != State::kStale && endpoint != kInvalidEndpointId, kInvalidIndex);
+
+    const EndpointEntry & entry = EndpointSlot(endpoint);
+    VerifyOrReturnValue(entry.endpoint != kInvalidEndpointId, kInvalidIndex);
+    return ignoreDisabledEndpoints ? entry.enabledIndex : entry.index;
+}
+
+template <size_t kEndpointTableSize, size_t kAttributeTableSize>
+const typename AttributeStoreLookupTables<kEndpointTableSize, kAttributeTableSize>::AttributeEntry *
+AttributeStoreLookupTables<kEndpointTableSize, kAttributeTableSize>::FindAttribute(EndpointId endpoint, ClusterId clusterId,
+                                                                                   AttributeId attributeId) const
+{
+    VerifyOrReturnValue(mState == State::kValid, nullptr);
+
+    const AttributeEntry & entry = AttributeSlot(endpoint, clusterId, attributeId);
+    return (entry.metadata != nullptr) ? &entry : nullptr;
+}
+
+} // namespace app
+} // namespace chip
@@ -18,6 +18,7 @@
 #include <app/util/attribute-storage.h>
 
 #include <app/util/attribute-storage-detail.h>
+#include <app/util/attribute-storage-lookup.h>
 
 #include <app/AttributeAccessInterfaceCache.h>
 #include <app/AttributePersistenceProvider.h>
@@ -182,6 +183,87 @@ bool emberAfIsThisDataTypeAListType(EmberAfAttributeType dataType)
     return dataType == ZCL_ARRAY_ATTRIBUTE_TYPE;
 }
 
+#if CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+
+// Replace the scans over emAfEndpoints done by findIndexFromEndpoint and emAfReadOrWriteAttribute.
+// The tables are rebuilt on first use after InvalidateLookupTables(), which must be called whenever
+// the endpoint ids, endpoint types, endpoint count or enabled state of emAfEndpoints change. Lookups
+// that miss fall back to the scans, which also determine the exact error to return.
+
+constexpr size_t LookupTableSizeFor(size_t count)
+{
+    size_t size = 2;
+    while (size < 2 * count)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+// Number of server attributes of the fixed endpoints, counted as AttributeStoreLookupTables::AddEndpointAttributes does.
+constexpr size_t FixedEndpointAttributeCount()
+{
+    size_t count = 0;
+#if FIXED_ENDPOINT_COUNT > 0
+    constexpr uint8_t fixedEmberAfEndpointTypes[] = FIXED_ENDPOINT_TYPES;
+    for (uint8_t typeIndex : fixedEmberAfEndpointTypes)
+    {
+        const EmberAfEndpointType & endpointType = generatedEmberAfEndpointTypes[typeIndex];
+        for (uint8_t clusterIndex = 0; clusterIndex < endpointType.clusterCount; clusterIndex++)
+        {
+            if (endpointType.cluster[clusterIndex].mask & CLUSTER_MASK_SERVER)
+            {
+                count += endpointType.cluster[clusterIndex].attributeCount;
+            }
+        }
+    }
+#endif // FIXED_ENDPOINT_COUNT > 0
+    return count;
+}
+
+// The smallest power of two whose three quarters (the most attributes the table takes) hold count attributes.
+constexpr size_t AttributeLookupTableSizeFor(size_t count)
+{
+    size_t size = 2;
+    while (size - size / 4 < count)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+constexpr size_t kAttributeLookupTableSize = (CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE != 0)
+    ? CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE
+    : AttributeLookupTableSizeFor(FixedEndpointAttributeCount() +
+                                  (MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT) *
+                                      CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES);
+
+using LookupTables = AttributeStoreLookupTables<LookupTableSizeFor(MAX_ENDPOINT_COUNT), kAttributeLookupTableSize>;
+
+static_assert(LookupTables::kInvalidIndex == kEmberInvalidEndpointIndex, "Lookup misses must map to kEmberInvalidEndpointIndex");
+
+LookupTables lookupTables;
+
+void InvalidateLookupTables()
+{
+    lookupTables.Invalidate();
+}
+
+const LookupTables & GetLookupTables()
+{
+    if (lookupTables.IsStale())
+    {
+        lookupTables.Build(Span<const EmberAfDefinedEndpoint>(emAfEndpoints, emberAfEndpointCount()), emberAfFixedEndpointCount());
+    }
+    return lookupTables;
+}
+
+#else
+
+void InvalidateLookupTables() {}
+
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+
 uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     if (endpoint == kInvalidEndpointId)
@@ -189,6 +271,9 @@ uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints
         return kEmberInvalidEndpointIndex;
     }
 
+#if CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+    return GetLookupTables().FindEndpointIndex(endpoint, ignoreDisabledEndpoints);
+#else
     uint16_t epi;
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
@@ -199,6 +284,7 @@ uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints
         }
     }
     return kEmberInvalidEndpointIndex;
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
 }
 
 // Returns the index of a given endpoint.  Considers disabled endpoints.
@@ -272,11 +358,14 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    InvalidateLookupTables();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    InvalidateLookupTables();
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -335,6 +424,7 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
 
+    // Also invalidates the lookup tables.
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
     // Initialize the data versions.
@@ -366,6 +456,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        InvalidateLookupTables();
     }
 
     return ep;
@@ -597,6 +688,61 @@ bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMe
     return (am->attributeId == attRecord->attributeId);
 }
 
+// Reads or writes an attribute once its metadata and location have been found.
+static Status readOrWriteFoundAttribute(const EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata * am,
+                                        const EmberAfAttributeMetadata ** metadata, uint8_t * buffer, uint16_t readLength,
+                                        bool write, uint16_t attributeOffsetIndex, bool isDynamicEndpoint)
+{
+    // If passed metadata location is not null, populate
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
+
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return Status::Success;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return Status::UnsupportedAccess;
+        }
+    }
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (!isDynamicEndpoint)
+    {
+        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+    }
+
+    return Status::Failure;
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -615,6 +761,15 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
+#if CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+    const auto * entry = GetLookupTables().FindAttribute(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId);
+    if (entry != nullptr)
+    {
+        return readOrWriteFoundAttribute(attRecord, entry->metadata, metadata, buffer, readLength, write, entry->storageOffset,
+                                         entry->endpointIndex >= emberAfFixedEndpointCount());
+    }
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+
     uint16_t attributeOffsetIndex = 0;
 
     for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
@@ -641,60 +796,8 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
                         const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
                         if (emAfMatchAttribute(cluster, am, attRecord))
                         { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
-                            }
+                            return readOrWriteFoundAttribute(attRecord, am, metadata, buffer, readLength, write,
+                                                             attributeOffsetIndex, isDynamicEndpoint);
                         }
                         else
                         { // Not the attribute we are looking for
@@ -953,6 +1056,7 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
     if (enable)
     {
         emAfEndpoints[index].bitmask.Set(EmberAfEndpointOptions::isEnabled);
+        InvalidateLookupTables();
     }
 
     if (currentlyEnabled != enable)
@@ -966,6 +1070,7 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
         {
             shutdownEndpoint(&(emAfEndpoints[index]));
             emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
+            InvalidateLookupTables();
         }
 
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
@@ -70,3 +70,12 @@ const EmberAfCluster * emberAfFindServerCluster(chip::EndpointId endpoint, chip:
  * and that cluster has the given attribute.
  */
 bool emberAfContainsAttribute(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+/**
+ * Returns the index of the given attribute in the attribute metadata of the given
+ * server cluster on the given endpoint.
+ *
+ * Returns UINT16_MAX if the attribute does not exist.
+ */
+uint16_t emberAfGetServerAttributeIndexByAttributeId(chip::EndpointId endpoint, chip::ClusterId cluster,
+                                                     chip::AttributeId attributeId);
@@ -832,11 +832,19 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    mGroupSessionCacheUsers = 0;
+    if (mSessionKeystore != nullptr)
+    {
+        ClearGroupSessionCache();
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
+    InvalidateGroupSessionCache();
     mStorage = storage;
 }
 
@@ -1349,6 +1357,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1424,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1457,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1534,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1606,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1708,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionCache();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1806,32 +1821,32 @@ void GroupDataProviderImpl::GroupKeyContext::Release()
     mProvider.mGroupKeyContexPool.ReleaseObject(this);
 }
 
-CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad,
-                                                                  const ByteSpan & nonce, MutableByteSpan & mic,
-                                                                  MutableByteSpan & ciphertext) const
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContextBase::MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad,
+                                                                      const ByteSpan & nonce, MutableByteSpan & mic,
+                                                                      MutableByteSpan & ciphertext) const
 {
     uint8_t * output = ciphertext.data();
     return Crypto::AES_CCM_encrypt(plaintext.data(), plaintext.size(), aad.data(), aad.size(), mEncryptionKey, nonce.data(),
                                    nonce.size(), output, mic.data(), mic.size());
 }
 
-CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad,
-                                                                  const ByteSpan & nonce, const ByteSpan & mic,
-                                                                  MutableByteSpan & plaintext) const
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContextBase::MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad,
+                                                                      const ByteSpan & nonce, const ByteSpan & mic,
+                                                                      MutableByteSpan & plaintext) const
 {
     uint8_t * output = plaintext.data();
     return Crypto::AES_CCM_decrypt(ciphertext.data(), ciphertext.size(), aad.data(), aad.size(), mic.data(), mic.size(),
                                    mEncryptionKey, nonce.data(), nonce.size(), output);
 }
 
-CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce,
-                                                                  MutableByteSpan & output) const
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContextBase::PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce,
+                                                                      MutableByteSpan & output) const
 {
     return Crypto::AES_CTR_crypt(input.data(), input.size(), mPrivacyKey, nonce.data(), nonce.size(), output.data());
 }
 
-CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce,
-                                                                  MutableByteSpan & output) const
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContextBase::PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce,
+                                                                      MutableByteSpan & output) const
 {
     return Crypto::AES_CTR_crypt(input.data(), input.size(), mPrivacyKey, nonce.data(), nonce.size(), output.data());
 }
@@ -1842,9 +1857,136 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+void GroupDataProviderImpl::InvalidateGroupSessionCache()
+{
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mGroupSessionCacheState == GroupSessionCacheState::kInvalid)
+    {
+        return;
+    }
+
+    mGroupSessionCacheStats.invalidations++;
+    if (mGroupSessionCacheUsers > 0)
+    {
+        // Iterators still point at the entries; they are cleared once the last one is released.
+        mGroupSessionCacheState = GroupSessionCacheState::kStale;
+        return;
+    }
+    ClearGroupSessionCache();
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
+void GroupDataProviderImpl::SetGroupSessionCacheEnabled(bool enabled)
+{
+    InvalidateGroupSessionCache();
+    mGroupSessionCacheEnabled = enabled;
+}
+
+bool GroupDataProviderImpl::UseGroupSessionCache()
+{
+    VerifyOrReturnValue(mGroupSessionCacheEnabled && mSessionKeystore != nullptr, false);
+
+    if (mGroupSessionCacheState == GroupSessionCacheState::kInvalid)
+    {
+        LoadGroupSessionCache();
+    }
+    return (mGroupSessionCacheState == GroupSessionCacheState::kValid);
+}
+
+void GroupDataProviderImpl::LoadGroupSessionCache()
+{
+    // Collect the candidates in the order GroupSessionIteratorImpl walks storage, stopping at the same
+    // point it would if a record failed to load.
+    Crypto::SessionKeystore & keystore = *mSessionKeystore;
+    FabricList fabric_list;
+    mGroupSessionCacheStats.loads++;
+    mGroupSessionCacheState = GroupSessionCacheState::kValid;
+
+    VerifyOrReturn(CHIP_NO_ERROR == fabric_list.Load(mStorage));
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        VerifyOrReturn(CHIP_NO_ERROR == fabric.Load(mStorage));
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            VerifyOrReturn(CHIP_NO_ERROR == mapping.Load(mStorage));
+
+            KeySetData keyset;
+            VerifyOrReturn(keyset.Find(mStorage, fabric, mapping.keyset_id));
+
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                if (mGroupSessionCacheCount >= kGroupSessionCacheSize)
+                {
+                    ClearGroupSessionCache();
+                    mGroupSessionCacheState = GroupSessionCacheState::kOverflow;
+                    return;
+                }
+
+                GroupSessionCacheEntry & entry = mGroupSessionCache[mGroupSessionCacheCount];
+                entry.Load(keystore, keyset.operational_keys[k]);
+                entry.fabric_index    = fabric.fabric_index;
+                entry.group_id        = mapping.group_id;
+                entry.security_policy = keyset.policy;
+
+                // Insertion sort keeps equal session IDs in storage order, the order the storage walk returns them in.
+                uint16_t pos = mGroupSessionCacheCount;
+                while (pos > 0 && mGroupSessionCache[mGroupSessionCacheOrder[pos - 1]].GetKeyHash() > entry.GetKeyHash())
+                {
+                    mGroupSessionCacheOrder[pos] = mGroupSessionCacheOrder[pos - 1];
+                    pos--;
+                }
+                mGroupSessionCacheOrder[pos] = mGroupSessionCacheCount++;
+            }
+        }
+    }
+}
+
+void GroupDataProviderImpl::ClearGroupSessionCache()
+{
+    for (uint16_t i = 0; i < mGroupSessionCacheCount; i++)
+    {
+        mGroupSessionCache[i].Clear(*mSessionKeystore);
+    }
+    mGroupSessionCacheCount = 0;
+    mGroupSessionCacheState = GroupSessionCacheState::kInvalid;
+}
+
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (provider.UseGroupSessionCache())
+    {
+        // Candidates for one session ID are contiguous in the sorted order
+        const uint16_t * order = provider.mGroupSessionCacheOrder;
+        uint16_t count         = provider.mGroupSessionCacheCount;
+        uint16_t begin         = 0;
+        while (begin < count && provider.mGroupSessionCache[order[begin]].GetKeyHash() < session_id)
+        {
+            begin++;
+        }
+        uint16_t end = begin;
+        while (end < count && provider.mGroupSessionCache[order[end]].GetKeyHash() == session_id)
+        {
+            end++;
+        }
+        mCached     = true;
+        mCacheIndex = begin;
+        mCacheEnd   = end;
+        provider.mGroupSessionCacheUsers++;
+        provider.mGroupSessionCacheStats.hits++;
+        return;
+    }
+    provider.mGroupSessionCacheStats.fallbacks++;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,6 +1999,13 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mCached)
+    {
+        return static_cast<size_t>(mCacheEnd - mCacheIndex);
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
@@ -1898,6 +2047,19 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mCached)
+    {
+        VerifyOrReturnError(mCacheIndex < mCacheEnd, false);
+        GroupSessionCacheEntry & entry = mProvider.mGroupSessionCache[mProvider.mGroupSessionCacheOrder[mCacheIndex++]];
+        output.fabric_index            = entry.fabric_index;
+        output.group_id                = entry.group_id;
+        output.security_policy         = entry.security_policy;
+        output.keyContext              = &entry;
+        return true;
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -1952,6 +2114,13 @@ bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output
 
 void GroupDataProviderImpl::GroupSessionIteratorImpl::Release()
 {
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    if (mCached && --mProvider.mGroupSessionCacheUsers == 0 &&
+        mProvider.mGroupSessionCacheState == GroupSessionCacheState::kStale)
+    {
+        mProvider.ClearGroupSessionCache();
+    }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
     mGroupKeyContext.ReleaseKeys();
     mProvider.mGroupSessionsIterator.ReleaseObject(this);
 }
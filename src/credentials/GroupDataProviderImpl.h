@@ -28,6 +28,17 @@ class GroupDataProviderImpl : public GroupDataProvider
 {
 public:
     static constexpr size_t kIteratorsMax = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    static constexpr size_t kGroupSessionCacheSize = CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE;
+
+    struct GroupSessionCacheStats
+    {
+        uint32_t hits          = 0; ///< IterateGroupSessions() calls served from the cache
+        uint32_t fallbacks     = 0; ///< IterateGroupSessions() calls that had to walk storage
+        uint32_t loads         = 0; ///< Times the cache was rebuilt from storage
+        uint32_t invalidations = 0; ///< Key set or group-key map changes that dropped the cache
+    };
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
 
     GroupDataProviderImpl() = default;
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
@@ -43,7 +54,11 @@ public:
      */
     void SetStorageDelegate(PersistentStorageDelegate * storage);
 
-    void SetSessionKeystore(Crypto::SessionKeystore * keystore) { mSessionKeystore = keystore; }
+    void SetSessionKeystore(Crypto::SessionKeystore * keystore)
+    {
+        InvalidateGroupSessionCache();
+        mSessionKeystore = keystore;
+    }
     Crypto::SessionKeystore * GetSessionKeystore() const { return mSessionKeystore; }
 
     CHIP_ERROR Init() override;
@@ -97,6 +112,15 @@ public:
     Crypto::SymmetricKeyContext * GetKeyContext(FabricIndex fabric_index, GroupId group_id) override;
     GroupSessionIterator * IterateGroupSessions(uint16_t session_id) override;
 
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    /**
+     * @brief Turns the group session cache on or off. When off, IterateGroupSessions() walks the fabric,
+     *        group-key map and key set records in storage on every call, as it does when the cache overflows.
+     */
+    void SetGroupSessionCacheEnabled(bool enabled);
+    const GroupSessionCacheStats & GetGroupSessionCacheStats() const { return mGroupSessionCacheStats; }
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
 protected:
     class GroupInfoIteratorImpl : public GroupInfoIterator
     {
@@ -151,60 +175,92 @@ protected:
         bool mFirstEndpoint   = true;
     };
 
-    class GroupKeyContext : public Crypto::SymmetricKeyContext
+    // Key handles and AES operations shared by the key contexts handed out for group messages.
+    class GroupKeyContextBase : public Crypto::SymmetricKeyContext
     {
     public:
-        GroupKeyContext(GroupDataProviderImpl & provider) : mProvider(provider) {}
-
-        GroupKeyContext(GroupDataProviderImpl & provider, const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
-                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey) :
-            mProvider(provider)
+        uint16_t GetKeyHash() override { return mKeyHash; }
 
-        {
-            Initialize(encryptionKey, hash, privacyKey);
-        }
+        CHIP_ERROR MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad, const ByteSpan & nonce, MutableByteSpan & mic,
+                                  MutableByteSpan & ciphertext) const override;
+        CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce, const ByteSpan & mic,
+                                  MutableByteSpan & plaintext) const override;
+        CHIP_ERROR PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
+        CHIP_ERROR PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
 
-        void Initialize(const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
-                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey)
+    protected:
+        void CreateKeys(Crypto::SessionKeystore & keystore, const Crypto::Symmetric128BitsKeyByteArray & encryptionKey,
+                        uint16_t hash, const Crypto::Symmetric128BitsKeyByteArray & privacyKey)
         {
-            ReleaseKeys();
             mKeyHash = hash;
             // TODO: Load group keys to the session keystore upon loading from persistent storage
             //
             // Group keys should be transformed into a key handle as soon as possible or even
             // the key storage should be taken over by SessionKeystore interface, but this looks
             // like more work, so let's use the transitional code below for now.
+            keystore.CreateKey(encryptionKey, mEncryptionKey);
+            keystore.CreateKey(privacyKey, mPrivacyKey);
+        }
 
-            Crypto::SessionKeystore * keystore = mProvider.GetSessionKeystore();
-            keystore->CreateKey(encryptionKey, mEncryptionKey);
-            keystore->CreateKey(privacyKey, mPrivacyKey);
+        void DestroyKeys(Crypto::SessionKeystore & keystore)
+        {
+            keystore.DestroyKey(mEncryptionKey);
+            keystore.DestroyKey(mPrivacyKey);
         }
 
-        void ReleaseKeys()
+        uint16_t mKeyHash = 0;
+        Crypto::Aes128KeyHandle mEncryptionKey;
+        Crypto::Aes128KeyHandle mPrivacyKey;
+    };
+
+    class GroupKeyContext : public GroupKeyContextBase
+    {
+    public:
+        GroupKeyContext(GroupDataProviderImpl & provider) : mProvider(provider) {}
+
+        GroupKeyContext(GroupDataProviderImpl & provider, const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
+                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey) :
+            mProvider(provider)
+
         {
-            Crypto::SessionKeystore * keystore = mProvider.GetSessionKeystore();
-            keystore->DestroyKey(mEncryptionKey);
-            keystore->DestroyKey(mPrivacyKey);
+            Initialize(encryptionKey, hash, privacyKey);
         }
 
-        uint16_t GetKeyHash() override { return mKeyHash; }
+        void Initialize(const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
+                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey)
+        {
+            ReleaseKeys();
+            CreateKeys(*mProvider.GetSessionKeystore(), encryptionKey, hash, privacyKey);
+        }
 
-        CHIP_ERROR MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad, const ByteSpan & nonce, MutableByteSpan & mic,
-                                  MutableByteSpan & ciphertext) const override;
-        CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce, const ByteSpan & mic,
-                                  MutableByteSpan & plaintext) const override;
-        CHIP_ERROR PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
-        CHIP_ERROR PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
+        void ReleaseKeys() { DestroyKeys(*mProvider.GetSessionKeystore()); }
 
         void Release() override;
 
     protected:
         GroupDataProviderImpl & mProvider;
-        uint16_t mKeyHash = 0;
-        Crypto::Aes128KeyHandle mEncryptionKey;
-        Crypto::Aes128KeyHandle mPrivacyKey;
     };
 
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    // Group session candidate kept by the group session cache, with its key handles already created. It is owned by
+    // the cache, so Release() does nothing; the keys are destroyed when the cache is cleared.
+    class GroupSessionCacheEntry : public GroupKeyContextBase
+    {
+    public:
+        void Load(Crypto::SessionKeystore & keystore, const Crypto::GroupOperationalCredentials & creds)
+        {
+            CreateKeys(keystore, creds.encryption_key, creds.hash, creds.privacy_key);
+        }
+        void Clear(Crypto::SessionKeystore & keystore) { DestroyKeys(keystore); }
+
+        void Release() override {}
+
+        FabricIndex fabric_index       = kUndefinedFabricIndex;
+        GroupId group_id               = kUndefinedGroupId;
+        SecurityPolicy security_policy = SecurityPolicy::kTrustFirst;
+    };
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     class KeySetIteratorImpl : public KeySetIterator
     {
     public:
@@ -242,10 +298,32 @@ protected:
         uint16_t mKeyCount       = 0;
         bool mFirstMap           = true;
         GroupKeyContext mGroupKeyContext;
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+        // Set when the candidates are served from the group session cache: mGroupSessionCacheOrder[mCacheIndex, mCacheEnd).
+        bool mCached         = false;
+        uint16_t mCacheIndex = 0;
+        uint16_t mCacheEnd   = 0;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
     };
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    // Called before any change to the key sets or group-key maps that IterateGroupSessions() walks.
+    void InvalidateGroupSessionCache();
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    enum class GroupSessionCacheState : uint8_t
+    {
+        kInvalid,  // Must be loaded from storage before use
+        kValid,    // Holds every group session candidate, sorted by session ID
+        kOverflow, // Too many candidates; lookups walk storage until the next invalidation
+        kStale,    // Invalidated while iterators still hold entries; cleared once they are released
+    };
+
+    bool UseGroupSessionCache();
+    void LoadGroupSessionCache();
+    void ClearGroupSessionCache();
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +332,16 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+    GroupSessionCacheEntry mGroupSessionCache[kGroupSessionCacheSize];
+    // Indexes into mGroupSessionCache sorted by session ID, keeping storage order between equal IDs.
+    uint16_t mGroupSessionCacheOrder[kGroupSessionCacheSize];
+    uint16_t mGroupSessionCacheCount               = 0;
+    uint16_t mGroupSessionCacheUsers               = 0;
+    GroupSessionCacheState mGroupSessionCacheState = GroupSessionCacheState::kInvalid;
+    bool mGroupSessionCacheEnabled                 = true;
+    GroupSessionCacheStats mGroupSessionCacheStats;
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
 };
 
 } // namespace Credentials
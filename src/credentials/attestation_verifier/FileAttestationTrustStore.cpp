@@ -17,12 +17,19 @@
 #include "FileAttestationTrustStore.h"
 
 #include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <string>
 
 extern "C" {
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 }
 
 namespace chip {
@@ -38,21 +45,130 @@ const char * GetFilenameExtension(const char * filename)
     }
     return dot + 1;
 }
+
+bool IsValidCertificate(const ByteSpan & certSpan, CertificateValidationMode validationMode)
+{
+    switch (validationMode)
+    {
+    case CertificateValidationMode::kPAA: {
+        if (CHIP_NO_ERROR != VerifyAttestationCertificateFormat(certSpan, Crypto::AttestationCertType::kPAA))
+        {
+            return false;
+        }
+
+        uint8_t kidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
+        MutableByteSpan kidSpan{ kidBuf };
+        return CHIP_NO_ERROR == Crypto::ExtractSKIDFromX509Cert(certSpan, kidSpan);
+    }
+    case CertificateValidationMode::kPublicKeyOnly: {
+        Crypto::P256PublicKey publicKey;
+        return CHIP_NO_ERROR == Crypto::ExtractPubkeyFromX509Cert(certSpan, publicKey);
+    }
+    }
+    return false;
+}
+
+// Returns the length of the DER SEQUENCE (such as an X.509 certificate) at the start of the buffer, or 0 if there is
+// none or it does not fit in the buffer.
+size_t GetDerSequenceLength(const uint8_t * data, size_t size)
+{
+    VerifyOrReturnValue(size >= 2 && data[0] == 0x30, 0);
+
+    size_t headerLength = 2;
+    size_t length       = data[1];
+    if (length & 0x80)
+    {
+        // Long form. Certificates are at most kMaxDERCertLength long, so two length bytes are enough.
+        size_t lengthBytes = length & 0x7F;
+        VerifyOrReturnValue(lengthBytes >= 1 && lengthBytes <= 2 && size >= headerLength + lengthBytes, 0);
+        length = 0;
+        for (size_t i = 0; i < lengthBytes; i++)
+        {
+            length = (length << 8) | data[headerLength + i];
+        }
+        headerLength += lengthBytes;
+    }
+    VerifyOrReturnValue(length <= size - headerLength, 0);
+    return headerLength + length;
+}
 } // namespace
 
 FileAttestationTrustStore::FileAttestationTrustStore(const char * paaTrustStorePath)
 {
     VerifyOrReturn(paaTrustStorePath != nullptr);
 
-    if (paaTrustStorePath != nullptr)
+    struct stat pathStat;
+    if (stat(paaTrustStorePath, &pathStat) == 0 && S_ISREG(pathStat.st_mode))
+    {
+        LoadBundle(paaTrustStorePath);
+    }
+    else
     {
         mPAADerCerts = LoadAllX509DerCerts(paaTrustStorePath);
-        VerifyOrReturn(paaCount());
+        for (const auto & certificate : mPAADerCerts)
+        {
+            AddToIndex(ByteSpan{ certificate.data(), certificate.size() });
+        }
     }
 
+    std::stable_sort(mPAAIndex.begin(), mPAAIndex.end(),
+                     [](const PAAIndexEntry & a, const PAAIndexEntry & b) { return a.skid < b.skid; });
+    VerifyOrReturn(paaCount());
+
     mIsInitialized = true;
 }
 
+void FileAttestationTrustStore::LoadBundle(const char * bundlePath)
+{
+    int fd = open(bundlePath, O_RDONLY);
+    VerifyOrReturn(fd >= 0);
+
+    struct stat bundleStat;
+    if (fstat(fd, &bundleStat) == 0 && bundleStat.st_size > 0)
+    {
+        size_t size   = static_cast<size_t>(bundleStat.st_size);
+        void * bundle = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (bundle != MAP_FAILED)
+        {
+            mBundle     = static_cast<const uint8_t *>(bundle);
+            mBundleSize = size;
+        }
+    }
+    close(fd);
+    VerifyOrReturn(mBundle != nullptr);
+
+    size_t offset = 0;
+    while (offset < mBundleSize)
+    {
+        size_t certificateLength = GetDerSequenceLength(mBundle + offset, mBundleSize - offset);
+        if (certificateLength == 0)
+        {
+            // Without a valid length, the start of the next certificate is unknown.
+            ChipLogError(Crypto, "PAA bundle %s is malformed at offset %u, ignoring the rest", bundlePath,
+                         static_cast<unsigned>(offset));
+            break;
+        }
+
+        ByteSpan certSpan{ mBundle + offset, certificateLength };
+        if (certificateLength <= kMaxDERCertLength && IsValidCertificate(certSpan, CertificateValidationMode::kPAA))
+        {
+            AddToIndex(certSpan);
+        }
+        offset += certificateLength;
+    }
+}
+
+void FileAttestationTrustStore::AddToIndex(const ByteSpan & derCert)
+{
+    PAAIndexEntry entry;
+    MutableByteSpan skidSpan{ entry.skid };
+    if (CHIP_NO_ERROR == Crypto::ExtractSKIDFromX509Cert(derCert, skidSpan) && skidSpan.size() == entry.skid.size())
+    {
+        entry.derCert = derCert;
+        mPAAIndex.push_back(entry);
+    }
+}
+
 std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePath, CertificateValidationMode validationMode)
 {
     std::vector<std::vector<uint8_t>> certs;
@@ -92,34 +208,7 @@ std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePat
                     ByteSpan certSpan{ certificate.data(), certificate.size() };
 
                     // Only accumulate certificate if it passes validation.
-                    bool isValid = false;
-                    switch (validationMode)
-                    {
-                    case CertificateValidationMode::kPAA: {
-                        if (CHIP_NO_ERROR != VerifyAttestationCertificateFormat(certSpan, Crypto::AttestationCertType::kPAA))
-                        {
-                            break;
-                        }
-
-                        uint8_t kidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
-                        MutableByteSpan kidSpan{ kidBuf };
-                        if (CHIP_NO_ERROR == Crypto::ExtractSKIDFromX509Cert(certSpan, kidSpan))
-                        {
-                            isValid = true;
-                        }
-                        break;
-                    }
-                    case CertificateValidationMode::kPublicKeyOnly: {
-                        Crypto::P256PublicKey publicKey;
-                        if (CHIP_NO_ERROR == Crypto::ExtractPubkeyFromX509Cert(certSpan, publicKey))
-                        {
-                            isValid = true;
-                        }
-                        break;
-                    }
-                    }
-
-                    if (isValid)
+                    if (IsValidCertificate(certSpan, validationMode))
                     {
                         certs.push_back(certificate);
                     }
@@ -140,7 +229,14 @@ FileAttestationTrustStore::~FileAttestationTrustStore()
 
 void FileAttestationTrustStore::Cleanup()
 {
+    mPAAIndex.clear();
     mPAADerCerts.clear();
+    if (mBundle != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(mBundle), mBundleSize);
+        mBundle     = nullptr;
+        mBundleSize = 0;
+    }
     mIsInitialized = false;
 }
 
@@ -154,27 +250,18 @@ CHIP_ERROR FileAttestationTrustStore::GetProductAttestationAuthorityCert(const B
         return CHIP_ERROR_NOT_IMPLEMENTED;
     }
 
-    VerifyOrReturnError(!mPAADerCerts.empty(), CHIP_ERROR_CA_CERT_NOT_FOUND);
+    VerifyOrReturnError(!mPAAIndex.empty(), CHIP_ERROR_CA_CERT_NOT_FOUND);
     VerifyOrReturnError(!skid.empty() && (skid.data() != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
 
-    for (auto candidate : mPAADerCerts)
-    {
-        uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
-        MutableByteSpan candidateSkidSpan{ skidBuf };
-        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{ candidate.data(), candidate.size() }, candidateSkidSpan))
-        {
-            continue;
-        }
-
-        if (skid.data_equal(candidateSkidSpan))
-        {
-            // Found a match
-            return CopySpanToMutableSpan(ByteSpan{ candidate.data(), candidate.size() }, outPaaDerBuffer);
-        }
-    }
+    auto isBefore = [](const PAAIndexEntry & entry, const ByteSpan & key) {
+        return memcmp(entry.skid.data(), key.data(), entry.skid.size()) < 0;
+    };
+    auto candidate = std::lower_bound(mPAAIndex.begin(), mPAAIndex.end(), skid, isBefore);
+    VerifyOrReturnError(candidate != mPAAIndex.end() && skid.data_equal(ByteSpan{ candidate->skid }), CHIP_ERROR_CA_CERT_NOT_FOUND);
 
-    return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    // Found a match
+    return CopySpanToMutableSpan(candidate->derCert, outPaaDerBuffer);
 }
 
 } // namespace Credentials
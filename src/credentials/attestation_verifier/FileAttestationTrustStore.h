@@ -18,6 +18,7 @@
 
 #include <credentials/CHIPCert.h>
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
+#include <crypto/CHIPCryptoPAL.h>
 
 #include <array>
 #include <vector>
@@ -49,23 +50,49 @@ enum class CertificateValidationMode
 std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePath,
                                                       CertificateValidationMode validationMode = CertificateValidationMode::kPAA);
 
+/**
+ * @brief Attestation trust store loading PAA certificates from the file system.
+ *
+ * The PAA certificates are either the X.509 DER files of a directory, as loaded by LoadAllX509DerCerts, or the
+ * X.509 DER certificates concatenated in a single bundle file (e.g. `cat *.der > paa.bundle`), which is memory-mapped
+ * rather than read. Certificates failing PAA validation are ignored in both cases.
+ *
+ * The certificates are indexed by subject key identifier when loaded, so that lookups do not parse them again.
+ */
 class FileAttestationTrustStore : public AttestationTrustStore
 {
 public:
     FileAttestationTrustStore(const char * paaTrustStorePath = nullptr);
     ~FileAttestationTrustStore();
 
+    FileAttestationTrustStore(const FileAttestationTrustStore &)             = delete;
+    FileAttestationTrustStore & operator=(const FileAttestationTrustStore &) = delete;
+
     CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan & skid, MutableByteSpan & outPaaDerBuffer) const override;
 
     bool IsInitialized() const { return mIsInitialized; }
-    size_t paaCount() const { return mPAADerCerts.size(); };
+    size_t paaCount() const { return mPAAIndex.size(); };
 
 protected:
     std::vector<std::vector<uint8_t>> mPAADerCerts;
 
 private:
+    struct PAAIndexEntry
+    {
+        std::array<uint8_t, Crypto::kSubjectKeyIdentifierLength> skid;
+        ByteSpan derCert; // Points into mPAADerCerts or mBundle.
+    };
+
     bool mIsInitialized = false;
 
+    // Sorted by SKID, certificates with the same SKID being kept in load order.
+    std::vector<PAAIndexEntry> mPAAIndex;
+
+    const uint8_t * mBundle = nullptr;
+    size_t mBundleSize      = 0;
+
+    void LoadBundle(const char * bundlePath);
+    void AddToIndex(const ByteSpan & derCert);
     void Cleanup();
 };
 
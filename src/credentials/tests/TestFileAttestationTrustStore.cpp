@@ -0,0 +1,274 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <crypto/CHIPCryptoPAL.h>
+
+#include <credentials/CHIPCert.h>
+#include <credentials/attestation_verifier/FileAttestationTrustStore.h>
+#include <credentials/attestation_verifier/TestPAAStore.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Crypto;
+using namespace chip::Credentials;
+
+namespace {
+
+constexpr size_t kBenchmarkPAACount = 2000;
+
+bool WriteFile(const std::string & path, const std::vector<ByteSpan> & contents)
+{
+    FILE * file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool written = true;
+    for (const auto & content : contents)
+    {
+        written = written && fwrite(content.data(), 1, content.size(), file) == content.size();
+    }
+    fclose(file);
+    return written;
+}
+
+std::vector<uint8_t> GetSKID(const ByteSpan & derCert)
+{
+    std::vector<uint8_t> skid(kSubjectKeyIdentifierLength);
+    MutableByteSpan skidSpan(skid.data(), skid.size());
+    if (ExtractSKIDFromX509Cert(derCert, skidSpan) != CHIP_NO_ERROR)
+    {
+        skid.clear();
+    }
+    return skid;
+}
+
+// Copies of the FFF1 test PAA whose SKID (and matching AKID) is replaced with a distinct value for each copy. The
+// signature no longer matches, which the trust store does not check.
+std::vector<std::vector<uint8_t>> MakeDistinctPAAs(size_t count)
+{
+    const ByteSpan paa                  = TestCerts::sTestCert_PAA_FFF1_Cert;
+    const std::vector<uint8_t> original = GetSKID(paa);
+
+    std::vector<std::vector<uint8_t>> certs;
+    for (size_t i = 0; i < count && !original.empty(); i++)
+    {
+        std::vector<uint8_t> cert(paa.data(), paa.data() + paa.size());
+        std::vector<uint8_t> skid(original);
+        skid[0] = static_cast<uint8_t>(i >> 8);
+        skid[1] = static_cast<uint8_t>(i);
+
+        auto it = std::search(cert.begin(), cert.end(), original.begin(), original.end());
+        while (it != cert.end())
+        {
+            it = std::copy(skid.begin(), skid.end(), it);
+            it = std::search(it, cert.end(), original.begin(), original.end());
+        }
+        certs.push_back(cert);
+    }
+    return certs;
+}
+
+uint64_t NowUs()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+void TestDirectoryAndBundle(nlTestSuite * inSuite, void * inContext)
+{
+    char dirTemplate[] = "/tmp/paa-store-XXXXXX";
+    const char * dir   = mkdtemp(dirTemplate);
+    NL_TEST_ASSERT(inSuite, dir != nullptr);
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    const std::string storeDir(dir);
+    const std::string bundlePath     = storeDir + "/paa.bundle";
+    const uint8_t kTrailingGarbage[] = { 0x30, 0x82, 0x7F };
+
+    // The bundle path does not end in .der, so the directory store does not load it.
+    NL_TEST_ASSERT(inSuite, WriteFile(storeDir + "/fff1.der", { TestCerts::sTestCert_PAA_FFF1_Cert }));
+    NL_TEST_ASSERT(inSuite, WriteFile(storeDir + "/novid.der", { TestCerts::sTestCert_PAA_NoVID_Cert }));
+    NL_TEST_ASSERT(inSuite,
+                   WriteFile(bundlePath,
+                             { TestCerts::sTestCert_PAA_FFF1_Cert, TestCerts::sTestCert_PAA_NoVID_Cert,
+                               ByteSpan(kTrailingGarbage) }));
+
+    const std::vector<uint8_t> fff1Skid  = GetSKID(TestCerts::sTestCert_PAA_FFF1_Cert);
+    const std::vector<uint8_t> novidSkid = GetSKID(TestCerts::sTestCert_PAA_NoVID_Cert);
+    NL_TEST_ASSERT(inSuite, !fff1Skid.empty() && !novidSkid.empty());
+
+    for (const std::string & path : { storeDir, bundlePath })
+    {
+        FileAttestationTrustStore store(path.c_str());
+        NL_TEST_ASSERT(inSuite, store.IsInitialized());
+        NL_TEST_ASSERT(inSuite, store.paaCount() == 2);
+
+        uint8_t buffer[kMaxDERCertLength];
+        MutableByteSpan paa(buffer);
+        NL_TEST_ASSERT(inSuite,
+                       store.GetProductAttestationAuthorityCert(ByteSpan(fff1Skid.data(), fff1Skid.size()), paa) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, paa.data_equal(TestCerts::sTestCert_PAA_FFF1_Cert));
+
+        paa = MutableByteSpan(buffer);
+        NL_TEST_ASSERT(inSuite,
+                       store.GetProductAttestationAuthorityCert(ByteSpan(novidSkid.data(), novidSkid.size()), paa) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, paa.data_equal(TestCerts::sTestCert_PAA_NoVID_Cert));
+
+        std::vector<uint8_t> unknownSkid(fff1Skid);
+        unknownSkid.back() = static_cast<uint8_t>(unknownSkid.back() ^ 0xFF);
+        paa                = MutableByteSpan(buffer);
+        NL_TEST_ASSERT(inSuite,
+                       store.GetProductAttestationAuthorityCert(ByteSpan(unknownSkid.data(), unknownSkid.size()), paa) ==
+                           CHIP_ERROR_CA_CERT_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite,
+                       store.GetProductAttestationAuthorityCert(ByteSpan(fff1Skid.data(), fff1Skid.size() - 1), paa) ==
+                           CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    unlink((storeDir + "/fff1.der").c_str());
+    unlink((storeDir + "/novid.der").c_str());
+    unlink(bundlePath.c_str());
+    rmdir(storeDir.c_str());
+}
+
+void TestLookupBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    char bundleTemplate[] = "/tmp/paa-bundle-XXXXXX";
+    int fd                = mkstemp(bundleTemplate);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    if (fd < 0)
+    {
+        return;
+    }
+    close(fd);
+
+    const std::vector<std::vector<uint8_t>> certs = MakeDistinctPAAs(kBenchmarkPAACount);
+    NL_TEST_ASSERT(inSuite, certs.size() == kBenchmarkPAACount);
+
+    std::vector<ByteSpan> certSpans;
+    std::vector<std::vector<uint8_t>> skids;
+    for (const auto & cert : certs)
+    {
+        certSpans.push_back(ByteSpan(cert.data(), cert.size()));
+        skids.push_back(GetSKID(certSpans.back()));
+    }
+    NL_TEST_ASSERT(inSuite, WriteFile(bundleTemplate, certSpans));
+
+    uint64_t startUs = NowUs();
+    FileAttestationTrustStore store(bundleTemplate);
+    const uint64_t loadUs = NowUs() - startUs;
+    NL_TEST_ASSERT(inSuite, store.paaCount() == kBenchmarkPAACount);
+
+    // Look every PAA up, in an order unrelated to the load order.
+    uint8_t buffer[kMaxDERCertLength];
+    size_t found = 0;
+    startUs      = NowUs();
+    for (size_t i = 0; i < kBenchmarkPAACount; i++)
+    {
+        const auto & skid = skids[(i * 7919) % kBenchmarkPAACount];
+        MutableByteSpan paa(buffer);
+        if (store.GetProductAttestationAuthorityCert(ByteSpan(skid.data(), skid.size()), paa) == CHIP_NO_ERROR)
+        {
+            found++;
+        }
+    }
+    const uint64_t lookupUs = NowUs() - startUs;
+    NL_TEST_ASSERT(inSuite, found == kBenchmarkPAACount);
+
+    // For comparison, what a lookup of the last PAA costs when every candidate is parsed.
+    const ByteSpan lastSkid(skids.back().data(), skids.back().size());
+    startUs = NowUs();
+    for (const auto & cert : certSpans)
+    {
+        uint8_t skidBuf[kSubjectKeyIdentifierLength];
+        MutableByteSpan skidSpan(skidBuf);
+        if (ExtractSKIDFromX509Cert(cert, skidSpan) == CHIP_NO_ERROR && skidSpan.data_equal(lastSkid))
+        {
+            break;
+        }
+    }
+    const uint64_t scanUs = NowUs() - startUs;
+
+    ChipLogProgress(Crypto, "%u PAAs: loaded in %u us, %u lookups in %u us; parsing all of them for one lookup: %u us",
+                    static_cast<unsigned>(kBenchmarkPAACount), static_cast<unsigned>(loadUs),
+                    static_cast<unsigned>(kBenchmarkPAACount), static_cast<unsigned>(lookupUs), static_cast<unsigned>(scanUs));
+
+    unlink(bundleTemplate);
+}
+
+int TestFileAttestationTrustStore_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int TestFileAttestationTrustStore_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test loading PAAs from a directory and from a bundle", TestDirectoryAndBundle),
+    NL_TEST_DEF("Test PAA lookup benchmark", TestLookupBenchmark),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestFileAttestationTrustStore()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "File Attestation Trust Store",
+        &sTests[0],
+        TestFileAttestationTrustStore_Setup,
+        TestFileAttestationTrustStore_Teardown
+    };
+    // clang-format on
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestFileAttestationTrustStore);
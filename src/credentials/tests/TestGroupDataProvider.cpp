@@ -24,6 +24,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
 #include <platform/KeyValueStoreManager.h>
+#include <system/SystemClock.h>
 #include <set>
 #include <string.h>
 #include <tuple>
@@ -1196,6 +1197,164 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
     }
 }
 
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
+size_t CountGroupSessions(GroupDataProvider * provider, uint16_t session_id, FabricIndex fabric_index, GroupId group_id)
+{
+    GroupSession session;
+    size_t count = 0;
+    auto it      = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, 0);
+    while (it->Next(session))
+    {
+        if (session.fabric_index == fabric_index && session.group_id == group_id && session.keyContext != nullptr)
+        {
+            count++;
+        }
+    }
+    it->Release();
+    return count;
+}
+
+void TestGroupSessionCache(nlTestSuite * apSuite, void * apContext)
+{
+    auto * provider = static_cast<GroupDataProviderImpl *>(GetGroupDataProvider());
+    NL_TEST_ASSERT(apSuite, provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset1));
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric1, kGroup1);
+    NL_TEST_ASSERT(apSuite, nullptr != key_context);
+    VerifyOrReturn(nullptr != key_context);
+    uint16_t old_session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    // The first lookup loads the cache, the next one is served without reloading it
+    GroupDataProviderImpl::GroupSessionCacheStats before = provider->GetGroupSessionCacheStats();
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, old_session_id, kFabric1, kGroup1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, old_session_id, kFabric1, kGroup1));
+    GroupDataProviderImpl::GroupSessionCacheStats after = provider->GetGroupSessionCacheStats();
+    NL_TEST_ASSERT(apSuite, after.hits == before.hits + 2);
+    NL_TEST_ASSERT(apSuite, after.loads == before.loads + 1);
+
+    // An iterator opened before a key set change keeps its candidates until released
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(old_session_id);
+    NL_TEST_ASSERT(apSuite, it);
+    VerifyOrReturn(it != nullptr);
+
+    // Replace the epoch key: lookups must see the new session ID and not the old one
+    KeySet keyset = kKeySet1;
+    keyset.epoch_keys[0].key[0] ^= 0xff;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, keyset));
+    NL_TEST_ASSERT(apSuite, provider->GetGroupSessionCacheStats().invalidations == after.invalidations + 1);
+
+    key_context = provider->GetKeyContext(kFabric1, kGroup1);
+    NL_TEST_ASSERT(apSuite, nullptr != key_context);
+    VerifyOrReturn(nullptr != key_context);
+    uint16_t new_session_id = key_context->GetKeyHash();
+    key_context->Release();
+    NL_TEST_ASSERT(apSuite, new_session_id != old_session_id);
+
+    // While the old iterator is alive, new lookups walk storage
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, new_session_id, kFabric1, kGroup1));
+    NL_TEST_ASSERT(apSuite, provider->GetGroupSessionCacheStats().fallbacks == after.fallbacks + 1);
+
+    NL_TEST_ASSERT(apSuite, it->Next(session));
+    NL_TEST_ASSERT(apSuite, session.fabric_index == kFabric1 && session.group_id == kGroup1);
+    NL_TEST_ASSERT(apSuite, session.keyContext != nullptr && session.keyContext->GetKeyHash() == old_session_id);
+    NL_TEST_ASSERT(apSuite, !it->Next(session));
+    it->Release();
+
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, old_session_id, kFabric1, kGroup1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, new_session_id, kFabric1, kGroup1));
+
+    // Removing the mapping drops the candidate
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric1, 0));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, new_session_id, kFabric1, kGroup1));
+}
+
+void BenchmarkGroupDecryption(nlTestSuite * apSuite, void * apContext)
+{
+    auto * provider = static_cast<GroupDataProviderImpl *>(GetGroupDataProvider());
+    NL_TEST_ASSERT(apSuite, provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    // Two fabrics with every group mapped to a three-key set: 24 candidates, as on a busy multi-admin node
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 1, kGroup2Keyset3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 2, kGroup3Keyset0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 3, kGroup3Keyset3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 0, kGroup1Keyset3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 1, kGroup2Keyset0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 2, kGroup3Keyset0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 3, kGroup3Keyset3));
+
+    const uint8_t kMessage[32] = { 0 };
+    const uint8_t nonce[13]    = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x18, 0x1a, 0x1b, 0x1c };
+    const uint8_t aad[8]       = { 0x0a, 0x1a, 0x2a, 0x3a, 0x4a, 0x5a, 0x6a, 0x7a };
+    uint8_t mic[16];
+    uint8_t ciphertext_buffer[sizeof(kMessage)];
+    uint8_t plaintext_buffer[sizeof(kMessage)];
+    MutableByteSpan tag(mic);
+    MutableByteSpan ciphertext(ciphertext_buffer);
+
+    // Sent with the last group mapped on the second fabric, so that every lookup has to try several candidates
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup3);
+    NL_TEST_ASSERT(apSuite, nullptr != key_context);
+    VerifyOrReturn(nullptr != key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    NL_TEST_ASSERT(apSuite,
+                   CHIP_NO_ERROR ==
+                       key_context->MessageEncrypt(ByteSpan(kMessage), ByteSpan(aad), ByteSpan(nonce), tag, ciphertext));
+    key_context->Release();
+
+    constexpr size_t kMessages = 2000;
+    for (bool enabled : { false, true })
+    {
+        provider->SetGroupSessionCacheEnabled(enabled);
+
+        size_t decrypted       = 0;
+        const uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (size_t i = 0; i < kMessages; i++)
+        {
+            // Same trial decryption as SessionManager::SecureGroupMessageDispatch()
+            GroupSession session;
+            auto it = provider->IterateGroupSessions(session_id);
+            VerifyOrReturn(it != nullptr);
+            while (it->Next(session))
+            {
+                MutableByteSpan plaintext(plaintext_buffer);
+                if (CHIP_NO_ERROR ==
+                    session.keyContext->MessageDecrypt(ciphertext, ByteSpan(aad), ByteSpan(nonce), tag, plaintext))
+                {
+                    decrypted++;
+                    break;
+                }
+            }
+            it->Release();
+        }
+        const uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+        NL_TEST_ASSERT(apSuite, decrypted == kMessages);
+        ChipLogProgress(Test, "Group decryption, cache %s: %u messages in %u us (%u msg/s)", enabled ? "on" : "off",
+                        static_cast<unsigned>(kMessages), static_cast<unsigned>(elapsedUs),
+                        static_cast<unsigned>(elapsedUs ? (kMessages * 1000000) / elapsedUs : 0));
+    }
+}
+
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -1275,6 +1434,10 @@ const nlTest sTests[] = { NL_TEST_DEF("TestStorageDelegate", chip::app::TestGrou
                           NL_TEST_DEF("TestIpk", chip::app::TestGroups::TestIpk),
                           NL_TEST_DEF("TestPerFabricData", chip::app::TestGroups::TestPerFabricData),
                           NL_TEST_DEF("TestGroupDecryption", chip::app::TestGroups::TestGroupDecryption),
+#if CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE > 0
+                          NL_TEST_DEF("TestGroupSessionCache", chip::app::TestGroups::TestGroupSessionCache),
+                          NL_TEST_DEF("BenchmarkGroupDecryption", chip::app::TestGroups::BenchmarkGroupDecryption),
+#endif
                           NL_TEST_SENTINEL() };
 } // namespace
 
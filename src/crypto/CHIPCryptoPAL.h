@@ -786,6 +786,60 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief AES-CCM key that is set up once and then used for many messages.
+ *
+ * AES_CCM_encrypt and AES_CCM_decrypt set up a cipher context and expand the key on every call,
+ * which is a large part of the cost of protecting a short message. A prepared key keeps that
+ * context, so that each message only costs setting the nonce and processing the data.
+ *
+ * The prepared context is specific to the Matter message format (kAES_CCM128_Nonce_Length nonce,
+ * kAES_CCM128_Tag_Length tag); other lengths use the one-shot functions with the key given to Init.
+ * PALs without prepared key support always do so. In both cases the key handle must outlive the
+ * prepared key.
+ */
+class AesCcm128PreparedKey
+{
+public:
+    AesCcm128PreparedKey() = default;
+    ~AesCcm128PreparedKey() { Clear(); }
+
+    AesCcm128PreparedKey(const AesCcm128PreparedKey &)             = delete;
+    AesCcm128PreparedKey & operator=(const AesCcm128PreparedKey &) = delete;
+
+    /**
+     * @brief Prepare the given key, releasing any previously prepared one.
+     */
+    CHIP_ERROR Init(const Aes128KeyHandle & key);
+
+    /**
+     * @brief Release the prepared key.
+     */
+    void Clear();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Same as AES_CCM_encrypt, using the prepared key. The plaintext may be encrypted in place.
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length) const;
+
+    /**
+     * @brief Same as AES_CCM_decrypt, using the prepared key. The ciphertext may be decrypted in place.
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                       uint8_t * plaintext) const;
+
+private:
+    const Aes128KeyHandle * mKey = nullptr;
+
+    // PAL-specific cipher contexts. A PAL may use the same context for both directions.
+    void * mEncryptContext = nullptr;
+    void * mDecryptContext = nullptr;
+};
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
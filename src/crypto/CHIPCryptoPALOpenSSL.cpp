@@ -411,6 +411,193 @@ exit:
     return error;
 }
 
+#if !CHIP_CRYPTO_BORINGSSL
+// Set up a CCM context for the Matter nonce and tag lengths with the given key. Both lengths
+// have to be known before the key, since OpenSSL derives the CCM flags from them at that point.
+static EVP_CIPHER_CTX * _newPreparedCcmContext(const Aes128KeyHandle & key, int enc)
+{
+    EVP_CIPHER_CTX * context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnValue(context != nullptr, nullptr);
+
+    if (EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, enc) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(kAES_CCM128_Nonce_Length), nullptr) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(kAES_CCM128_Tag_Length), nullptr) != 1 ||
+        EVP_CipherInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), nullptr, enc) != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+
+    return context;
+}
+#endif // !CHIP_CRYPTO_BORINGSSL
+
+CHIP_ERROR AesCcm128PreparedKey::Init(const Aes128KeyHandle & key)
+{
+    Clear();
+
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX * context = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key.As<Symmetric128BitsKeyByteArray>(),
+                                              sizeof(Symmetric128BitsKeyByteArray), kAES_CCM128_Tag_Length);
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // The AEAD context works in both directions.
+    mEncryptContext = context;
+    mDecryptContext = context;
+#else
+    mEncryptContext = _newPreparedCcmContext(key, 1);
+    mDecryptContext = _newPreparedCcmContext(key, 0);
+    if (mEncryptContext == nullptr || mDecryptContext == nullptr)
+    {
+        Clear();
+        return CHIP_ERROR_INTERNAL;
+    }
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void AesCcm128PreparedKey::Clear()
+{
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(static_cast<EVP_AEAD_CTX *>(mEncryptContext));
+#else
+    EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX *>(mEncryptContext));
+    EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX *>(mDecryptContext));
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    mEncryptContext = nullptr;
+    mDecryptContext = nullptr;
+    mKey            = nullptr;
+}
+
+CHIP_ERROR AesCcm128PreparedKey::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad,
+                                         size_t aad_length, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
+                                         uint8_t * tag, size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // The prepared context only covers non-empty messages with the Matter nonce and tag lengths.
+    if (plaintext_length == 0 || nonce_length != kAES_CCM128_Nonce_Length || tag_length != kAES_CCM128_Tag_Length)
+    {
+        return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag,
+                               tag_length);
+    }
+
+    VerifyOrReturnError(plaintext != nullptr && ciphertext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr && tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+#if CHIP_CRYPTO_BORINGSSL
+    const auto * context   = static_cast<const EVP_AEAD_CTX *>(mEncryptContext);
+    size_t written_tag_len = 0;
+
+    int result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
+                                           plaintext_length, nullptr, 0, aad, aad_length);
+    VerifyOrReturnError(result == 1 && written_tag_len == tag_length, CHIP_ERROR_INTERNAL);
+#else
+    auto * context   = static_cast<EVP_CIPHER_CTX *>(mEncryptContext);
+    int bytesWritten = 0;
+
+    VerifyOrReturnError(CanCastTo<int>(plaintext_length) && CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Pass in nonce, keeping the prepared key
+    VerifyOrReturnError(EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce)) == 1,
+                        CHIP_ERROR_INTERNAL);
+
+    // Pass in plain text length
+    VerifyOrReturnError(EVP_EncryptUpdate(context, nullptr, &bytesWritten, nullptr, static_cast<int>(plaintext_length)) == 1,
+                        CHIP_ERROR_INTERNAL);
+
+    // Pass in AAD
+    if (aad_length > 0)
+    {
+        VerifyOrReturnError(EVP_EncryptUpdate(context, nullptr, &bytesWritten, Uint8::to_const_uchar(aad),
+                                              static_cast<int>(aad_length)) == 1,
+                            CHIP_ERROR_INTERNAL);
+    }
+
+    // Encrypt
+    VerifyOrReturnError(EVP_EncryptUpdate(context, Uint8::to_uchar(ciphertext), &bytesWritten, Uint8::to_const_uchar(plaintext),
+                                          static_cast<int>(plaintext_length)) == 1,
+                        CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(bytesWritten >= 0 && static_cast<size_t>(bytesWritten) <= plaintext_length, CHIP_ERROR_INTERNAL);
+
+    // Finalize encryption; CCM does not produce any more output
+    int finalBytesWritten = 0;
+    VerifyOrReturnError(EVP_EncryptFinal_ex(context, Uint8::to_uchar(ciphertext) + bytesWritten, &finalBytesWritten) == 1,
+                        CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(finalBytesWritten == 0, CHIP_ERROR_INTERNAL);
+
+    // Get tag
+    VerifyOrReturnError(
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_GET_TAG, static_cast<int>(tag_length), Uint8::to_uchar(tag)) == 1,
+        CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AesCcm128PreparedKey::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad,
+                                         size_t aad_length, const uint8_t * tag, size_t tag_length, const uint8_t * nonce,
+                                         size_t nonce_length, uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // The prepared context only covers non-empty messages with the Matter nonce and tag lengths.
+    if (ciphertext_length == 0 || nonce_length != kAES_CCM128_Nonce_Length || tag_length != kAES_CCM128_Tag_Length)
+    {
+        return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                               plaintext);
+    }
+
+    VerifyOrReturnError(ciphertext != nullptr && plaintext != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr && tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+#if CHIP_CRYPTO_BORINGSSL
+    int result = EVP_AEAD_CTX_open_gather(static_cast<const EVP_AEAD_CTX *>(mDecryptContext), plaintext, nonce, nonce_length,
+                                          ciphertext, ciphertext_length, tag, tag_length, aad, aad_length);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+#else
+    auto * context  = static_cast<EVP_CIPHER_CTX *>(mDecryptContext);
+    int bytesOutput = 0;
+
+    VerifyOrReturnError(CanCastTo<int>(ciphertext_length) && CanCastTo<int>(aad_length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Pass in expected tag
+    // Removing "const" from |tag| here should hopefully be safe as
+    // we're writing the tag, not reading.
+    VerifyOrReturnError(EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                            const_cast<void *>(static_cast<const void *>(tag))) == 1,
+                        CHIP_ERROR_INTERNAL);
+
+    // Pass in nonce, keeping the prepared key
+    VerifyOrReturnError(EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce)) == 1,
+                        CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher text length
+    VerifyOrReturnError(EVP_DecryptUpdate(context, nullptr, &bytesOutput, nullptr, static_cast<int>(ciphertext_length)) == 1,
+                        CHIP_ERROR_INTERNAL);
+
+    // Pass in aad
+    if (aad_length > 0)
+    {
+        VerifyOrReturnError(
+            EVP_DecryptUpdate(context, nullptr, &bytesOutput, Uint8::to_const_uchar(aad), static_cast<int>(aad_length)) == 1,
+            CHIP_ERROR_INTERNAL);
+    }
+
+    // Pass in ciphertext. We wont get anything if validation fails.
+    VerifyOrReturnError(EVP_DecryptUpdate(context, Uint8::to_uchar(plaintext), &bytesOutput, Uint8::to_const_uchar(ciphertext),
+                                          static_cast<int>(ciphertext_length)) == 1,
+                        CHIP_ERROR_INTERNAL);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
@@ -45,6 +45,7 @@
 #include <lib/support/BufferWriter.h>
 #include <lib/support/BytesToHex.h>
 #include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
 #include <lib/support/SafePointerCast.h>
@@ -150,6 +151,94 @@ exit:
     return error;
 }
 
+CHIP_ERROR AesCcm128PreparedKey::Init(const Aes128KeyHandle & key)
+{
+    Clear();
+
+    mbedtls_ccm_context * context = Platform::New<mbedtls_ccm_context>();
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+    mbedtls_ccm_init(context);
+
+    // Size of key is expressed in bits, hence the multiplication by 8.
+    int result = mbedtls_ccm_setkey(context, MBEDTLS_CIPHER_ID_AES, key.As<Symmetric128BitsKeyByteArray>(),
+                                    sizeof(Symmetric128BitsKeyByteArray) * 8);
+    if (result != 0)
+    {
+        _log_mbedTLS_error(result);
+        mbedtls_ccm_free(context);
+        Platform::Delete(context);
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    // CCM only uses the forward cipher, so one context serves both directions.
+    mEncryptContext = context;
+    mDecryptContext = context;
+    mKey            = &key;
+    return CHIP_NO_ERROR;
+}
+
+void AesCcm128PreparedKey::Clear()
+{
+    auto * context = static_cast<mbedtls_ccm_context *>(mEncryptContext);
+    if (context != nullptr)
+    {
+        mbedtls_ccm_free(context);
+        Platform::Delete(context);
+    }
+
+    mEncryptContext = nullptr;
+    mDecryptContext = nullptr;
+    mKey            = nullptr;
+}
+
+CHIP_ERROR AesCcm128PreparedKey::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad,
+                                         size_t aad_length, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
+                                         uint8_t * tag, size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    VerifyOrReturnError(plaintext != nullptr || plaintext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext != nullptr || plaintext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    int result = mbedtls_ccm_encrypt_and_tag(static_cast<mbedtls_ccm_context *>(mEncryptContext), plaintext_length,
+                                             Uint8::to_const_uchar(nonce), nonce_length, Uint8::to_const_uchar(aad), aad_length,
+                                             Uint8::to_const_uchar(plaintext), Uint8::to_uchar(ciphertext), Uint8::to_uchar(tag),
+                                             tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AesCcm128PreparedKey::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad,
+                                         size_t aad_length, const uint8_t * tag, size_t tag_length, const uint8_t * nonce,
+                                         size_t nonce_length, uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    VerifyOrReturnError(plaintext != nullptr || ciphertext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ciphertext != nullptr || ciphertext_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(_isValidTagLength(tag_length), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(nonce_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    int result = mbedtls_ccm_auth_decrypt(static_cast<mbedtls_ccm_context *>(mDecryptContext), ciphertext_length,
+                                          Uint8::to_const_uchar(nonce), nonce_length, Uint8::to_const_uchar(aad), aad_length,
+                                          Uint8::to_const_uchar(ciphertext), Uint8::to_uchar(plaintext), Uint8::to_const_uchar(tag),
+                                          tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
@@ -127,6 +127,22 @@
 #define CHIP_DEVICE_CONFIG_BG_TASK_PRIORITY 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+ *
+ * The number of background tasks started by StartBackgroundEventLoopTask() on platforms that
+ * support a pool of background workers (currently POSIX).  All tasks service the same background
+ * event queue, so independent pieces of background work (e.g. the crypto of concurrent CASE
+ * handshakes) are processed in parallel.
+ *
+ * Background work, including the Sigma2 and Sigma3 processing that CASESession offloads, only
+ * runs on these tasks once the application has called StartBackgroundEventLoopTask(); until then
+ * it runs on the Matter thread, one piece at a time.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 1
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
  *
@@ -54,7 +54,8 @@ public:
 
     /**
      * Called when the OTA image download process has completed. This may include but not limited to closing the file and persistent
-     * storage. This must not be a blocking call.
+     * storage. This must not be a blocking call: an implementation that needs to wait for the image to be stored returns
+     * CHIP_ERROR_IN_PROGRESS and calls OTADownloader::OnFinalized once it is done.
      */
     virtual CHIP_ERROR Finalize() = 0;
 
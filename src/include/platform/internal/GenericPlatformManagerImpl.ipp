@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemPacketBuffer.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -139,6 +140,11 @@ void GenericPlatformManagerImpl<ImplClass>::_Shutdown()
 
     ChipLogError(DeviceLayer, "System Layer shutdown");
     SystemLayer().Shutdown();
+
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    // Buffers kept for reuse would otherwise still be allocated at Platform::MemoryShutdown().
+    System::PacketBuffer::ReleaseHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
 }
 
 template <class ImplClass>
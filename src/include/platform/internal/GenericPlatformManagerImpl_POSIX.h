@@ -93,6 +93,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -113,6 +120,23 @@ private:
     static void * EventLoopTaskMain(void * arg);
 #endif
     void ProcessDeviceEvents();
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background work queue shared by all background event loop tasks.  mShouldRunBackgroundEventLoop,
+    // mStoppingBackgroundEventLoop and mBackgroundEventQueue are guarded by mBackgroundEventLock.
+    pthread_mutex_t mBackgroundEventLock     = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventQueueCond = PTHREAD_COND_INITIALIZER;
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    bool mShouldRunBackgroundEventLoop = false;
+    bool mStoppingBackgroundEventLoop  = false;
+
+    pthread_t mBackgroundEventLoopTasks[CHIP_DEVICE_CONFIG_BG_TASK_COUNT];
+    size_t mBackgroundEventLoopTaskCount = 0;
+
+    static void * BackgroundEventLoopTaskMain(void * arg);
+    void ProcessBackgroundEvents();
+    void StopBackgroundEventLoopTasks(bool handOffQueuedWork);
+#endif
 };
 
 // Instruct the compiler to instantiate the template only when explicitly told to do so.
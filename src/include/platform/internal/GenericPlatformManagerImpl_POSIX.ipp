@@ -383,6 +383,159 @@ exit:
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    VerifyOrReturnError(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    pthread_mutex_lock(&mBackgroundEventLock);
+    if (!mShouldRunBackgroundEventLoop && !mStoppingBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        // No background task is running, use foreground event loop for background events
+        return _PostEvent(event);
+    }
+    // While the background tasks are being stopped, the work is queued until they are, and then handled
+    // as the work they left in the queue.
+    mBackgroundEventQueue.push(*event);
+    pthread_cond_signal(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    ProcessBackgroundEvents();
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessBackgroundEvents()
+{
+    //
+    // Any number of tasks may run this loop at the same time; each event is dispatched by exactly
+    // one of them. The loop runs until StopBackgroundEventLoopTask() is called.
+    //
+    pthread_mutex_lock(&mBackgroundEventLock);
+    while (true)
+    {
+        while (mShouldRunBackgroundEventLoop && mBackgroundEventQueue.empty())
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventLock);
+        }
+        if (!mShouldRunBackgroundEventLoop)
+        {
+            break;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->ProcessBackgroundEvents();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    if (mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventLock);
+        ChipLogError(DeviceLayer, "Error trying to start the background event loop while it is already running");
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+    mShouldRunBackgroundEventLoop = true;
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    while (mBackgroundEventLoopTaskCount < CHIP_DEVICE_CONFIG_BG_TASK_COUNT)
+    {
+        int err = pthread_create(&mBackgroundEventLoopTasks[mBackgroundEventLoopTaskCount], nullptr, BackgroundEventLoopTaskMain,
+                                 this);
+        if (err != 0)
+        {
+            _StopBackgroundEventLoopTask();
+            return CHIP_ERROR_POSIX(err);
+        }
+        mBackgroundEventLoopTaskCount++;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    //
+    // Work left in the queue can only be handed to the foreground event loop while it runs: otherwise it
+    // could be dispatched by a later run of the event loop, possibly over objects of a stack shut down since.
+    //
+    StopBackgroundEventLoopTasks(/* handOffQueuedWork = */ mState.load(std::memory_order_relaxed) == State::kRunning);
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::StopBackgroundEventLoopTasks(bool handOffQueuedWork)
+{
+    pthread_mutex_lock(&mBackgroundEventLock);
+    mShouldRunBackgroundEventLoop = false;
+    mStoppingBackgroundEventLoop  = true;
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventLock);
+
+    for (size_t i = 0; i < mBackgroundEventLoopTaskCount; i++)
+    {
+        if (pthread_equal(pthread_self(), mBackgroundEventLoopTasks[i]))
+        {
+            pthread_detach(mBackgroundEventLoopTasks[i]);
+        }
+        else
+        {
+            pthread_join(mBackgroundEventLoopTasks[i], nullptr);
+        }
+    }
+    mBackgroundEventLoopTaskCount = 0;
+
+    //
+    // Hand any work that was still queued to the foreground event loop, so that callers waiting on
+    // it (e.g. a pending CASE handshake) are not left hanging, or else drop it.
+    //
+    pthread_mutex_lock(&mBackgroundEventLock);
+    if (!handOffQueuedWork && !mBackgroundEventQueue.empty())
+    {
+        ChipLogProgress(DeviceLayer, "Dropping %u queued background events", static_cast<unsigned>(mBackgroundEventQueue.size()));
+    }
+    while (!mBackgroundEventQueue.empty())
+    {
+        if (handOffQueuedWork)
+        {
+            _PostEvent(&mBackgroundEventQueue.front());
+        }
+        mBackgroundEventQueue.pop();
+    }
+    mStoppingBackgroundEventLoop = false;
+    pthread_mutex_unlock(&mBackgroundEventLock);
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
 {
@@ -393,6 +546,13 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    //
+    // Nor can the background tasks outlive the stack, nor the work still queued for them.
+    //
+    StopBackgroundEventLoopTasks(/* handOffQueuedWork = */ false);
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
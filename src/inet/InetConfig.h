@@ -272,6 +272,24 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams the socket-based implementation of UDP
+ *    endpoints drains with a single recvmmsg() call per read readiness event.
+ *
+ *  @details
+ *    A value of 1 keeps the one recvmsg() per readiness event behavior. Larger
+ *    values require recvmmsg(). The PacketBuffers are allocated for each
+ *    readiness event, starting with one and doubling up to this many while
+ *    batches come back full, so endpoints that receive one datagram at a time
+ *    do not allocate more.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE              1
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
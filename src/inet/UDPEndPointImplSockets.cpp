@@ -43,6 +43,7 @@
 #include <zephyr/net/socket.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_ZEPHYR_SOCKETS
 
+#include <algorithm>
 #include <cerrno>
 #include <unistd.h>
 #include <utility>
@@ -169,6 +170,12 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 
 } // anonymous namespace
 
+UDPEndPointImplSockets::BatchStats UDPEndPointImplSockets::sBatchStats;
+
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+static_assert(INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE <= UINT8_MAX, "Receive batch size is tracked in a uint8_t");
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 UDPEndPointImplSockets::MulticastGroupHandler UDPEndPointImplSockets::sMulticastGroupHandler;
 #endif // CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
@@ -561,6 +568,64 @@ CHIP_ERROR UDPEndPointImplSockets::GetSocket(IPAddressType addressType)
     return CHIP_NO_ERROR;
 }
 
+namespace {
+
+// Fills in the source address, and the destination address and interface from any IP_PKTINFO/IPV6_PKTINFO
+// control message, of a datagram received with recvmsg()/recvmmsg().
+CHIP_ERROR ParseReceivedMsgHeader(struct msghdr & msgHeader, IPPacketInfo & packetInfo)
+{
+    const SockAddr & peerSockAddr = *static_cast<const SockAddr *>(msgHeader.msg_name);
+
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            VerifyOrReturnError(CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex), CHIP_ERROR_INCORRECT_STATE);
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // anonymous namespace
+
 // static
 void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events, intptr_t data)
 {
@@ -574,6 +639,9 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    ReceiveBatch();
+#else  // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -618,62 +686,7 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = ParseReceivedMsgHeader(msgHeader, lPacketInfo);
         }
     }
     else
@@ -693,7 +706,124 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
             OnReceiveError(this, lStatus, nullptr);
         }
     }
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+}
+
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+void UDPEndPointImplSockets::ReceiveBatch()
+{
+    constexpr unsigned int kBatchSize = INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE;
+    // Room for the IP_PKTINFO or IPV6_PKTINFO control message requested in GetSocket().
+    constexpr size_t kControlDataSize = 64;
+
+    struct iovec msgIOV[kBatchSize];
+    SockAddr peerSockAddr[kBatchSize];
+    alignas(struct cmsghdr) uint8_t controlData[kBatchSize][kControlDataSize];
+    struct mmsghdr msgHeaders[kBatchSize];
+
+    // Allocate the buffers for this readiness event only, so that idle endpoints hold none; a short batch is fine if
+    // allocation fails.
+    System::PacketBufferHandle buffers[kBatchSize];
+    unsigned int count = 0;
+    for (; count < mReceiveBatchSize; count++)
+    {
+        buffers[count] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (buffers[count].IsNull())
+        {
+            break;
+        }
+
+        msgIOV[count].iov_base = buffers[count]->Start();
+        msgIOV[count].iov_len  = buffers[count]->AvailableDataLength();
+
+        memset(&peerSockAddr[count], 0, sizeof(peerSockAddr[count]));
+        memset(&msgHeaders[count], 0, sizeof(msgHeaders[count]));
+
+        struct msghdr & msgHeader = msgHeaders[count].msg_hdr;
+        msgHeader.msg_name        = &peerSockAddr[count];
+        msgHeader.msg_namelen     = sizeof(peerSockAddr[count]);
+        msgHeader.msg_iov         = &msgIOV[count];
+        msgHeader.msg_iovlen      = 1;
+        msgHeader.msg_control     = controlData[count];
+        msgHeader.msg_controllen  = kControlDataSize;
+    }
+
+    if (count == 0)
+    {
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
+    }
+
+    const int received = recvmmsg(mSocket, msgHeaders, count, MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        const CHIP_ERROR lStatus = CHIP_ERROR_POSIX(errno);
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+        return;
+    }
+    if (received == 0)
+    {
+        return;
+    }
+
+    sBatchStats.receiveBatches++;
+    sBatchStats.receivedDatagrams += static_cast<uint64_t>(received);
+
+    // Size the next batch after this one: grow while batches come back full, and fall back to what was received
+    // otherwise, so that endpoints seeing one datagram at a time allocate one buffer per readiness event.
+    if (static_cast<unsigned int>(received) == count)
+    {
+        mReceiveBatchSize = static_cast<uint8_t>(std::min(2 * count, kBatchSize));
+    }
+    else
+    {
+        mReceiveBatchSize = static_cast<uint8_t>(received);
+    }
+
+    // The handlers may close and release this endpoint; hold a reference until the whole batch is dispatched.
+    Retain();
+    for (int i = 0; i < received; i++)
+    {
+        if (mState != State::kListening || OnMessageReceived == nullptr)
+        {
+            break;
+        }
+
+        CHIP_ERROR lStatus = CHIP_NO_ERROR;
+        IPPacketInfo lPacketInfo;
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort  = mBoundPort;
+        lPacketInfo.Interface = mBoundIntfId;
+
+        if ((msgHeaders[i].msg_hdr.msg_flags & MSG_TRUNC) != 0 || msgHeaders[i].msg_len > buffers[i]->AvailableDataLength())
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            buffers[i]->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            lStatus = ParseReceivedMsgHeader(msgHeaders[i].msg_hdr, lPacketInfo);
+        }
+
+        if (lStatus == CHIP_NO_ERROR)
+        {
+            buffers[i].RightSize();
+            OnMessageReceived(this, std::move(buffers[i]), &lPacketInfo);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+    }
+    Release();
 }
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
 
 #ifdef IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
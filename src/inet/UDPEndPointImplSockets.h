@@ -42,6 +42,20 @@ public:
     uint16_t GetBoundPort() const override;
     void Free() override;
 
+    /**
+     * Counters for the batched receive path, shared by all socket-based UDP endpoints.
+     *
+     * The average batch size is the number of datagrams divided by the number of batches.
+     */
+    struct BatchStats
+    {
+        uint64_t receiveBatches;    ///< Number of recvmmsg() calls that returned at least one datagram.
+        uint64_t receivedDatagrams; ///< Number of datagrams returned by those calls.
+    };
+
+    static const BatchStats & GetBatchStats() { return sBatchStats; }
+    static void ResetBatchStats() { sBatchStats = {}; }
+
 private:
     // UDPEndPoint overrides.
 #if INET_CONFIG_ENABLE_IPV4
@@ -61,6 +75,15 @@ private:
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+    static BatchStats sBatchStats;
+
+#if INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    void ReceiveBatch();
+
+    // Number of datagrams the next recvmmsg() call allocates buffers for, adapted to the size of the last batch.
+    uint8_t mReceiveBatchSize = 1;
+#endif // INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     enum class MulticastOperation
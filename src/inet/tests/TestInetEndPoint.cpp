@@ -33,6 +33,9 @@
 
 #include <inet/IPPrefix.h>
 #include <inet/InetError.h>
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+#include <inet/UDPEndPointImpl.h>
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
 #include <lib/support/CHIPArgParser.hpp>
 #include <lib/support/CHIPMem.h>
@@ -357,6 +360,87 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+namespace {
+
+constexpr uint16_t kLoopbackMessageCount = 32;
+
+struct LoopbackReceiveState
+{
+    uint16_t received;
+    bool inOrder;
+};
+
+void HandleLoopbackMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * state = static_cast<LoopbackReceiveState *>(endPoint->mAppState);
+    uint16_t sequence;
+    if (msg->DataLength() != sizeof(sequence))
+    {
+        state->inOrder = false;
+        return;
+    }
+    memcpy(&sequence, msg->Start(), sizeof(sequence));
+    state->inOrder = state->inOrder && (sequence == state->received);
+    state->received++;
+}
+
+} // namespace
+
+// Send a burst of datagrams over loopback and check that all of them arrive, in order.
+static void TestInetUDPLoopback(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress loopback;
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&receiver) == CHIP_NO_ERROR);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&sender) == CHIP_NO_ERROR);
+
+    LoopbackReceiveState state = { 0, true };
+    CHIP_ERROR err             = receiver->Bind(IPAddressType::kIPv6, loopback, 0);
+    if (err != CHIP_NO_ERROR)
+    {
+        // No IPv6 loopback on this host.
+        receiver->Free();
+        sender->Free();
+        return;
+    }
+    NL_TEST_ASSERT(inSuite, receiver->Listen(HandleLoopbackMessage, nullptr, &state) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sender->Bind(IPAddressType::kIPv6, loopback, 0) == CHIP_NO_ERROR);
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    UDPEndPointImpl::ResetBatchStats();
+#endif
+
+    for (uint16_t i = 0; i < kLoopbackMessageCount; i++)
+    {
+        PacketBufferHandle buf = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !buf.IsNull());
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiver->GetBoundPort(), std::move(buf)) == CHIP_NO_ERROR);
+    }
+
+    for (int pass = 0; pass < 100 && state.received < kLoopbackMessageCount; pass++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, state.received == kLoopbackMessageCount);
+    NL_TEST_ASSERT(inSuite, state.inOrder);
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SOCKET_RECV_BATCH_SIZE > 1
+    const UDPEndPointImpl::BatchStats & stats = UDPEndPointImpl::GetBatchStats();
+    printf("    UDP batches: receive %" PRIu64 " datagrams in %" PRIu64 " calls\n", stats.receivedDatagrams, stats.receiveBatches);
+    // The burst is in the socket before the receiver gets to run, so it drains more than one datagram per readiness event.
+    NL_TEST_ASSERT(inSuite, stats.receivedDatagrams == kLoopbackMessageCount);
+    NL_TEST_ASSERT(inSuite, stats.receiveBatches < kLoopbackMessageCount);
+#endif
+
+    receiver->Free();
+    sender->Free();
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
@@ -448,6 +532,9 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+                                 NL_TEST_DEF("InetEndPoint::TestUDPLoopback", TestInetUDPLoopback),
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
 #endif
@@ -254,6 +254,26 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_EXCHANGE_INDEX_SIZE
+ *
+ *  @brief
+ *    Number of hash buckets the exchange manager uses to find the exchange
+ *    for an incoming message. Must be a power of two, or 0 to use twice
+ *    CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS rounded up to a power of two.
+ *
+ *    When the pool uses the heap, the number of exchanges is not bounded by
+ *    CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, so a fixed size is used instead.
+ *
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_INDEX_SIZE
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_EXCHANGE_INDEX_SIZE 64
+#else
+#define CHIP_CONFIG_EXCHANGE_INDEX_SIZE 0
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_EXCHANGE_INDEX_SIZE
+
 /**
  *  @def CHIP_CONFIG_MCSP_RECEIVE_TABLE_SIZE
  *
@@ -769,6 +789,40 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+ *
+ * @brief Enables a persistent in-use bitmap over the whole 16-bit local
+ * session ID space in the secure session table, so that allocating a new
+ * local session ID is a find-first-zero over bitmap words rather than a search
+ * over the active sessions.
+ *
+ * The bitmap costs a little over 8KB of RAM per secure session table, so it is
+ * enabled by default only on heap-based (host) platforms, which are also the
+ * ones likely to raise CHIP_CONFIG_SECURE_SESSION_POOL_SIZE. When disabled,
+ * candidate IDs are checked against the session table's local session ID index.
+ *
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+#define CHIP_CONFIG_SECURE_SESSION_ID_BITMAP CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+ *
+ * @brief Enables keeping a prepared AES-CCM cipher context (see
+ * Crypto::AesCcm128PreparedKey) for the encryption and decryption keys of each
+ * secure session, so that the key is only set up once per session instead of
+ * once per message.
+ *
+ * The crypto library allocates the contexts, which costs a few hundred bytes of
+ * heap per session, so this is enabled by default only on heap-based platforms.
+ *
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+#define CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -904,6 +958,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_REPORTS_IN_FLIGHT 4
 #endif
 
+/**
+ * @def CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+ *
+ * @brief If 1, a subscription report built by the reporting engine is reused for the other subscriptions which would
+ * produce the same report in the same run: same fabric, fabric filtering and attribute paths, the same access control
+ * decisions for those paths, no event paths, and the same last reported generation. Only the SubscriptionId is
+ * re-encoded for them.
+ *
+ * This keeps a copy of the report payload for the duration of a run, so it defaults to on only when packet buffers
+ * are allocated from the heap.
+ */
+#ifndef CHIP_IM_SHARED_SUBSCRIPTION_REPORTS
+#define CHIP_IM_SHARED_SUBSCRIPTION_REPORTS CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif
+
 /**
  * @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
  *
@@ -931,6 +1000,62 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_DIRTY_ATTRIBUTE_SET
+ *
+ * @brief If 1, the reporting engine keeps dirty concrete attributes in a per-cluster table indexed by the attribute
+ * metadata, so that they are reported exactly instead of being merged into cluster or endpoint wildcards once the
+ * CHIP_IM_SERVER_MAX_NUM_DIRTY_SET entries of the global dirty set are in use. Wildcard paths, and attributes the
+ * table cannot hold, still go to the global dirty set.
+ *
+ * The table takes CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS * CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES * 4 bytes.
+ */
+#ifndef CHIP_IM_DIRTY_ATTRIBUTE_SET
+#define CHIP_IM_DIRTY_ATTRIBUTE_SET 0
+#endif
+
+/**
+ * @def CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS
+ *
+ * @brief Number of clusters with dirty attributes the table enabled by CHIP_IM_DIRTY_ATTRIBUTE_SET can hold.
+ */
+#ifndef CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS
+#define CHIP_IM_DIRTY_ATTRIBUTE_SET_CLUSTERS 16
+#endif
+
+/**
+ * @def CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES
+ *
+ * @brief Number of attributes per cluster the table enabled by CHIP_IM_DIRTY_ATTRIBUTE_SET can hold. Attributes at a
+ * later position in the cluster metadata go to the global dirty set.
+ */
+#ifndef CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES
+#define CHIP_IM_DIRTY_ATTRIBUTE_SET_MAX_ATTRIBUTES 64
+#endif
+
+/**
+ * @def CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+ *
+ * @brief If 1, the reporting engine keeps an index from attribute paths to the read handlers interested in them, so
+ * that marking an attribute dirty only visits the handlers with an intersecting path instead of walking the path list
+ * of every active read handler.
+ *
+ * The index takes one entry per attribute path object (see CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS and
+ * CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS), so it defaults to on only when pools are allocated from the heap.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_INTEREST_INDEX
+#define CHIP_IM_ATTRIBUTE_INTEREST_INDEX CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif
+
+/**
+ * @def CHIP_IM_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Number of hash buckets of the attribute interest index enabled by CHIP_IM_ATTRIBUTE_INTEREST_INDEX.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_ATTRIBUTE_INTEREST_INDEX_BUCKETS 64
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -986,6 +1111,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_IM_ENABLE_ENCODING_SENTINEL_ENUM_VALUES 0
 #endif
 
+/**
+ * @def CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW
+ *
+ * @brief Once fewer than this many bytes are left in a report, attribute
+ *        values (and list items) are sized with a counting TLV writer before
+ *        being encoded, and a value that cannot fit is left for the next chunk
+ *        without being partly encoded and rolled back.  The sizing pass stops
+ *        at the space left, so it costs at most this many bytes of encoding
+ *        work per value.  0 disables sizing.
+ */
+#ifndef CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW
+#define CHIP_CONFIG_IM_PRESIZE_ATTRIBUTE_VALUE_WINDOW 256
+#endif
+
 /**
  * @def CHIP_CONFIG_LAMBDA_EVENT_SIZE
  *
@@ -1107,6 +1246,25 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+ *
+ * @brief Defines the number of group session candidates (one per group key map entry and
+ * operational key of its key set) that GroupDataProviderImpl keeps ready for decrypting
+ * incoming group messages, so that they do not have to be reloaded from storage for every
+ * message. When a node has more candidates than this, lookups fall back to walking storage.
+ *
+ * Each entry holds two key handles, so the cache is enabled by default only on heap-based
+ * platforms. Set to 0 to disable it.
+ */
+#ifndef CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 64
+#else
+#define CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE 0
+#endif
+#endif // CHIP_CONFIG_GROUP_SESSION_CACHE_SIZE
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1116,6 +1274,32 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX
+ *
+ * @brief Enables a compiled index of the access control entries, so that
+ * AccessControl::Check() performs a fixed number of hash lookups instead of
+ * walking every entry of the fabric through the entry delegate interface.
+ *
+ * The index is discarded whenever entries change and rebuilt on the next check.
+ * If the entries do not fit in CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY rules,
+ * checks fall back to walking the entries.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY
+ *
+ * @brief Number of slots in the compiled access control index. Must be a power
+ * of two. Each entry uses one slot per (subject, target) pair, and at most three
+ * quarters of the slots are used.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY 256
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX_CAPACITY
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1236,6 +1420,26 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of events each event logging buffer keeps in an index of
+ *   event numbers, paths and buffer offsets.
+ *
+ * The index lets event reports start at the first event that is both newer than
+ * the requested event number and in one of the requested paths, instead of
+ * decoding every event held by the buffers. Events beyond the indexed ones are
+ * found by reading the buffer from its head. Each entry takes 24 bytes per
+ * buffer; set to 0 to disable the index.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 32
+#else
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 0
+#endif
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1332,6 +1536,86 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE 1003
 #endif // CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE
 
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+ *
+ * @brief Enables hash tables in the ember attribute store mapping endpoint ids
+ * to endpoint indices and (endpoint, cluster, attribute) to attribute metadata
+ * and storage offset, instead of scanning every endpoint, cluster and attribute
+ * on each lookup.
+ *
+ * The tables are rebuilt on first use after endpoints are configured, added,
+ * removed, enabled or disabled.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+#define CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE
+ *
+ * @brief Number of slots in the attribute lookup table enabled by
+ * CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLES, or 0 to size it from the server
+ * attributes of the fixed endpoints plus
+ * CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES for each
+ * dynamic endpoint. Must otherwise be a power of two. If the enabled endpoints
+ * have more than three quarters as many attributes, attribute lookups scan the
+ * endpoints instead.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE 0
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES
+ *
+ * @brief Number of attributes each dynamic endpoint is expected to have, used
+ * to size the attribute lookup table when
+ * CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_SIZE is 0.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES
+#define CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES 16
+#endif // CHIP_CONFIG_ATTRIBUTE_STORE_LOOKUP_TABLE_DYNAMIC_ENDPOINT_ATTRIBUTES
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+ *
+ * @brief Enables a cache of encoded AttributeReportIBs in the reporting
+ * engine, so that reading the same attribute for several subscribers (or
+ * readers) copies the encoding produced for the first one instead of reading
+ * and encoding the value again.
+ *
+ * Entries are keyed by attribute path, accessing fabric and fabric filtering,
+ * and are only used while the cluster is at the DataVersion they were encoded
+ * with. This requires every change to an attribute value to go through
+ * MatterReportingAttributeChangeCallback (which bumps the DataVersion), which is
+ * why the cache is opt-in.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+#define CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE 0
+#endif // CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES
+ *
+ * @brief Number of entries in the attribute value cache enabled by
+ * CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES
+#define CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES 32
+#endif // CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_ENTRIES
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE
+ *
+ * @brief Largest encoded AttributeReportIB, in bytes, kept by the attribute
+ * value cache. Larger values (typically long lists) are always read directly,
+ * so that they can still be chunked across reports.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE 128
+#endif // CHIP_CONFIG_ATTRIBUTE_VALUE_CACHE_MAX_VALUE_SIZE
+
 /*
  * @def CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
  *
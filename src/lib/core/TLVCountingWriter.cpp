@@ -0,0 +1,50 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/TLVCountingWriter.h>
+
+#include <cstdint>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVCommon.h>
+
+namespace chip {
+namespace TLV {
+
+TlvCountingWriter::TlvCountingWriter(uint32_t maxLen)
+{
+    Init(mDiscardingBuffer, maxLen);
+
+    // Count elements as if they were members of a list, so that they may carry any kind of tag; in particular the
+    // context tags that values are usually encoded with.
+    mContainerType = kTLVType_List;
+}
+
+CHIP_ERROR TlvCountingWriter::DiscardingBuffer::OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    return GetNewBuffer(writer, bufStart, bufLen);
+}
+
+CHIP_ERROR TlvCountingWriter::DiscardingBuffer::GetNewBuffer(TLVWriter & /*writer*/, uint8_t *& bufStart, uint32_t & bufLen)
+{
+    bufStart = mScratch;
+    bufLen   = sizeof(mScratch);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace TLV
+} // namespace chip
@@ -0,0 +1,70 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVBackingStore.h>
+#include <lib/core/TLVCommon.h>
+
+namespace chip {
+namespace TLV {
+
+// Implementation of TLVWriter that discards everything written to it, for
+// working out how large an encoding is before committing it to a buffer. The
+// size is available from GetLengthWritten(). Elements are counted as if they
+// were members of a list, so they may have any kind of tag.
+// Once more than maxLen bytes would have been written, writes fail with
+// CHIP_ERROR_BUFFER_TOO_SMALL, so a caller only interested in whether an
+// encoding fits in some space does not pay for counting the rest of it.
+// Users of TlvCountingWriter may call any public API of TLVWriter, except for
+// the Init functions.
+class TlvCountingWriter : public TLVWriter
+{
+public:
+    TlvCountingWriter(uint32_t maxLen = UINT32_MAX);
+    TlvCountingWriter(const TlvCountingWriter &)             = delete;
+    TlvCountingWriter & operator=(const TlvCountingWriter &) = delete;
+
+private:
+    class DiscardingBuffer : public TLVBackingStore
+    {
+    public:
+        // TLVBackingStore implementation:
+        CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+        {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
+        CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override { return CHIP_NO_ERROR; }
+
+    private:
+        // Every buffer handed to the writer is this one; its contents are never looked at.
+        uint8_t mScratch[128];
+    };
+
+    DiscardingBuffer mDiscardingBuffer;
+};
+
+} // namespace TLV
+} // namespace chip
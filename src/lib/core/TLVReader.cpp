@@ -17,6 +17,7 @@
  */
 #include <lib/core/TLVReader.h>
 
+#include <array>
 #include <stdint.h>
 #include <string.h>
 
@@ -47,7 +48,58 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
-static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+static constexpr uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+namespace {
+
+// Per-control-byte information used by SkipBufferedElements(). The low bits hold the size of the element head
+// (control byte, tag and length/value field); a head size of zero marks an invalid element type.
+constexpr uint8_t kSkipHeadBytesMask    = 0x1F;
+constexpr uint8_t kSkipHasLength        = 0x20;
+constexpr uint8_t kSkipIsContainer      = 0x40;
+constexpr uint8_t kSkipIsEndOfContainer = 0x80;
+
+constexpr uint8_t ElemTypeValue(TLVElementType type)
+{
+    return static_cast<uint8_t>(type);
+}
+
+constexpr uint8_t SkipInfoForControlByte(uint8_t controlByte)
+{
+    const uint8_t elemType = static_cast<uint8_t>(controlByte & kTLVTypeMask);
+    if (elemType > ElemTypeValue(TLVElementType::EndOfContainer))
+        return 0;
+
+    const bool hasValueOrLength = (elemType <= ElemTypeValue(TLVElementType::UInt64)) ||
+        (elemType >= ElemTypeValue(TLVElementType::FloatingPointNumber32) &&
+         elemType <= ElemTypeValue(TLVElementType::ByteString_8ByteLength));
+    const uint8_t valOrLenBytes = hasValueOrLength ? static_cast<uint8_t>(1 << (elemType & kTLVTypeSizeMask)) : 0;
+    uint8_t info = static_cast<uint8_t>(1 + sTagSizes[controlByte >> kTLVTagControlShift] + valOrLenBytes);
+
+    if (elemType >= ElemTypeValue(TLVElementType::UTF8String_1ByteLength) &&
+        elemType <= ElemTypeValue(TLVElementType::ByteString_8ByteLength))
+        info |= kSkipHasLength;
+    else if (elemType >= ElemTypeValue(TLVElementType::Structure) && elemType <= ElemTypeValue(TLVElementType::List))
+        info |= kSkipIsContainer;
+    else if (elemType == ElemTypeValue(TLVElementType::EndOfContainer))
+        info |= kSkipIsEndOfContainer;
+
+    return info;
+}
+
+constexpr std::array<uint8_t, 256> MakeSkipInfoTable()
+{
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        table[i] = SkipInfoForControlByte(static_cast<uint8_t>(i));
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> sSkipInfo = MakeSkipInfoTable();
+
+} // namespace
 
 TLVReader::TLVReader() :
     ImplicitProfileId(kProfileIdNotSpecified), AppData(nullptr), mElemLenOrVal(0), mBackingStore(nullptr), mReadPoint(nullptr),
@@ -80,6 +132,10 @@ CHIP_ERROR TLVReader::Init(TLVBackingStore & backingStore, uint32_t maxLen)
     if (err != CHIP_NO_ERROR)
         return err;
 
+    // As in EnsureData(), don't read beyond the maximum length even if the first buffer is larger.
+    if (maxLen < bufLen)
+        bufLen = maxLen;
+
     mBufEnd  = mReadPoint + bufLen;
     mLenRead = 0;
     mMaxLen  = maxLen;
@@ -747,12 +803,124 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+        SkipBufferedElements(nestLevel, outerContainerType);
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * Fast path for SkipToEndOfContainer().
+ *
+ * Walks the well-formed elements that lie entirely within the current input buffer using a control byte lookup
+ * table, tracking only the nesting level and container type instead of decoding each element into the reader's
+ * state. The scan stops in front of the end-of-container element that closes the container being skipped, at the
+ * end of the buffer (which is capped at the reader's maximum length), or at any element that would fail
+ * ReadElement()'s checks, leaving that element for the regular per-element path. For a ContiguousBufferTLVReader
+ * this skips the whole container in a single pass.
+ */
+void TLVReader::SkipBufferedElements(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    const uint8_t * p       = mReadPoint;
+    TLVType containerType   = mContainerType;
+    const bool implicitTags = (ImplicitProfileId != kProfileIdNotSpecified);
+
+    // mBufEnd never extends past mMaxLen, so neither does the scan.
+    while (p != mBufEnd)
+    {
+        const uint8_t controlByte = *p;
+        const uint8_t info        = sSkipInfo[controlByte];
+        const uint8_t headBytes   = info & kSkipHeadBytesMask;
+        const size_t remaining    = static_cast<size_t>(mBufEnd - p);
+
+        // The element that ends the buffer is always left to ReadElement(), so that if the input runs out there the
+        // reader's element state matches that of the per-element path.
+        if (headBytes == 0 || headBytes >= remaining)
+            break;
+
+        const TLVTagControl tagControl = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+
+        if (info & kSkipIsEndOfContainer)
+        {
+            if (nestLevel == 0 || tagControl != TLVTagControl::Anonymous)
+                break;
+
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+            p += headBytes;
+            continue;
+        }
+
+        if (!implicitTags &&
+            (tagControl == TLVTagControl::ImplicitProfile_2Bytes || tagControl == TLVTagControl::ImplicitProfile_4Bytes))
+            break;
+
+        bool tagValid;
+        switch (containerType)
+        {
+        case kTLVType_NotSpecified:
+            tagValid = (tagControl != TLVTagControl::ContextSpecific);
+            break;
+        case kTLVType_Structure:
+            tagValid = (tagControl != TLVTagControl::Anonymous);
+            break;
+        case kTLVType_Array:
+            tagValid = (tagControl == TLVTagControl::Anonymous);
+            break;
+        case kTLVType_UnknownContainer:
+        case kTLVType_List:
+            tagValid = true;
+            break;
+        default:
+            tagValid = false;
+            break;
+        }
+        if (!tagValid)
+            break;
+
+        if (info & kSkipHasLength)
+        {
+            const TLVFieldSize lenFieldSize = static_cast<TLVFieldSize>(controlByte & kTLVTypeSizeMask);
+            const uint8_t * lenField        = p + headBytes - TLVFieldSizeToBytes(lenFieldSize);
+            uint64_t len;
+            switch (lenFieldSize)
+            {
+            case kTLVFieldSize_1Byte:
+                len = Get8(lenField);
+                break;
+            case kTLVFieldSize_2Byte:
+                len = LittleEndian::Get16(lenField);
+                break;
+            case kTLVFieldSize_4Byte:
+                len = LittleEndian::Get32(lenField);
+                break;
+            default:
+                len = LittleEndian::Get64(lenField);
+                break;
+            }
+            if (len >= remaining - headBytes)
+                break;
+            p += headBytes + static_cast<size_t>(len);
+        }
+        else
+        {
+            p += headBytes;
+        }
+
+        if (info & kSkipIsContainer)
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(controlByte & kTLVTypeMask);
+        }
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+    mReadPoint     = p;
+    mContainerType = containerType;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -130,6 +130,11 @@ CHIP_ERROR TLVWriter::Finalize()
     return err;
 }
 
+bool TLVWriter::IsRemainingFreeLengthFinal() const
+{
+    return mBackingStore == nullptr || mBackingStore->GetNewBufferWillAlwaysFail();
+}
+
 CHIP_ERROR TLVWriter::ReserveBuffer(uint32_t aBufferSize)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
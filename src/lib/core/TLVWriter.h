@@ -1212,6 +1212,12 @@ public:
      */
     uint32_t GetRemainingFreeLength() const { return mRemainingLen; }
 
+    /**
+     * Returns true if GetRemainingFreeLength() is all the space the writer has left, that is if it is not backed
+     * by a TLVBackingStore that may provide further buffers.
+     */
+    bool IsRemainingFreeLengthFinal() const;
+
     /**
      * @brief Returns true if this TLVWriter was properly initialized.
      */
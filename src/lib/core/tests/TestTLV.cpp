@@ -29,6 +29,7 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVCircularBuffer.h>
+#include <lib/core/TLVCountingWriter.h>
 #include <lib/core/TLVData.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/core/TLVUtilities.h>
@@ -43,6 +44,7 @@
 #include <lib/support/UnitTestUtils.h>
 #include <lib/support/logging/Constants.h>
 
+#include <system/SystemClock.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
 #include <stdlib.h>
@@ -4945,6 +4947,355 @@ static void TestUninitializedWriter(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ *  Backing store that hands out a contiguous encoding in fixed-size chunks, so that elements straddle
+ *  buffer boundaries and the reader has to fall back to its per-element path.
+ */
+class ChunkedTLVBackingStore : public TLVBackingStore
+{
+public:
+    ChunkedTLVBackingStore(const uint8_t * data, uint32_t dataLen, uint32_t chunkLen) :
+        mData(data), mDataLen(dataLen), mChunkLen(chunkLen), mOffset(0)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        mOffset = 0;
+        return GetNextBuffer(reader, bufStart, bufLen);
+    }
+
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData + mOffset;
+        bufLen   = std::min(mChunkLen, mDataLen - mOffset);
+        mOffset += bufLen;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mDataLen;
+    uint32_t mChunkLen;
+    uint32_t mOffset;
+};
+
+/**
+ *  Encode a ReportDataMessage-shaped payload, as produced by a wildcard read: an array of attribute
+ *  reports, each with a data version, a concrete attribute path and attribute data of varying shape.
+ */
+static CHIP_ERROR WriteReportPayload(TLVWriter & writer, uint16_t numReports)
+{
+    const uint8_t serialNumber[16] = { 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE,
+                                       0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF };
+    TLVType reportDataType, reportsType, reportType, attributeDataType, pathType, dataType, entryType;
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, reportDataType));
+    ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(0x12345678)));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Array, reportsType));
+
+    for (uint16_t i = 0; i < numReports; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, reportType));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Structure, attributeDataType));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(0xA0000000u + i)));
+
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_List, pathType));
+        ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint16_t>(i / 32)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint32_t>(0x0028 + (i / 8) % 4)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(4), static_cast<uint32_t>(i % 8)));
+        ReturnErrorOnFailure(writer.EndContainer(pathType));
+
+        switch (i % 4)
+        {
+        case 0:
+            ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint32_t>(i * 1000)));
+            break;
+        case 1:
+            ReturnErrorOnFailure(writer.PutString(ContextTag(2), "Living Room Light"));
+            break;
+        case 2:
+            ReturnErrorOnFailure(writer.Put(ContextTag(2), ByteSpan(serialNumber)));
+            break;
+        default:
+            // List attribute, e.g. a descriptor device type list.
+            ReturnErrorOnFailure(writer.StartContainer(ContextTag(2), kTLVType_Array, dataType));
+            for (uint16_t j = 0; j < 3; j++)
+            {
+                ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, entryType));
+                ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint32_t>(0x0100 + j)));
+                ReturnErrorOnFailure(writer.Put(ContextTag(1), static_cast<uint16_t>(1)));
+                ReturnErrorOnFailure(writer.PutBoolean(ContextTag(2), (j % 2) == 0));
+                ReturnErrorOnFailure(writer.EndContainer(entryType));
+            }
+            ReturnErrorOnFailure(writer.EndContainer(dataType));
+            break;
+        }
+
+        ReturnErrorOnFailure(writer.EndContainer(attributeDataType));
+        ReturnErrorOnFailure(writer.EndContainer(reportType));
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(reportsType));
+    ReturnErrorOnFailure(writer.PutBoolean(ContextTag(3), false));
+    ReturnErrorOnFailure(writer.Put(ContextTag(0xFF), static_cast<uint8_t>(1)));
+    ReturnErrorOnFailure(writer.EndContainer(reportDataType));
+
+    return writer.Finalize();
+}
+
+/**
+ *  Step two readers over the same encoding, skipping the members of the outermost container and then
+ *  that container itself, and check that they agree on every result and read position.
+ */
+static void CheckSkipsMatch(nlTestSuite * inSuite, TLVReader & reader, TLVReader & referenceReader)
+{
+    TLVType outerType, referenceOuterType;
+    CHIP_ERROR err          = reader.Next();
+    CHIP_ERROR referenceErr = referenceReader.Next();
+
+    NL_TEST_ASSERT(inSuite, err == referenceErr);
+    if (err != CHIP_NO_ERROR || !TLVTypeIsContainer(reader.GetType()))
+        return;
+
+    err          = reader.EnterContainer(outerType);
+    referenceErr = referenceReader.EnterContainer(referenceOuterType);
+    NL_TEST_ASSERT(inSuite, err == referenceErr);
+    if (err != CHIP_NO_ERROR)
+        return;
+
+    do
+    {
+        err          = reader.Next();
+        referenceErr = referenceReader.Next();
+        NL_TEST_ASSERT(inSuite, err == referenceErr);
+        NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == referenceReader.GetLengthRead());
+    } while (err == CHIP_NO_ERROR && referenceErr == CHIP_NO_ERROR);
+
+    if (err != CHIP_END_OF_TLV || referenceErr != CHIP_END_OF_TLV)
+        return;
+
+    err          = reader.ExitContainer(outerType);
+    referenceErr = referenceReader.ExitContainer(referenceOuterType);
+    NL_TEST_ASSERT(inSuite, err == referenceErr);
+    NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == referenceReader.GetLengthRead());
+
+    err          = reader.Next();
+    referenceErr = referenceReader.Next();
+    NL_TEST_ASSERT(inSuite, err == referenceErr);
+}
+
+/**
+ *  Test that skipping containers from a contiguous buffer gives the same results as skipping them
+ *  element by element, for both well-formed and corrupted encodings.
+ */
+static void CheckTLVSkipContiguous(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[2048];
+    TLVWriter writer;
+    writer.Init(buf);
+    NL_TEST_ASSERT(inSuite, WriteReportPayload(writer, 24) == CHIP_NO_ERROR);
+    const uint32_t encodingLen = writer.GetLengthWritten();
+
+    // Skipping the whole report lands right after it.
+    {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buf, encodingLen);
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == encodingLen);
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_END_OF_TLV);
+    }
+
+    // Elements following a skipped container are still decoded normally.
+    {
+        ContiguousBufferTLVReader reader;
+        TLVType outerType;
+        bool moreChunks = true;
+        uint8_t revision = 0;
+        reader.Init(buf, encodingLen);
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.EnterContainer(outerType) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(0)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Array, ContextTag(1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Boolean, ContextTag(3)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(moreChunks) == CHIP_NO_ERROR && !moreChunks);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(0xFF)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(revision) == CHIP_NO_ERROR && revision == 1);
+        NL_TEST_ASSERT(inSuite, reader.ExitContainer(outerType) == CHIP_NO_ERROR);
+    }
+
+    // Truncated and corrupted encodings fail the same way whether or not elements straddle buffers. The seed is
+    // fixed so that any failure can be reproduced.
+    uint8_t fuzzedData[sizeof(buf)];
+    srand(0x5EED);
+    for (uint32_t iteration = 0; iteration < 4000; iteration++)
+    {
+        uint32_t fuzzedLen = encodingLen;
+        memcpy(fuzzedData, buf, encodingLen);
+
+        if (iteration < encodingLen)
+        {
+            fuzzedLen = iteration;
+        }
+        else
+        {
+            fuzzedData[static_cast<uint32_t>(rand()) % encodingLen] ^= static_cast<uint8_t>((rand() % 0xFF) + 1);
+        }
+
+        for (uint32_t chunkLen : { 1u, 7u })
+        {
+            ContiguousBufferTLVReader reader;
+            reader.Init(fuzzedData, fuzzedLen);
+
+            ChunkedTLVBackingStore store(fuzzedData, fuzzedLen, chunkLen);
+            TLVReader referenceReader;
+            NL_TEST_ASSERT(inSuite, referenceReader.Init(store, fuzzedLen) == CHIP_NO_ERROR);
+
+            CheckSkipsMatch(inSuite, reader, referenceReader);
+        }
+
+        // A backing store holding more than the reader may read, all in its first buffer, reads as truncated too.
+        {
+            ContiguousBufferTLVReader reader;
+            reader.Init(fuzzedData, fuzzedLen);
+
+            ChunkedTLVBackingStore store(fuzzedData, encodingLen, encodingLen);
+            TLVReader referenceReader;
+            NL_TEST_ASSERT(inSuite, referenceReader.Init(store, fuzzedLen) == CHIP_NO_ERROR);
+
+            CheckSkipsMatch(inSuite, reader, referenceReader);
+        }
+    }
+}
+
+/**
+ *  Test that TlvCountingWriter counts exactly what a TLVWriter would write.
+ */
+static void CheckTLVCountingWriter(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[4096];
+    TLVWriter writer;
+    writer.Init(buf);
+    NL_TEST_ASSERT(inSuite, WriteReportPayload(writer, 48) == CHIP_NO_ERROR);
+
+    {
+        TlvCountingWriter countingWriter;
+        NL_TEST_ASSERT(inSuite, WriteReportPayload(countingWriter, 48) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, countingWriter.GetLengthWritten() == writer.GetLengthWritten());
+    }
+
+    // Counting stops once the limit is exceeded.
+    {
+        TlvCountingWriter countingWriter(writer.GetLengthWritten() - 1);
+        NL_TEST_ASSERT(inSuite, WriteReportPayload(countingWriter, 48) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    }
+    {
+        TlvCountingWriter countingWriter(writer.GetLengthWritten());
+        NL_TEST_ASSERT(inSuite, WriteReportPayload(countingWriter, 48) == CHIP_NO_ERROR);
+    }
+
+    // Strings longer than any internal buffer are counted in full.
+    {
+        TlvCountingWriter countingWriter;
+        NL_TEST_ASSERT(inSuite, countingWriter.PutString(ContextTag(1), sLargeString) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, countingWriter.GetLengthWritten() == 1 + 1 + 2 + strlen(sLargeString));
+    }
+}
+
+/**
+ *  Visit every element below the reader's current position, decoding each one.
+ */
+static CHIP_ERROR WalkElements(TLVReader & reader, uint32_t & count)
+{
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        count++;
+        if (TLVTypeIsContainer(reader.GetType()))
+        {
+            TLVType outerType;
+            ReturnErrorOnFailure(reader.EnterContainer(outerType));
+            ReturnErrorOnFailure(WalkElements(reader, count));
+            ReturnErrorOnFailure(reader.ExitContainer(outerType));
+        }
+    }
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
+/**
+ *  Benchmark parsing of a large wildcard read report: skipping it whole, skipping report by report
+ *  (as a consumer looking for a few paths would), and decoding every element.
+ */
+static void BenchmarkTLVReportParsing(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kNumReports = 256;
+    constexpr uint32_t kIterations = 500;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> buf;
+    NL_TEST_ASSERT(inSuite, buf.Alloc(32768));
+    TLVWriter writer;
+    writer.Init(buf.Get(), 32768);
+    NL_TEST_ASSERT(inSuite, WriteReportPayload(writer, kNumReports) == CHIP_NO_ERROR);
+    const uint32_t encodingLen = writer.GetLengthWritten();
+
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buf.Get(), encodingLen);
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Skip() == CHIP_NO_ERROR);
+    }
+    const uint64_t skipWholeMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        ContiguousBufferTLVReader reader;
+        TLVType reportDataType, reportsType;
+        uint32_t reports = 0;
+        reader.Init(buf.Get(), encodingLen);
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.EnterContainer(reportDataType) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(0)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Array, ContextTag(1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.EnterContainer(reportsType) == CHIP_NO_ERROR);
+        while (reader.Next() == CHIP_NO_ERROR)
+            reports++;
+        NL_TEST_ASSERT(inSuite, reports == kNumReports);
+        NL_TEST_ASSERT(inSuite, reader.ExitContainer(reportsType) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.ExitContainer(reportDataType) == CHIP_NO_ERROR);
+    }
+    const uint64_t skipReportsMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    uint32_t elements = 0;
+    start             = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kIterations; i++)
+    {
+        ContiguousBufferTLVReader reader;
+        reader.Init(buf.Get(), encodingLen);
+        elements = 0;
+        NL_TEST_ASSERT(inSuite, WalkElements(reader, elements) == CHIP_NO_ERROR);
+    }
+    const uint64_t walkMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    printf("TLV report parsing: %u reports, %u elements, %u bytes, %u iterations\n", static_cast<unsigned>(kNumReports),
+           static_cast<unsigned>(elements), static_cast<unsigned>(encodingLen), static_cast<unsigned>(kIterations));
+    printf("  skip whole report:   %8llu us\n", static_cast<unsigned long long>(skipWholeMicros));
+    printf("  skip each report:    %8llu us\n", static_cast<unsigned long long>(skipReportsMicros));
+    printf("  decode all elements: %8llu us\n", static_cast<unsigned long long>(walkMicros));
+}
+
 // Test Suite
 
 /**
@@ -4984,6 +5335,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV GetByteView Test",           CheckGetByteView),
     NL_TEST_DEF("Int Min/Max Test",                    TestIntMinMax),
     NL_TEST_DEF("Uninitialized Writer Test",           TestUninitializedWriter),
+    NL_TEST_DEF("CHIP TLV Skip contiguous",            CheckTLVSkipContiguous),
+    NL_TEST_DEF("CHIP TLV Counting Writer",            CheckTLVCountingWriter),
+    NL_TEST_DEF("CHIP TLV Report Parsing Benchmark",   BenchmarkTLVReportParsing),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,212 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <utility>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+
+template <typename T, typename Compare>
+class IntrusiveHeap;
+
+class IntrusiveHeapNodeBase
+{
+public:
+    IntrusiveHeapNodeBase() = default;
+    ~IntrusiveHeapNodeBase() { VerifyOrDie(!IsInHeap()); }
+
+    // Note: The copy construct/assignment is not provided because the heap node state is not copyable.
+    //       The move construct/assignment is not provided because all modifications to the heap shall go through the heap object.
+    IntrusiveHeapNodeBase(const IntrusiveHeapNodeBase &)             = delete;
+    IntrusiveHeapNodeBase & operator=(const IntrusiveHeapNodeBase &) = delete;
+    IntrusiveHeapNodeBase(IntrusiveHeapNodeBase &&)                  = delete;
+    IntrusiveHeapNodeBase & operator=(IntrusiveHeapNodeBase &&)      = delete;
+
+    bool IsInHeap() const { return mPrev != nullptr; }
+
+private:
+    template <typename T, typename Compare>
+    friend class IntrusiveHeap;
+
+    IntrusiveHeapNodeBase * mChild = nullptr; // First child.
+    IntrusiveHeapNodeBase * mNext  = nullptr; // Next sibling.
+    IntrusiveHeapNodeBase * mPrev  = nullptr; // Previous sibling, or parent for a first child, or the node itself for the root.
+};
+
+/**
+ * @brief A priority queue of objects which embed their own links (pairing heap).
+ *
+ * T must derive from IntrusiveHeapNodeBase. Compare is a default-constructible functor returning
+ * true if its first argument orders before its second; Top() is an element which no other element
+ * orders before.
+ *
+ * Push() and Top() take constant time. Pop(), Remove() and Update() take amortized logarithmic time.
+ * A node may only belong to a single heap. The code will assert (via VerifyOrDie) on this invariant.
+ */
+template <typename T, typename Compare>
+class IntrusiveHeap
+{
+public:
+    IntrusiveHeap() = default;
+    ~IntrusiveHeap() { VerifyOrDie(Empty()); }
+
+    IntrusiveHeap(const IntrusiveHeap &)             = delete;
+    IntrusiveHeap & operator=(const IntrusiveHeap &) = delete;
+
+    bool Empty() const { return mRoot == nullptr; }
+
+    T * Top() const { return static_cast<T *>(mRoot); }
+
+    void Push(T * value)
+    {
+        Node * node = value;
+        VerifyOrDie(!node->IsInHeap());
+        node->mPrev = node;
+        mRoot       = Empty() ? node : Meld(mRoot, node);
+    }
+
+    T * Pop()
+    {
+        T * top = Top();
+        if (top != nullptr)
+        {
+            Remove(top);
+        }
+        return top;
+    }
+
+    void Remove(T * value)
+    {
+        Node * node = value;
+        VerifyOrDie(node->IsInHeap());
+
+        if (node == mRoot)
+        {
+            mRoot = MergePairs(node->mChild);
+        }
+        else
+        {
+            Node * prev = node->mPrev;
+            if (prev->mChild == node)
+            {
+                prev->mChild = node->mNext;
+            }
+            else
+            {
+                prev->mNext = node->mNext;
+            }
+            if (node->mNext != nullptr)
+            {
+                node->mNext->mPrev = prev;
+            }
+
+            Node * children = MergePairs(node->mChild);
+            if (children != nullptr)
+            {
+                mRoot = Meld(mRoot, children);
+            }
+        }
+
+        node->mChild = nullptr;
+        node->mNext  = nullptr;
+        node->mPrev  = nullptr;
+    }
+
+    /**
+     * Restore the heap order after the key of an element in the heap has changed.
+     */
+    void Update(T * value)
+    {
+        Remove(value);
+        Push(value);
+    }
+
+private:
+    using Node = IntrusiveHeapNodeBase;
+
+    static bool OrdersBefore(const Node * a, const Node * b)
+    {
+        return Compare()(*static_cast<const T *>(a), *static_cast<const T *>(b));
+    }
+
+    // Link two trees, making the root which orders later the first child of the other, and return the new root.
+    // On equal keys `a` stays the root.
+    static Node * Meld(Node * a, Node * b)
+    {
+        if (OrdersBefore(b, a))
+        {
+            std::swap(a, b);
+        }
+
+        b->mPrev = a;
+        b->mNext = a->mChild;
+        if (a->mChild != nullptr)
+        {
+            a->mChild->mPrev = b;
+        }
+        a->mChild = b;
+        a->mNext  = nullptr;
+        a->mPrev  = a;
+        return a;
+    }
+
+    // Combine a list of sibling trees into one tree: meld them pairwise from the left, then meld the
+    // results from the right. This is what bounds the amortized cost of removal.
+    static Node * MergePairs(Node * first)
+    {
+        VerifyOrReturnValue(first != nullptr, nullptr);
+
+        // First pass, building the list of pairs in reverse order.
+        Node * pairs = nullptr;
+        while (first != nullptr)
+        {
+            Node * a = first;
+            Node * b = a->mNext;
+            if (b == nullptr)
+            {
+                a->mNext = pairs;
+                pairs    = a;
+                break;
+            }
+            first = b->mNext;
+
+            Node * pair = Meld(a, b);
+            pair->mNext = pairs;
+            pairs       = pair;
+        }
+
+        // Second pass.
+        Node * result = pairs;
+        pairs         = pairs->mNext;
+        while (pairs != nullptr)
+        {
+            Node * next = pairs->mNext;
+            result      = Meld(result, pairs);
+            pairs       = next;
+        }
+
+        result->mNext = nullptr;
+        result->mPrev = result;
+        return result;
+    }
+
+    Node * mRoot = nullptr;
+};
+
+} // namespace chip
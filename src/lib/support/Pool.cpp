@@ -225,6 +225,167 @@ void HeapObjectList::CleanupDeferredReleases()
     mHaveDeferredNodeRemovals = false;
 }
 
+SlabAllocator::SlabAllocator(size_t slabCapacity, size_t elementSize, size_t elementAlignment) :
+    mSlabCapacity(slabCapacity), mElementSize(elementSize),
+    mElementsOffset((sizeof(Slab) + elementAlignment - 1) / elementAlignment * elementAlignment),
+    mFullMask((slabCapacity == kBitChunkSize) ? ~tBitChunkType(0) : ((kBit1 << slabCapacity) - 1))
+{
+    VerifyOrDie(slabCapacity > 0 && slabCapacity <= kBitChunkSize);
+}
+
+SlabAllocator::~SlabAllocator()
+{
+    // Slabs that still hold objects are deliberately leaked, as HeapObjectPool does with its objects.
+    if (Allocated() != 0)
+    {
+        return;
+    }
+
+    while (mSlabs != nullptr)
+    {
+        Slab * next = mSlabs->mNext;
+        Platform::MemoryFree(mSlabs);
+        mSlabs = next;
+    }
+}
+
+void * SlabAllocator::Allocate()
+{
+    Slab * slab = mSlabs;
+    while (slab != nullptr && slab->mUsage == mFullMask)
+    {
+        slab = slab->mNext;
+    }
+
+    if (slab == nullptr)
+    {
+        slab = static_cast<Slab *>(Platform::MemoryAlloc(mElementsOffset + mSlabCapacity * mElementSize));
+        if (slab == nullptr)
+        {
+            return nullptr;
+        }
+        slab->mNext  = nullptr;
+        slab->mUsage = 0;
+        if (mLastSlab == nullptr)
+        {
+            mSlabs = slab;
+        }
+        else
+        {
+            mLastSlab->mNext = slab;
+        }
+        mLastSlab = slab;
+        if (++mSlabCount > mSlabHighWaterMark)
+        {
+            mSlabHighWaterMark = mSlabCount;
+        }
+    }
+
+    size_t offset = 0;
+    while ((slab->mUsage & (kBit1 << offset)) != 0)
+    {
+        ++offset;
+    }
+    slab->mUsage |= kBit1 << offset;
+    IncreaseUsage();
+    return At(slab, offset);
+}
+
+void SlabAllocator::Deallocate(void * element)
+{
+    uint8_t * const object = static_cast<uint8_t *>(element);
+    Slab * slab            = mSlabs;
+    while (slab != nullptr && (object < At(slab, 0) || object >= At(slab, mSlabCapacity)))
+    {
+        slab = slab->mNext;
+    }
+
+    // Releasing an object that is not in the pool indicates likely memory
+    // corruption; better to safe-crash than proceed at this point.
+    VerifyOrDie(slab != nullptr);
+    std::ptrdiff_t diff = object - At(slab, 0);
+    VerifyOrDie(static_cast<size_t>(diff) % mElementSize == 0);
+    size_t offset = static_cast<size_t>(diff) / mElementSize;
+
+    VerifyOrDie((slab->mUsage & (kBit1 << offset)) != 0); // assert fail when free an unused slot
+    slab->mUsage &= ~(kBit1 << offset);
+    DecreaseUsage();
+
+    if (slab->mUsage == 0 && slab != mSlabs)
+    {
+        mHaveEmptySlabs = true;
+        ReleaseEmptySlabs();
+    }
+}
+
+void SlabAllocator::SeekActive(Slab *& slab, size_t & index) const
+{
+    while (slab != nullptr)
+    {
+        for (; index < mSlabCapacity; ++index)
+        {
+            if ((slab->mUsage & (kBit1 << index)) != 0)
+            {
+                return;
+            }
+        }
+        slab  = slab->mNext;
+        index = 0;
+    }
+}
+
+Loop SlabAllocator::ForEachActiveObjectInner(void * context, Lambda lambda)
+{
+    BeginIteration();
+    Loop result = Loop::Finish;
+    for (Slab * slab = mSlabs; slab != nullptr && result == Loop::Finish; slab = slab->mNext)
+    {
+        for (size_t offset = 0; offset < mSlabCapacity; ++offset)
+        {
+            // Re-read the usage for every element, since the lambda may release objects.
+            if ((slab->mUsage & (kBit1 << offset)) != 0 && lambda(context, At(slab, offset)) == Loop::Break)
+            {
+                result = Loop::Break;
+                break;
+            }
+        }
+    }
+    EndIteration();
+    return result;
+}
+
+void SlabAllocator::ReleaseEmptySlabs()
+{
+    if (mIterationDepth != 0 || !mHaveEmptySlabs)
+    {
+        return;
+    }
+
+    // The first slab is kept even when empty, so that a pool hovering around a slab boundary does not keep
+    // allocating and freeing slabs.
+    Slab * previous = mSlabs;
+    while (previous != nullptr && previous->mNext != nullptr)
+    {
+        Slab * slab = previous->mNext;
+        if (slab->mUsage == 0)
+        {
+            previous->mNext = slab->mNext;
+            if (mLastSlab == slab)
+            {
+                mLastSlab = previous;
+            }
+            Platform::MemoryFree(slab);
+            --mSlabCount;
+        }
+        else
+        {
+            previous = slab;
+        }
+    }
+
+    mHaveEmptySlabs = false;
+}
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace internal
@@ -29,6 +29,7 @@
 #include <lib/support/Iterators.h>
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
@@ -39,6 +40,11 @@ namespace chip {
 template <class T>
 class BitmapActiveObjectIterator;
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+template <class T>
+class SlabActiveObjectIterator;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 namespace internal {
 
 class Statistics
@@ -182,6 +188,80 @@ struct HeapObjectList : HeapObjectListNode
     bool mHaveDeferredNodeRemovals = false;
 };
 
+class SlabAllocator : public Statistics
+{
+protected:
+    using tBitChunkType                         = unsigned long;
+    static constexpr const tBitChunkType kBit1  = 1; // make sure bitshifts produce the right type
+    static constexpr const size_t kBitChunkSize = std::numeric_limits<tBitChunkType>::digits;
+
+    /// Header of a slab. The slab's elements follow it in the same heap block.
+    struct Slab
+    {
+        Slab * mNext;
+        tBitChunkType mUsage; ///< One bit per element, set while the element is allocated.
+    };
+
+public:
+    SlabAllocator(size_t slabCapacity, size_t elementSize, size_t elementAlignment);
+    ~SlabAllocator();
+
+    size_t Capacity() const { return SIZE_MAX; }
+    bool Exhausted() const { return false; }
+
+    /// Number of slabs currently allocated, and the most that have been allocated at once.
+    size_t SlabCount() const { return mSlabCount; }
+    size_t SlabHighWaterMark() const { return mSlabHighWaterMark; }
+
+protected:
+    void * Allocate();
+    void Deallocate(void * element);
+    uint8_t * At(Slab * slab, size_t index) const
+    {
+        return reinterpret_cast<uint8_t *>(slab) + mElementsOffset + mElementSize * index;
+    }
+
+    /// Moves (slab, index) forward to the first active element at or after it, following the slab list.
+    ///
+    /// slab is set to nullptr if there is no such element.
+    void SeekActive(Slab *& slab, size_t & index) const;
+
+    using Lambda = Loop (*)(void * context, void * object);
+    Loop ForEachActiveObjectInner(void * context, Lambda lambda);
+    Loop ForEachActiveObjectInner(void * context, Loop lambda(void * context, const void * object)) const
+    {
+        return const_cast<SlabAllocator *>(this)->ForEachActiveObjectInner(context, reinterpret_cast<Lambda>(lambda));
+    }
+
+    /// Slabs are only freed while no iteration is active, so that releasing objects during iteration is safe.
+    void BeginIteration() { ++mIterationDepth; }
+    void EndIteration()
+    {
+        --mIterationDepth;
+        ReleaseEmptySlabs();
+    }
+
+    Slab * mSlabs = nullptr;
+
+private:
+    /// Frees every empty slab except the first one, IFF iteration depth is 0
+    void ReleaseEmptySlabs();
+
+    const size_t mSlabCapacity;
+    const size_t mElementSize;
+    const size_t mElementsOffset;
+    const tBitChunkType mFullMask;
+    Slab * mLastSlab          = nullptr;
+    size_t mSlabCount         = 0;
+    size_t mSlabHighWaterMark = 0;
+    size_t mIterationDepth    = 0;
+    bool mHaveEmptySlabs      = false;
+
+    /// allow iterators to walk the slabs and hold off slab release
+    template <class T>
+    friend class ::chip::SlabActiveObjectIterator;
+};
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace internal
@@ -580,6 +660,174 @@ private:
     internal::HeapObjectList mObjects;
 };
 
+/// Provides iteration over active objects in a slab pool.
+///
+/// As for HeapObjectPool, objects may be released while an iterator exists; freeing of the slabs that
+/// become empty is deferred until the last active iterator is destroyed.
+template <class T>
+class SlabActiveObjectIterator
+{
+public:
+    using value_type = T;
+    using pointer    = T *;
+    using reference  = T &;
+
+    SlabActiveObjectIterator() {}
+    SlabActiveObjectIterator(internal::SlabAllocator * pool, internal::SlabAllocator::Slab * slab) : mPool(pool), mSlab(slab)
+    {
+        mPool->BeginIteration();
+        mPool->SeekActive(mSlab, mIndex);
+    }
+    SlabActiveObjectIterator(const SlabActiveObjectIterator & other) :
+        mPool(other.mPool), mSlab(other.mSlab), mIndex(other.mIndex)
+    {
+        if (mPool != nullptr)
+        {
+            mPool->BeginIteration();
+        }
+    }
+
+    SlabActiveObjectIterator & operator=(const SlabActiveObjectIterator & other)
+    {
+        if (other.mPool != nullptr)
+        {
+            other.mPool->BeginIteration();
+        }
+        if (mPool != nullptr)
+        {
+            mPool->EndIteration();
+        }
+        mPool  = other.mPool;
+        mSlab  = other.mSlab;
+        mIndex = other.mIndex;
+        return *this;
+    }
+
+    ~SlabActiveObjectIterator()
+    {
+        if (mPool != nullptr)
+        {
+            mPool->EndIteration();
+        }
+    }
+
+    bool operator==(const SlabActiveObjectIterator & other) const
+    {
+        // All end iterators compare equal, including a default-constructed one.
+        return (mSlab == other.mSlab) && ((mSlab == nullptr) || (mIndex == other.mIndex));
+    }
+    bool operator!=(const SlabActiveObjectIterator & other) const { return !(*this == other); }
+    SlabActiveObjectIterator & operator++()
+    {
+        ++mIndex;
+        mPool->SeekActive(mSlab, mIndex);
+        return *this;
+    }
+    T * operator*() const { return reinterpret_cast<T *>(mPool->At(mSlab, mIndex)); }
+
+private:
+    internal::SlabAllocator * mPool       = nullptr; // pool that this belongs to
+    internal::SlabAllocator::Slab * mSlab = nullptr; // nullptr at the end
+    size_t mIndex                         = 0;
+};
+
+/**
+ * A class template used for allocating objects from the heap in slabs of contiguous objects.
+ *
+ * The pool grows by one slab at a time and has no fixed limit. Each slab holds up to N objects (at most one bitmap
+ * word's worth) and keeps a usage bitmap, so iteration walks the objects in memory order instead of chasing one list
+ * node per object as HeapObjectPool does. Empty slabs other than the first are returned to the heap once no iteration
+ * is in progress.
+ *
+ *  @tparam     T   type to be allocated.
+ *  @tparam     N   number of objects per slab.
+ */
+template <class T, size_t N>
+class SlabObjectPool : public internal::SlabAllocator, public HeapObjectPoolExitHandling
+{
+public:
+    static constexpr size_t kSlabCapacity = (N == 0) ? 1 : ((N < kBitChunkSize) ? N : kBitChunkSize);
+    static_assert(alignof(T) <= alignof(std::max_align_t), "SlabObjectPool does not support over-aligned types");
+
+    SlabObjectPool() : SlabAllocator(kSlabCapacity, sizeof(T), alignof(T)) {}
+    ~SlabObjectPool()
+    {
+#if __SANITIZE_ADDRESS__
+        // Free all remaining objects so that ASAN can catch specific use-after-free cases.
+        ReleaseAll();
+#else  // __SANITIZE_ADDRESS__
+        if (!sIgnoringLeaksOnExit)
+        {
+            // Verify that no live objects remain, to prevent potential use-after-free.
+            VerifyOrDie(Allocated() == 0);
+        }
+#endif // __SANITIZE_ADDRESS__
+    }
+
+    using ActiveObjectIterator = SlabActiveObjectIterator<T>;
+
+    ActiveObjectIterator begin() { return ActiveObjectIterator(this, mSlabs); }
+    ActiveObjectIterator end() { return ActiveObjectIterator(this, nullptr); }
+
+    template <typename... Args>
+    T * CreateObject(Args &&... args)
+    {
+        T * element = static_cast<T *>(Allocate());
+        if (element != nullptr)
+            return new (element) T(std::forward<Args>(args)...);
+        return nullptr;
+    }
+
+    void ReleaseObject(T * element)
+    {
+        if (element == nullptr)
+            return;
+
+        element->~T();
+        Deallocate(element);
+    }
+
+    void ReleaseAll() { ForEachActiveObjectInner(this, ReleaseObject); }
+
+    /**
+     * @brief
+     *   Run a functor for each active object in the pool
+     *
+     *  @param     function A functor of type `Loop (*)(T*)`.
+     *                      Return Loop::Break to break the iteration.
+     *                      The only modification the functor is allowed to make
+     *                      to the pool before returning is releasing the
+     *                      object that was passed to the functor.  Any other
+     *                      desired changes need to be made after iteration
+     *                      completes.
+     *  @return    Loop     Returns Break if some call to the functor returned
+     *                      Break.  Otherwise returns Finish.
+     */
+    template <typename Function>
+    Loop ForEachActiveObject(Function && function)
+    {
+        static_assert(std::is_same<Loop, decltype(function(std::declval<T *>()))>::value,
+                      "The function must take T* and return Loop");
+        internal::LambdaProxy<T, Function> proxy(std::forward<Function>(function));
+        return ForEachActiveObjectInner(&proxy, &internal::LambdaProxy<T, Function>::Call);
+    }
+    template <typename Function>
+    Loop ForEachActiveObject(Function && function) const
+    {
+        static_assert(std::is_same<Loop, decltype(function(std::declval<const T *>()))>::value,
+                      "The function must take const T* and return Loop");
+        internal::LambdaProxy<const T, Function> proxy(std::forward<Function>(function));
+        return ForEachActiveObjectInner(&proxy, &internal::LambdaProxy<const T, Function>::ConstCall);
+    }
+
+private:
+    static Loop ReleaseObject(void * context, void * object)
+    {
+        static_cast<SlabObjectPool *>(context)->ReleaseObject(static_cast<T *>(object));
+        return Loop::Continue;
+    }
+};
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 /**
@@ -598,7 +846,17 @@ enum class ObjectPoolMem
      * For this case, the ObjectPool size parameter is ignored.
      */
     kHeap,
+    /**
+     * Allocate objects from the heap in slabs of contiguous objects, with only pool management state in the containing scope.
+     *
+     * For this case, the ObjectPool size parameter is the number of objects per slab (see SlabObjectPool).
+     */
+    kSlab,
+#if CHIP_SYSTEM_CONFIG_POOL_USE_SLAB
+    kDefault = kSlab
+#else  // CHIP_SYSTEM_CONFIG_POOL_USE_SLAB
     kDefault = kHeap
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_SLAB
 #else  // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     kDefault = kInline
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -633,6 +891,17 @@ template <typename T, size_t N>
 class ObjectPool<T, N, ObjectPoolMem::kHeap> : public HeapObjectPool<T>
 {
 };
+
+template <typename T>
+struct ObjectPoolIterator<T, ObjectPoolMem::kSlab>
+{
+    using Type = SlabActiveObjectIterator<T>;
+};
+
+template <typename T, size_t N>
+class ObjectPool<T, N, ObjectPoolMem::kSlab> : public SlabObjectPool<T, N>
+{
+};
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace chip
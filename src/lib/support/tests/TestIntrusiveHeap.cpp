@@ -0,0 +1,185 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ctime>
+#include <set>
+
+#include <lib/support/IntrusiveHeap.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+
+class HeapNode : public IntrusiveHeapNodeBase
+{
+public:
+    int mKey = 0;
+};
+
+struct HeapNodeOrder
+{
+    bool operator()(const HeapNode & a, const HeapNode & b) const { return a.mKey < b.mKey; }
+};
+
+using Heap = IntrusiveHeap<HeapNode, HeapNodeOrder>;
+
+void TestIntrusiveHeapRandom(nlTestSuite * inSuite, void * inContext)
+{
+    Heap h1;
+    HeapNode node[100];
+    std::multiset<int> h2;
+
+    auto pick = [&](bool inHeap) -> HeapNode * {
+        size_t start = static_cast<size_t>(std::rand()) % ArraySize(node);
+        for (size_t i = 0; i < ArraySize(node); ++i)
+        {
+            HeapNode & n = node[(start + i) % ArraySize(node)];
+            if (n.IsInHeap() == inHeap)
+            {
+                return &n;
+            }
+        }
+        return nullptr;
+    };
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        HeapNode * n;
+        switch (std::rand() % 4)
+        {
+        case 0: // Push
+            if ((n = pick(false)) != nullptr)
+            {
+                n->mKey = std::rand() % 50;
+                h1.Push(n);
+                h2.insert(n->mKey);
+            }
+            break;
+        case 1: // Pop
+            if (!h2.empty())
+            {
+                n = h1.Pop();
+                NL_TEST_ASSERT(inSuite, n != nullptr && !n->IsInHeap());
+                NL_TEST_ASSERT(inSuite, n->mKey == *h2.begin());
+                h2.erase(h2.begin());
+            }
+            break;
+        case 2: // Remove
+            if ((n = pick(true)) != nullptr)
+            {
+                h1.Remove(n);
+                NL_TEST_ASSERT(inSuite, !n->IsInHeap());
+                h2.erase(h2.find(n->mKey));
+            }
+            break;
+        case 3: // Update
+            if ((n = pick(true)) != nullptr)
+            {
+                h2.erase(h2.find(n->mKey));
+                n->mKey = std::rand() % 50;
+                h1.Update(n);
+                h2.insert(n->mKey);
+            }
+            break;
+        }
+
+        NL_TEST_ASSERT(inSuite, h1.Empty() == h2.empty());
+        NL_TEST_ASSERT(inSuite, h1.Empty() || h1.Top()->mKey == *h2.begin());
+    }
+
+    while (!h1.Empty())
+    {
+        NL_TEST_ASSERT(inSuite, h1.Pop()->mKey == *h2.begin());
+        h2.erase(h2.begin());
+    }
+    NL_TEST_ASSERT(inSuite, h2.empty());
+}
+
+void TestOrder(nlTestSuite * inSuite, void * inContext)
+{
+    Heap heap;
+    HeapNode a, b, c;
+    a.mKey = 2;
+    b.mKey = 1;
+    c.mKey = 3;
+
+    NL_TEST_ASSERT(inSuite, heap.Empty());
+    NL_TEST_ASSERT(inSuite, heap.Top() == nullptr);
+    NL_TEST_ASSERT(inSuite, heap.Pop() == nullptr);
+
+    heap.Push(&a);
+    heap.Push(&b);
+    heap.Push(&c);
+    NL_TEST_ASSERT(inSuite, a.IsInHeap() && b.IsInHeap() && c.IsInHeap());
+    NL_TEST_ASSERT(inSuite, heap.Top() == &b);
+
+    // Move the top to the back.
+    b.mKey = 4;
+    heap.Update(&b);
+    NL_TEST_ASSERT(inSuite, heap.Top() == &a);
+
+    // Move a node from the back to the top.
+    c.mKey = 0;
+    heap.Update(&c);
+    NL_TEST_ASSERT(inSuite, heap.Top() == &c);
+
+    heap.Remove(&a);
+    NL_TEST_ASSERT(inSuite, !a.IsInHeap());
+    NL_TEST_ASSERT(inSuite, heap.Pop() == &c);
+    NL_TEST_ASSERT(inSuite, heap.Pop() == &b);
+    NL_TEST_ASSERT(inSuite, heap.Empty());
+}
+
+int Setup(void * inContext)
+{
+    return SUCCESS;
+}
+
+int Teardown(void * inContext)
+{
+    return SUCCESS;
+}
+
+} // namespace
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF_FN(TestIntrusiveHeapRandom), //
+    NL_TEST_DEF_FN(TestOrder),               //
+    NL_TEST_SENTINEL(),                      //
+};
+
+int TestIntrusiveHeap()
+{
+    nlTestSuite theSuite = { "CHIP IntrusiveHeap tests", &sTests[0], Setup, Teardown };
+
+    unsigned seed = static_cast<unsigned>(std::time(nullptr));
+    printf("Running " __FILE__ " using seed %d", seed);
+    std::srand(seed);
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIntrusiveHeap);
@@ -28,6 +28,7 @@
 #include <lib/support/Pool.h>
 #include <lib/support/PoolWrapper.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
 #include <system/SystemConfig.h>
 
 #include <nlunit-test.h>
@@ -70,6 +71,11 @@ void TestReleaseNullDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestReleaseNull<uint32_t, 10, ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestReleaseNullSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestReleaseNull<uint32_t, 10, ObjectPoolMem::kSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <typename T, size_t N, ObjectPoolMem P>
@@ -209,6 +215,11 @@ void TestCreateReleaseStructDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestCreateReleaseStruct<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestCreateReleaseStructSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestCreateReleaseStruct<ObjectPoolMem::kSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <ObjectPoolMem P>
@@ -474,6 +485,11 @@ void TestForEachActiveObjectDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestForEachActiveObject<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestForEachActiveObjectSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestForEachActiveObject<ObjectPoolMem::kSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <ObjectPoolMem P>
@@ -537,6 +553,132 @@ void TestPoolInterfaceDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestPoolInterface<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestPoolInterfaceSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestPoolInterface<ObjectPoolMem::kSlab>(inSuite, inContext);
+}
+
+void TestSlabGrowth(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kSlabSize = 4;
+    constexpr size_t kCount    = 10;
+    ObjectPool<uint32_t, kSlabSize, ObjectPoolMem::kSlab> pool;
+    uint32_t * obj[kCount];
+
+    // The pool grows a slab at a time past its nominal size, and objects within a slab are contiguous.
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        obj[i] = pool.CreateObject(static_cast<uint32_t>(i));
+        NL_TEST_ASSERT(inSuite, obj[i] != nullptr);
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == kCount);
+    NL_TEST_ASSERT(inSuite, !pool.Exhausted());
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 3);
+    NL_TEST_ASSERT(inSuite, pool.SlabHighWaterMark() == 3);
+    for (size_t i = 1; i < kSlabSize; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, obj[i] == obj[0] + i);
+    }
+
+    // Iteration visits the objects in memory order.
+    uint32_t expected = 0;
+    for (auto object : pool)
+    {
+        NL_TEST_ASSERT(inSuite, *object == expected++);
+    }
+    NL_TEST_ASSERT(inSuite, expected == kCount);
+
+    // A slab that becomes empty is freed.
+    for (size_t i = kSlabSize; i < 2 * kSlabSize; ++i)
+    {
+        pool.ReleaseObject(obj[i]);
+    }
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 2);
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == kCount - kSlabSize);
+
+    // Freeing slabs is deferred while iterating, and the first slab is kept.
+    pool.ForEachActiveObject([&](uint32_t * object) {
+        pool.ReleaseObject(object);
+        NL_TEST_ASSERT(inSuite, pool.SlabCount() == 2);
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 1);
+    NL_TEST_ASSERT(inSuite, pool.SlabHighWaterMark() == 3);
+    NL_TEST_ASSERT(inSuite, pool.HighWaterMark() == kCount);
+
+    obj[0] = pool.CreateObject(0u);
+    NL_TEST_ASSERT(inSuite, pool.SlabCount() == 1);
+    pool.ReleaseAll();
+}
+
+// Mimics the exchange manager: a handful of live exchanges, each received message looked up by
+// walking the pool, and exchanges opened and closed continuously.
+template <ObjectPoolMem P>
+uint64_t RunExchangeWorkload(nlTestSuite * inSuite)
+{
+    struct Exchange
+    {
+        Exchange(uint16_t id) : mId(id) {}
+        uint16_t mId;
+        uint8_t mState[200];
+    };
+
+    constexpr size_t kPoolSize        = 64;
+    constexpr uint16_t kLiveExchanges = 12;
+    constexpr uint16_t kRounds        = 20000;
+
+    ObjectPool<Exchange, kPoolSize, P> pool;
+    size_t found = 0;
+
+    auto deliver = [&](uint16_t id) {
+        pool.ForEachActiveObject([&](Exchange * exchange) {
+            if (exchange->mId != id)
+            {
+                return Loop::Continue;
+            }
+            ++found;
+            return Loop::Break;
+        });
+    };
+
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint16_t id = 0; id < kRounds; ++id)
+    {
+        NL_TEST_ASSERT(inSuite, pool.CreateObject(id) != nullptr);
+        deliver(id);
+        if (id >= kLiveExchanges)
+        {
+            const uint16_t oldest = static_cast<uint16_t>(id - kLiveExchanges);
+            deliver(oldest);
+            pool.ForEachActiveObject([&](Exchange * exchange) {
+                if (exchange->mId != oldest)
+                {
+                    return Loop::Continue;
+                }
+                pool.ReleaseObject(exchange);
+                return Loop::Break;
+            });
+        }
+    }
+    uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    NL_TEST_ASSERT(inSuite, found == 2 * kRounds - kLiveExchanges);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == kLiveExchanges);
+    pool.ReleaseAll();
+    return elapsedUs;
+}
+
+void BenchmarkExchangeWorkload(nlTestSuite * inSuite, void * inContext)
+{
+    const uint64_t inlineUs = RunExchangeWorkload<ObjectPoolMem::kInline>(inSuite);
+    const uint64_t heapUs   = RunExchangeWorkload<ObjectPoolMem::kHeap>(inSuite);
+    const uint64_t slabUs   = RunExchangeWorkload<ObjectPoolMem::kSlab>(inSuite);
+
+    printf("exchange workload: inline %u us, heap %u us, slab %u us\n", static_cast<unsigned int>(inlineUs),
+           static_cast<unsigned int>(heapUs), static_cast<unsigned int>(slabUs));
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 int Setup(void * inContext)
@@ -569,6 +711,12 @@ static const nlTest sTests[] = {
     NL_TEST_DEF_FN(TestCreateReleaseStructDynamic),
     NL_TEST_DEF_FN(TestForEachActiveObjectDynamic),
     NL_TEST_DEF_FN(TestPoolInterfaceDynamic),
+    NL_TEST_DEF_FN(TestReleaseNullSlab),
+    NL_TEST_DEF_FN(TestCreateReleaseStructSlab),
+    NL_TEST_DEF_FN(TestForEachActiveObjectSlab),
+    NL_TEST_DEF_FN(TestPoolInterfaceSlab),
+    NL_TEST_DEF_FN(TestSlabGrowth),
+    NL_TEST_DEF_FN(BenchmarkExchangeWorkload),
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     NL_TEST_SENTINEL()
     // clang-format on
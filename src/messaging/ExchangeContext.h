@@ -256,6 +256,8 @@ private:
     ExchangeSessionHolder mSession; // The connection state
     uint16_t mExchangeId;           // Assigned exchange ID.
 
+    ExchangeContext * mNextInExchangeIndex = nullptr; // Next exchange in the same ExchangeManager index bucket.
+
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
      *  message had the kExpectResponse flag set in its sendFlags).
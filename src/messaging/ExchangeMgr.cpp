@@ -74,6 +74,7 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
         // then re-initializes without removing registered handlers.
         handler.Reset();
     }
+    memset(UMHandlerIndex, kNoUMHandler, sizeof(UMHandlerIndex));
 
     sessionManager->SetMessageDelegate(this);
 
@@ -107,7 +108,7 @@ ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, Exc
         ChipLogError(ExchangeManager, "NewContext failed: session inactive");
         return nullptr;
     }
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, isInitiator, delegate);
+    return AllocateContext(mNextExchangeId++, session, isInitiator, delegate);
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
@@ -134,47 +135,119 @@ CHIP_ERROR ExchangeManager::UnregisterUnsolicitedMessageHandlerForType(Protocols
 
 CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
 {
-    UnsolicitedMessageHandlerSlot * selected = nullptr;
+    size_t slot = FindUMHandlerIndexSlot(protocolId, msgType);
+    if (UMHandlerIndex[slot] != kNoUMHandler)
+    {
+        UMHandlerPool[UMHandlerIndex[slot]].Handler = handler;
+        return CHIP_NO_ERROR;
+    }
 
-    for (auto & umh : UMHandlerPool)
+    for (uint8_t i = 0; i < CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; ++i)
     {
+        UnsolicitedMessageHandlerSlot & umh = UMHandlerPool[i];
         if (!umh.IsInUse())
         {
-            if (selected == nullptr)
-                selected = &umh;
-        }
-        else if (umh.Matches(protocolId, msgType))
-        {
-            umh.Handler = handler;
+            umh.Handler          = handler;
+            umh.ProtocolId       = protocolId;
+            umh.MessageType      = msgType;
+            UMHandlerIndex[slot] = i;
+
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+
             return CHIP_NO_ERROR;
         }
     }
 
-    if (selected == nullptr)
-        return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
+    return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
+}
+
+CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    size_t slot = FindUMHandlerIndexSlot(protocolId, msgType);
+    VerifyOrReturnError(UMHandlerIndex[slot] != kNoUMHandler, CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER);
 
-    selected->Handler     = handler;
-    selected->ProtocolId  = protocolId;
-    selected->MessageType = msgType;
+    UMHandlerPool[UMHandlerIndex[slot]].Reset();
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
-    SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+    //
+    // Backward-shift deletion: move back any later entry of the probe chain whose home slot does not lie
+    // cyclically within (hole, current], so that every remaining entry stays reachable from its home slot.
+    //
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & kUMHandlerIndexMask; UMHandlerIndex[next] != kNoUMHandler;
+         next        = (next + 1) & kUMHandlerIndexMask)
+    {
+        const UnsolicitedMessageHandlerSlot & umh = UMHandlerPool[UMHandlerIndex[next]];
+        size_t home                               = UMHandlerIndexSlot(umh.ProtocolId, umh.MessageType);
+        if (((next - home) & kUMHandlerIndexMask) >= ((next - hole) & kUMHandlerIndexMask))
+        {
+            UMHandlerIndex[hole] = UMHandlerIndex[next];
+            hole                 = next;
+        }
+    }
+    UMHandlerIndex[hole] = kNoUMHandler;
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
+size_t ExchangeManager::UMHandlerIndexSlot(Protocols::Id protocolId, int16_t msgType)
+{
+    uint32_t key = protocolId.ToFullyQualifiedSpecForm() ^ (static_cast<uint32_t>(static_cast<uint16_t>(msgType)) << 8);
+    return ((key * 2654435761u) >> 16) & kUMHandlerIndexMask;
+}
+
+size_t ExchangeManager::FindUMHandlerIndexSlot(Protocols::Id protocolId, int16_t msgType) const
+{
+    size_t slot = UMHandlerIndexSlot(protocolId, msgType);
+    while (UMHandlerIndex[slot] != kNoUMHandler && !UMHandlerPool[UMHandlerIndex[slot]].Matches(protocolId, msgType))
+    {
+        slot = (slot + 1) & kUMHandlerIndexMask;
+    }
+    return slot;
+}
+
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMH(Protocols::Id protocolId, int16_t msgType)
+{
+    size_t slot = FindUMHandlerIndexSlot(protocolId, msgType);
+    return UMHandlerIndex[slot] != kNoUMHandler ? &UMHandlerPool[UMHandlerIndex[slot]] : nullptr;
+}
+
+void ExchangeManager::AddToExchangeIndex(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ExchangeIndexBucket(ec->GetExchangeId(), ec->IsInitiator())];
+    while (*link != nullptr)
+    {
+        link = &(*link)->mNextInExchangeIndex;
+    }
+    ec->mNextInExchangeIndex = nullptr;
+    *link                    = ec;
+}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ExchangeIndexBucket(ec->GetExchangeId(), ec->IsInitiator())];
+    while (*link != ec)
+    {
+        VerifyOrReturn(*link != nullptr);
+        link = &(*link)->mNextInExchangeIndex;
+    }
+    *link                    = ec->mNextInExchangeIndex;
+    ec->mNextInExchangeIndex = nullptr;
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
 {
-    for (auto & umh : UMHandlerPool)
+    // A message from the initiator of an exchange belongs to our responder side of it, and vice versa.
+    for (ExchangeContext * ec = mExchangeIndex[ExchangeIndexBucket(payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator())];
+         ec != nullptr; ec = ec->mNextInExchangeIndex)
     {
-        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
         {
-            umh.Reset();
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
-            return CHIP_NO_ERROR;
+            return ec;
         }
     }
-
-    return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+    return nullptr;
 }
 
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
@@ -230,23 +303,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -271,21 +335,10 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
-
-        for (auto & umh : UMHandlerPool)
+        matchingUMH = FindUMH(payloadHeader.GetProtocolID(), payloadHeader.GetMessageType());
+        if (matchingUMH == nullptr)
         {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
+            matchingUMH = FindUMH(payloadHeader.GetProtocolID(), kAnyMessageType);
         }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
@@ -321,7 +374,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
             return;
         }
 
-        ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, false, delegate);
+        ExchangeContext * ec = AllocateContext(payloadHeader.GetExchangeID(), session, false, delegate);
 
         if (ec == nullptr)
         {
@@ -373,8 +426,8 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // If rcvd msg is from initiator then this exchange is created as not Initiator.
     // If rcvd msg is not from initiator then this exchange is created as Initiator.
     // Create a EphemeralExchange to generate a StandaloneAck
-    ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(),
-                                                     nullptr, true /* IsEphemeralExchange */);
+    ExchangeContext * ec = AllocateContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), nullptr,
+                                           true /* IsEphemeralExchange */);
 
     if (ec == nullptr)
     {
@@ -42,6 +42,21 @@ class ExchangeDelegate;
 
 static constexpr int16_t kAnyMessageType = -1;
 
+namespace detail {
+
+// Smallest power of two that is at least twice the given pool size.
+constexpr size_t IndexSizeFor(size_t poolSize)
+{
+    size_t size = 1;
+    while (size < 2 * poolSize)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace detail
+
 /**
  *  @brief
  *    This class is used to manage ExchangeContexts with other CHIP nodes.
@@ -100,7 +115,11 @@ public:
      */
     ExchangeContext * NewContext(const SessionHandle & session, ExchangeDelegate * delegate, bool isInitiator = true);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec)
+    {
+        RemoveFromExchangeIndex(ec);
+        mContextPool.ReleaseObject(ec);
+    }
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -222,6 +241,65 @@ private:
         UnsolicitedMessageHandler * Handler;
     };
 
+    //
+    // Index of live exchanges, used to find the exchange for an incoming message without walking mContextPool.
+    //
+    // Exchanges are hashed by exchange ID and initiator flag into kExchangeIndexSize buckets, each a chain
+    // through ExchangeContext::mNextInExchangeIndex kept in allocation order. The session is not part of the
+    // hash, since an exchange can lose its session while it is still alive; MatchExchange checks it on lookup.
+    //
+    static constexpr size_t kExchangeIndexSize = CHIP_CONFIG_EXCHANGE_INDEX_SIZE != 0
+        ? CHIP_CONFIG_EXCHANGE_INDEX_SIZE
+        : detail::IndexSizeFor(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS);
+    static constexpr size_t kExchangeIndexMask = kExchangeIndexSize - 1;
+
+    static_assert((kExchangeIndexSize & kExchangeIndexMask) == 0, "CHIP_CONFIG_EXCHANGE_INDEX_SIZE must be a power of two");
+
+    static size_t ExchangeIndexBucket(uint16_t exchangeId, bool isInitiator)
+    {
+        return ((static_cast<size_t>(exchangeId) << 1) | (isInitiator ? 1 : 0)) & kExchangeIndexMask;
+    }
+
+    /**
+     * Allocate an exchange out of mContextPool and record it in the exchange index.
+     *
+     * All exchange allocations must go through here so that FindExchange never misses a live exchange.
+     */
+    template <typename... Args>
+    ExchangeContext * AllocateContext(Args &&... args)
+    {
+        ExchangeContext * ec = mContextPool.CreateObject(this, std::forward<Args>(args)...);
+        if (ec != nullptr)
+        {
+            AddToExchangeIndex(ec);
+        }
+        return ec;
+    }
+
+    void AddToExchangeIndex(ExchangeContext * ec);
+    void RemoveFromExchangeIndex(ExchangeContext * ec);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
+
+    //
+    // Unsolicited message handlers are kept in UMHandlerPool and looked up through UMHandlerIndex, an
+    // open-addressed hash table with linear probing over (protocol, message type) which holds indices into
+    // UMHandlerPool. It is sized to at least twice the pool so that a probe always ends at an empty slot.
+    //
+    static constexpr size_t kUMHandlerIndexSize = detail::IndexSizeFor(CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS);
+    static constexpr size_t kUMHandlerIndexMask = kUMHandlerIndexSize - 1;
+    static constexpr uint8_t kNoUMHandler       = UINT8_MAX;
+
+    static_assert(CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS < kNoUMHandler,
+                  "Unsolicited message handler indices must fit in UMHandlerIndex");
+
+    static size_t UMHandlerIndexSlot(Protocols::Id protocolId, int16_t msgType);
+
+    // Returns the UMHandlerIndex slot holding the handler for exactly (protocolId, msgType), or the empty slot
+    // that ends its probe sequence.
+    size_t FindUMHandlerIndexSlot(Protocols::Id protocolId, int16_t msgType) const;
+    UnsolicitedMessageHandlerSlot * FindUMH(Protocols::Id protocolId, int16_t msgType);
+
     uint16_t mNextExchangeId;
     uint16_t mNextKeyId;
     State mState;
@@ -234,6 +312,9 @@ private:
     ReliableMessageMgr mReliableMessageMgr;
 
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    uint8_t UMHandlerIndex[kUMHandlerIndexSize];
+
+    ExchangeContext * mExchangeIndex[kExchangeIndexSize] = {};
 
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
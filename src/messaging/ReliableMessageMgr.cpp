@@ -79,6 +79,7 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
+        mRetransQueue.Remove(entry);
         mRetransTable.ReleaseObject(entry);
         return Loop::Continue;
     });
@@ -123,11 +124,11 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
-
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired.  Handling an entry may
+    // clear other entries, so always continue from the current earliest one.
+    for (RetransTableEntry * entry = mRetransQueue.Top(); entry != nullptr && entry->nextRetransTime <= now;
+         entry = mRetransQueue.Top())
+    {
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
         uint8_t sendCount = entry->sendCount;
@@ -162,9 +163,10 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
+            mRetransQueue.Remove(entry);
             mRetransTable.ReleaseObject(entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -174,10 +176,14 @@ void ReliableMessageMgr::ExecuteActions()
                         messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
 
         CalculateNextRetransTime(*entry);
+        // Each entry is retransmitted at most once per call; one which is already due again is left for the next wakeup.
+        const bool dueAgain = entry->nextRetransTime <= now;
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+        if (dueAgain)
+        {
+            break;
+        }
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -209,6 +215,7 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
         ChipLogError(ExchangeManager, "mRetransTable Already Full");
         return CHIP_ERROR_RETRANS_TABLE_FULL;
     }
+    mRetransQueue.Push(*rEntry);
 
     return CHIP_NO_ERROR;
 }
@@ -372,6 +379,7 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
+    mRetransQueue.Remove(&entry);
     mRetransTable.ReleaseObject(&entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
@@ -390,13 +398,11 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    const RetransTableEntry * nextRetrans = mRetransQueue.Top();
+    if (nextRetrans != nullptr && nextRetrans->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = nextRetrans->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -480,6 +486,7 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timestamp backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime            = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    mRetransQueue.Update(&entry);
 }
 
 #if CHIP_CONFIG_TEST
@@ -29,6 +29,7 @@
 #include <lib/core/CHIPError.h>
 #include <lib/core/Optional.h>
 #include <lib/support/BitFlags.h>
+#include <lib/support/IntrusiveHeap.h>
 #include <lib/support/Pool.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
@@ -55,8 +56,11 @@ public:
      *    acknowledgment back. If the acknowledgment is not received within a
      *    specific timeout, the message would be retransmitted from this table.
      *
+     *    Entries are also kept in a heap ordered by nextRetransTime, so the next
+     *    retransmission can be found without scanning the table.
+     *
      */
-    struct RetransTableEntry
+    struct RetransTableEntry : public IntrusiveHeapNodeBase
     {
         RetransTableEntry(ReliableMessageContext * rc);
         ~RetransTableEntry();
@@ -75,7 +79,7 @@ public:
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
+     * Iterate through active exchange contexts and due retrans table entries.  If an
      * action needs to be triggered by ReliableMessageProtocol time facilities,
      * execute that action.
      */
@@ -161,7 +165,7 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
+     * Iterate through active exchange contexts and look up the earliest retrans table entry.
      * Determine how many ReliableMessageProtocol ticks we need to sleep before we
      * need to physically wake the CPU to perform an action.  Set a timer to go off
      * when we next need to wake the system.
@@ -235,6 +239,14 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
+    struct NextRetransTimeOrder
+    {
+        bool operator()(const RetransTableEntry & a, const RetransTableEntry & b) const
+        {
+            return a.nextRetransTime < b.nextRetransTime;
+        }
+    };
+
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
@@ -252,6 +264,8 @@ private:
 
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
+    // All entries of mRetransTable, earliest nextRetransTime first.
+    IntrusiveHeap<RetransTableEntry, NextRetransTimeOrder> mRetransQueue;
 
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
@@ -99,6 +99,45 @@ class ExpireSessionFromTimeoutDelegate : public WaitForTimeoutDelegate
     }
 };
 
+class ReplyDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ++mRequestCount;
+        return ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(0),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int mRequestCount = 0;
+};
+
+class ResponseDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ++mResponseCount;
+        mLastExchange = ec;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int mResponseCount              = 0;
+    ExchangeContext * mLastExchange = nullptr;
+};
+
 void CheckNewContextTest(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -225,6 +264,112 @@ void CheckUmhRegistrationTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
 }
 
+void CheckUmhLookupTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate protocolDelegate;
+    MockAppDelegate typeDelegate;
+
+    // A handler for the message type takes precedence over a handler for the whole protocol.
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &protocolDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &typeDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockAppDelegate senderDelegate;
+    ExchangeContext * ec = ctx.NewExchangeToAlice(&senderDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, typeDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !protocolDelegate.IsOnMessageReceivedCalled);
+
+    typeDelegate.IsOnMessageReceivedCalled = false;
+    ec                                     = ctx.NewExchangeToAlice(&senderDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, !typeDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, protocolDelegate.IsOnMessageReceivedCalled);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Fill the handler table, then remove every other handler and check that the rest can still be found.
+    uint8_t registered = 0;
+    while (ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, registered, &typeDelegate) ==
+           CHIP_NO_ERROR)
+    {
+        ++registered;
+    }
+    NL_TEST_ASSERT(inSuite, registered > 0 && registered <= CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS);
+
+    for (uint8_t msgType = 0; msgType < registered; msgType = static_cast<uint8_t>(msgType + 2))
+    {
+        err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, msgType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    for (uint8_t msgType = 0; msgType < registered; ++msgType)
+    {
+        err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::Id, msgType);
+        NL_TEST_ASSERT(inSuite, (err == CHIP_NO_ERROR) == (msgType % 2 == 1));
+    }
+}
+
+void CheckManyExchangesTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Both sides of the loopback share one exchange manager, so every request creates a responder
+    // exchange with the same exchange ID as an initiator exchange.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    constexpr size_t kExchangeCount = 200;
+#else
+    constexpr size_t kExchangeCount = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS / 2;
+#endif
+    static ResponseDelegate responseDelegates[kExchangeCount];
+    ExchangeContext * exchanges[kExchangeCount];
+
+    ReplyDelegate replyDelegate;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1,
+                                                                                       &replyDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kExchangeCount; ++i)
+    {
+        responseDelegates[i] = ResponseDelegate();
+        exchanges[i]         = ctx.NewExchangeToAlice(&responseDelegates[i]);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, exchanges[i] != nullptr);
+    }
+
+    // Send one request at a time so that the packet buffer pool is not exhausted, while the remaining
+    // exchanges stay open.
+    for (size_t i = kExchangeCount; i-- > 0;)
+    {
+        err = exchanges[i]->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(0),
+                                        SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        ctx.DrainAndServiceIO();
+    }
+
+    NL_TEST_ASSERT(inSuite, replyDelegate.mRequestCount == static_cast<int>(kExchangeCount));
+    for (size_t i = 0; i < kExchangeCount; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, responseDelegates[i].mResponseCount == 1);
+        NL_TEST_ASSERT(inSuite, responseDelegates[i].mLastExchange == exchanges[i]);
+    }
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
 void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -271,7 +416,9 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
+    NL_TEST_DEF("Test ExchangeMgr::CheckUmhLookupTest",       CheckUmhLookupTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test ExchangeMgr::CheckManyExchangesTest",   CheckManyExchangesTest),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
     NL_TEST_DEF("Test session eviction in timeout handling",  CheckSessionExpirationDuringTimeout),
@@ -318,6 +318,7 @@ class TestReliableMessageProtocol
 {
 public:
     static void CheckAddClearRetrans(nlTestSuite * inSuite, void * inContext);
+    static void CheckRetransTableStress(nlTestSuite * inSuite, void * inContext);
     static void CheckResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckCloseExchangeAndResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckFailedMessageRetainOnSend(nlTestSuite * inSuite, void * inContext);
@@ -363,6 +364,77 @@ void TestReliableMessageProtocol::CheckAddClearRetrans(nlTestSuite * inSuite, vo
     exchange->Close();
 }
 
+/**
+ * Stress test of the retransmission table: keep many reliable messages in flight at once
+ * and measure the cost of scheduling, rescheduling and cancelling their retransmissions.
+ * The number of messages is limited by the exchange and retransmission table pools.
+ */
+void TestReliableMessageProtocol::CheckRetransTableStress(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr size_t kMaxInFlight = 2000;
+    static ExchangeContext * exchanges[kMaxInFlight];
+    static ReliableMessageMgr::RetransTableEntry * entries[kMaxInFlight];
+
+    MockAppDelegate mockAppDelegate(ctx);
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    size_t exchangeCount = 0;
+    while (exchangeCount < kMaxInFlight && (exchanges[exchangeCount] = ctx.NewExchangeToAlice(&mockAppDelegate)) != nullptr)
+    {
+        exchangeCount++;
+    }
+
+    // Schedule a retransmission for each message, as sending it would.
+    uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+    size_t count     = 0;
+    while (count < exchangeCount &&
+           rm->AddToRetransTable(exchanges[count]->GetReliableMessageContext(), &entries[count]) == CHIP_NO_ERROR)
+    {
+        rm->StartRetransmision(entries[count]);
+        count++;
+    }
+    const uint64_t scheduleUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+    NL_TEST_ASSERT(inSuite, count > 0);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == static_cast<int>(count));
+
+    // Recompute the next wakeup, as happens after every sent or received message.
+    startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < count; i++)
+    {
+        rm->StartTimer();
+    }
+    const uint64_t rescheduleUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+    // Cancel the retransmissions, as acks would, in an order unrelated to their deadlines.
+    startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t step = 0; step < 2; step++)
+    {
+        for (size_t i = step; i < count; i += 2)
+        {
+            rm->ClearRetransTable(*entries[i]);
+        }
+    }
+    const uint64_t cancelUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    for (size_t i = 0; i < exchangeCount; i++)
+    {
+        exchanges[i]->Close();
+    }
+
+    if (count > 0)
+    {
+        ChipLogProgress(Test,
+                        "Retrans table with %u messages in flight: schedule %u ns, reschedule %u ns, cancel %u ns per message",
+                        static_cast<unsigned>(count), static_cast<unsigned>(scheduleUs * 1000 / count),
+                        static_cast<unsigned>(rescheduleUs * 1000 / count), static_cast<unsigned>(cancelUs * 1000 / count));
+    }
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
@@ -2162,6 +2234,7 @@ void TestReliableMessageProtocol::CheckApplicationResponseNeverComes(nlTestSuite
 
 const nlTest sTests[] = {
     NL_TEST_DEF("Test ReliableMessageMgr::CheckAddClearRetrans", TestReliableMessageProtocol::CheckAddClearRetrans),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRetransTableStress", TestReliableMessageProtocol::CheckRetransTableStress),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckResendApplicationMessage",
                 TestReliableMessageProtocol::CheckResendApplicationMessage),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckCloseExchangeAndResendApplicationMessage",
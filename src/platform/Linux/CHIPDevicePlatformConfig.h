@@ -54,6 +54,12 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+// Back KeyValueStoreManagerImpl with the append-only ChipLinuxStorageLog instead of the INI file.
+// Set by the chip_linux_kvs_log_store build argument.
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STORE
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -64,6 +70,16 @@
 #define CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE 8192
 #endif // CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE
 
+// Background work runs on the Matter thread until StartBackgroundEventLoopTask() starts the background tasks.
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+#define CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING 1
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
+// Lets the crypto of concurrent CASE handshakes run in parallel once the background tasks are started.
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 4
+#endif // CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+
 #ifndef CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 1
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
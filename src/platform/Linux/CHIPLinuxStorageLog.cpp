@@ -0,0 +1,745 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implementation of the log-structured Linux key-value store.
+ *
+ *          The log starts with an 8-byte magic followed by records of the form
+ *
+ *              crc32 (4) | value length (4) | key length (1) | type (1) | key | value
+ *
+ *          with little-endian integers and the CRC covering everything after itself.
+ *
+ *          A store written by the INI backend (ChipLinuxStorage) at the same path is
+ *          rewritten as a log the first time it is opened, so that switching backends
+ *          keeps every key.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <algorithm>
+#include <array>
+#include <errno.h>
+#include <fcntl.h>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kFileMagic[8]    = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kRecordHeaderSize = 10;
+constexpr char kCompactSuffix[]    = "-compact";
+// Section holding every key of a store written by ChipLinuxStorageIni.
+constexpr char kIniSection[] = "DEFAULT";
+
+// Compaction starts once the log has grown past this size and at least half of it is garbage.
+constexpr size_t kCompactionMinLogSize = 64 * 1024;
+
+uint32_t Crc32(const uint8_t * data, size_t length)
+{
+    static const auto sTable = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < table.size(); i++)
+        {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        return table;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = sTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+CHIP_ERROR WriteFully(int fd, const uint8_t * data, size_t length, size_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t written = pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            ChipLogError(DeviceLayer, "failed to write KVS log: %s (%d)", strerror(errno), errno);
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+        offset += static_cast<size_t>(written);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadFully(int fd, uint8_t * data, size_t length, size_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t bytesRead = pread(fd, data, length, static_cast<off_t>(offset));
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytesRead <= 0)
+        {
+            ChipLogError(DeviceLayer, "failed to read KVS log: %s (%d)", strerror(errno), errno);
+            return CHIP_ERROR_READ_FAILED;
+        }
+        data += bytesRead;
+        length -= static_cast<size_t>(bytesRead);
+        offset += static_cast<size_t>(bytesRead);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR Sync(int fd)
+{
+    if (fdatasync(fd) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to sync KVS log: %s (%d)", strerror(errno), errno);
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Makes a rename or a newly created file in the directory of @p path durable.
+void SyncDirectory(const std::string & path)
+{
+    size_t slash    = path.rfind('/');
+    std::string dir = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+} // namespace
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * logFile)
+{
+    VerifyOrReturnError(logFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::unique_lock<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS log file: %s", logFile);
+    if (mFd >= 0)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS log file: %s", logFile);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath.assign(logFile);
+    ReturnErrorOnFailure(Open());
+
+    mCompactionThread = std::thread(&ChipLinuxStorageLog::CompactionThreadMain, this);
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mShuttingDown = true;
+        mCompactionWanted.notify_one();
+    }
+
+    if (mCompactionThread.joinable())
+    {
+        mCompactionThread.join();
+    }
+
+    std::unique_lock<std::mutex> lock(mLock);
+    mCommitDone.wait(lock, [this] {
+        return !mCommitting && !mCompacting && (mUncommitted.empty() || mWriteError != CHIP_NO_ERROR);
+    });
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+
+    mIndex.clear();
+    mPending.clear();
+    mUncommitted.clear();
+    mFailedUpdates.clear();
+    mFileSize            = 0;
+    mAppendedSequence    = 0;
+    mCommittedSequence   = 0;
+    mCompactionRequested = false;
+    mShuttingDown        = false;
+    mWriteError          = CHIP_NO_ERROR;
+    mStats               = Stats();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Open()
+{
+    // A compaction interrupted before its rename leaves the previous log intact; drop the partial copy.
+    std::string compactPath = mPath + kCompactSuffix;
+    unlink(compactPath.c_str());
+
+    int fd = open(mPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open KVS log (%s): %s (%d)", mPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    std::vector<uint8_t> log;
+    size_t validLength = 0;
+    struct stat st;
+
+    if (fstat(fd, &st) != 0)
+    {
+        ExitNow(err = CHIP_ERROR_OPEN_FAILED);
+    }
+
+    log.resize(static_cast<size_t>(st.st_size));
+    SuccessOrExit(err = ReadFully(fd, log.data(), log.size(), 0));
+
+    mStats = Stats();
+    if (!log.empty() && (log.size() < sizeof(kFileMagic) || memcmp(log.data(), kFileMagic, sizeof(kFileMagic)) != 0) &&
+        ImportIni(log) == CHIP_NO_ERROR)
+    {
+        // The store was written by the INI backend: replace it with the log of the same keys, then replay that.
+        SuccessOrExit(err = ReplaceLog(log, fd));
+        ChipLogProgress(DeviceLayer, "imported INI store %s into a KVS log", mPath.c_str());
+    }
+
+    if (log.empty())
+    {
+        SuccessOrExit(err = WriteFully(fd, kFileMagic, sizeof(kFileMagic), 0));
+        SuccessOrExit(err = Sync(fd));
+        SyncDirectory(mPath);
+        validLength      = sizeof(kFileMagic);
+        mStats.liveBytes = sizeof(kFileMagic);
+    }
+    else
+    {
+        SuccessOrExit(err = Replay(log, validLength));
+    }
+
+    if (validLength < log.size())
+    {
+        // Whatever follows the last complete record was being written when the process died.
+        ChipLogError(DeviceLayer, "discarding %u bytes of incomplete KVS log at offset %u",
+                     static_cast<unsigned>(log.size() - validLength), static_cast<unsigned>(validLength));
+        if (ftruncate(fd, static_cast<off_t>(validLength)) != 0)
+        {
+            ExitNow(err = CHIP_ERROR_WRITE_FAILED);
+        }
+        SuccessOrExit(err = Sync(fd));
+    }
+
+    mFd             = fd;
+    mFileSize       = validLength;
+    mStats.logBytes = validLength;
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        mIndex.clear();
+    }
+    return err;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ImportIni(std::vector<uint8_t> & file)
+{
+    inipp::Ini<char> ini;
+    std::istringstream stream(std::string(file.begin(), file.end()));
+    ini.parse(stream);
+    VerifyOrReturnError(ini.errors.empty(), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    VerifyOrReturnError(ini.sections.size() == 1 && ini.sections.count(kIniSection) == 1, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+    std::vector<uint8_t> log(std::begin(kFileMagic), std::end(kFileMagic));
+    for (const auto & entry : ini.sections[kIniSection])
+    {
+        std::string key   = IniEscaping::UnescapeKey(entry.first);
+        std::string value = IniEscaping::Base64ToString(entry.second);
+        VerifyOrReturnError(!key.empty() && key.size() <= kMaxKeyLength, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        // Base64ToString also returns an empty string when the value is not valid base64.
+        VerifyOrReturnError(!value.empty() || entry.second.empty(), CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+        VerifyOrReturnError(value.size() <= kMaxValueLength, CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+        AppendRecord(log, RecordType::kPut, key, reinterpret_cast<const uint8_t *>(value.data()), value.size());
+    }
+
+    file.swap(log);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ReplaceLog(const std::vector<uint8_t> & log, int & fd)
+{
+    std::string newPath = mPath + kCompactSuffix;
+    int newFd           = open(newPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (newFd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open KVS log (%s): %s (%d)", newPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = WriteFully(newFd, log.data(), log.size(), 0);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = Sync(newFd);
+    }
+    if (err == CHIP_NO_ERROR && rename(newPath.c_str(), mPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", newPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(newFd);
+        unlink(newPath.c_str());
+        return err;
+    }
+
+    SyncDirectory(mPath);
+    close(fd);
+    fd = newFd;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Replay(const std::vector<uint8_t> & log, size_t & validLength)
+{
+    if (log.size() < sizeof(kFileMagic) || memcmp(log.data(), kFileMagic, sizeof(kFileMagic)) != 0)
+    {
+        ChipLogError(DeviceLayer, "%s is not a KVS log", mPath.c_str());
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+
+    size_t offset    = sizeof(kFileMagic);
+    mStats.liveBytes = sizeof(kFileMagic);
+
+    while (log.size() - offset >= kRecordHeaderSize)
+    {
+        const uint8_t * record = log.data() + offset;
+        uint32_t crc           = Encoding::LittleEndian::Get32(record);
+        uint32_t valueSize     = Encoding::LittleEndian::Get32(record + 4);
+        uint8_t keyLength      = record[8];
+        uint8_t type           = record[9];
+
+        if (valueSize > kMaxValueLength)
+        {
+            break;
+        }
+
+        size_t recordSize = RecordSize(keyLength, valueSize);
+        if (log.size() - offset < recordSize || Crc32(record + 4, recordSize - 4) != crc)
+        {
+            break;
+        }
+
+        if (type != to_underlying(RecordType::kPut) && type != to_underlying(RecordType::kDelete))
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keyLength);
+        ApplyRecord(static_cast<RecordType>(type), std::move(key), record + kRecordHeaderSize + keyLength, valueSize);
+
+        offset += recordSize;
+    }
+
+    validLength = offset;
+    return CHIP_NO_ERROR;
+}
+
+size_t ChipLinuxStorageLog::RecordSize(size_t keyLength, size_t valueSize)
+{
+    return kRecordHeaderSize + keyLength + valueSize;
+}
+
+void ChipLinuxStorageLog::ApplyRecord(RecordType type, std::string key, const uint8_t * value, size_t valueSize)
+{
+    auto it = mIndex.find(key);
+    if (it != mIndex.end())
+    {
+        mStats.liveBytes -= RecordSize(key.size(), it->second.size());
+    }
+
+    if (type == RecordType::kPut)
+    {
+        mStats.liveBytes += RecordSize(key.size(), valueSize);
+        if (it == mIndex.end())
+        {
+            it = mIndex.emplace(std::move(key), std::vector<uint8_t>()).first;
+        }
+        it->second.assign(value, value + valueSize);
+    }
+    else if (it != mIndex.end())
+    {
+        mIndex.erase(it);
+    }
+}
+
+bool ChipLinuxStorageLog::Exists(const std::string & key) const
+{
+    // The latest update not committed yet wins over the index.
+    for (auto it = mUncommitted.rbegin(); it != mUncommitted.rend(); ++it)
+    {
+        if (it->key == key)
+        {
+            return it->type == RecordType::kPut;
+        }
+    }
+    return mIndex.find(key) != mIndex.end();
+}
+
+void ChipLinuxStorageLog::AppendRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                                       size_t valueSize)
+{
+    size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueSize));
+
+    uint8_t * record = out.data() + start;
+    Encoding::LittleEndian::Put32(record + 4, static_cast<uint32_t>(valueSize));
+    record[8] = static_cast<uint8_t>(key.size());
+    record[9] = to_underlying(type);
+    memcpy(record + kRecordHeaderSize, key.data(), key.size());
+    if (valueSize > 0)
+    {
+        memcpy(record + kRecordHeaderSize + key.size(), value, valueSize);
+    }
+    Encoding::LittleEndian::Put32(record, Crc32(record + 4, out.size() - start - 4));
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mIndex.find(key);
+    VerifyOrReturnError(it != mIndex.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const std::vector<uint8_t> & stored = it->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t remaining = stored.size() - offset;
+    size_t copySize  = std::min(valueSize, remaining);
+    if (copySize > 0)
+    {
+        VerifyOrReturnError(value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        memcpy(value, stored.data() + offset, copySize);
+    }
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+
+    return (valueSize < remaining) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Put(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(valueSize <= kMaxValueLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::unique_lock<std::mutex> lock(mLock);
+    return Append(lock, RecordType::kPut, key, value, valueSize);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::unique_lock<std::mutex> lock(mLock);
+    return Append(lock, RecordType::kDelete, key, nullptr, 0);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Append(std::unique_lock<std::mutex> & lock, RecordType type, const char * key, const void * value,
+                                       size_t valueSize)
+{
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mWriteError);
+
+    std::string keyString(key);
+    VerifyOrReturnError(keyString.size() <= kMaxKeyLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrReturnError(type == RecordType::kPut || Exists(keyString), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+
+    AppendRecord(mPending, type, keyString, bytes, valueSize);
+    mStats.logBytes += RecordSize(keyString.size(), valueSize);
+    if (type == RecordType::kPut)
+    {
+        mStats.puts++;
+    }
+    else
+    {
+        mStats.deletes++;
+    }
+
+    // The index is only updated once the record is durable.
+    uint64_t sequence = ++mAppendedSequence;
+    mUncommitted.push_back({ sequence, type, std::move(keyString), std::vector<uint8_t>(bytes, bytes + valueSize) });
+    return WaitForCommit(lock, sequence);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::WaitForCommit(std::unique_lock<std::mutex> & lock, uint64_t sequence)
+{
+    while (true)
+    {
+        auto failed = mFailedUpdates.find(sequence);
+        if (failed != mFailedUpdates.end())
+        {
+            CHIP_ERROR err = failed->second;
+            mFailedUpdates.erase(failed);
+            return err;
+        }
+        VerifyOrReturnError(mCommittedSequence < sequence, CHIP_NO_ERROR);
+        ReturnErrorOnFailure(mWriteError);
+
+        if (mCommitting)
+        {
+            // Another writer is syncing the log; this record goes out with the next batch.
+            mCommitDone.wait(lock);
+            continue;
+        }
+
+        // Become the commit leader for every record appended so far.
+        std::vector<uint8_t> batch;
+        batch.swap(mPending);
+        uint64_t batchSequence = mAppendedSequence;
+        int fd                 = mFd;
+        size_t offset          = mFileSize;
+        mCommitting            = true;
+
+        lock.unlock();
+        CHIP_ERROR err = WriteFully(fd, batch.data(), batch.size(), offset);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = Sync(fd);
+        }
+        // Take back whatever part of the batch reached the file, so that the log ends at its last commit again.
+        bool rolledBack = false;
+        if (err != CHIP_NO_ERROR)
+        {
+            rolledBack = (ftruncate(fd, static_cast<off_t>(offset)) == 0);
+            if (!rolledBack)
+            {
+                ChipLogError(DeviceLayer, "failed to truncate KVS log: %s (%d)", strerror(errno), errno);
+            }
+            rolledBack = rolledBack && Sync(fd) == CHIP_NO_ERROR;
+        }
+        lock.lock();
+
+        mCommitting = false;
+        if (err == CHIP_NO_ERROR)
+        {
+            mFileSize += batch.size();
+            mCommittedSequence = batchSequence;
+            mStats.commits++;
+
+            while (!mUncommitted.empty() && mUncommitted.front().sequence <= batchSequence)
+            {
+                Update & update = mUncommitted.front();
+                ApplyRecord(update.type, std::move(update.key), update.value.data(), update.value.size());
+                mUncommitted.pop_front();
+            }
+
+            if (ShouldCompact())
+            {
+                mCompactionRequested = true;
+                mCompactionWanted.notify_one();
+            }
+        }
+        else if (rolledBack)
+        {
+            // Only this batch fails (e.g. on a full disk); the next one may succeed.
+            mStats.logBytes -= batch.size();
+            while (!mUncommitted.empty() && mUncommitted.front().sequence <= batchSequence)
+            {
+                mFailedUpdates.emplace(mUncommitted.front().sequence, err);
+                mUncommitted.pop_front();
+            }
+        }
+        else
+        {
+            // The file may hold part of this batch, so none of the records appended so far will be committed,
+            // and later ones are refused.
+            mWriteError = err;
+            mPending.clear();
+            mUncommitted.clear();
+        }
+        mCommitDone.notify_all();
+    }
+}
+
+bool ChipLinuxStorageLog::ShouldCompact() const
+{
+    return !mCompacting && mStats.logBytes >= kCompactionMinLogSize && mStats.logBytes >= 2 * mStats.liveBytes;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    return CompactLocked(lock);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::CompactLocked(std::unique_lock<std::mutex> & lock)
+{
+    mCommitDone.wait(lock, [this] { return !mCompacting; });
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mWriteError);
+
+    // The index holds every record committed so far, which all lie before snapshotEnd. Records committed
+    // later are written past snapshotEnd and copied over before the swap.
+    std::vector<uint8_t> snapshot(std::begin(kFileMagic), std::end(kFileMagic));
+    snapshot.reserve(mStats.liveBytes);
+    for (const auto & entry : mIndex)
+    {
+        AppendRecord(snapshot, RecordType::kPut, entry.first, entry.second.data(), entry.second.size());
+    }
+    size_t snapshotEnd      = mFileSize;
+    std::string compactPath = mPath + kCompactSuffix;
+    mCompacting             = true;
+
+    lock.unlock();
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    int fd         = open(compactPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open KVS log (%s): %s (%d)", compactPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_OPEN_FAILED;
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = WriteFully(fd, snapshot.data(), snapshot.size(), 0);
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = Sync(fd);
+    }
+    lock.lock();
+
+    // No commit may run while the tail is copied and the files are swapped.
+    mCommitDone.wait(lock, [this] { return !mCommitting; });
+
+    size_t tailSize = mFileSize - snapshotEnd;
+    if (err == CHIP_NO_ERROR && tailSize > 0)
+    {
+        std::vector<uint8_t> tail(tailSize);
+        err = ReadFully(mFd, tail.data(), tailSize, snapshotEnd);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = WriteFully(fd, tail.data(), tailSize, snapshot.size());
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = Sync(fd);
+        }
+    }
+    if (err == CHIP_NO_ERROR && rename(compactPath.c_str(), mPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", compactPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        SyncDirectory(mPath);
+        close(mFd);
+        mFd             = fd;
+        mFileSize       = snapshot.size() + tailSize;
+        mStats.logBytes = mFileSize + mPending.size();
+        mStats.compactions++;
+    }
+    else
+    {
+        // The previous log is untouched, so the store keeps working without the rewrite.
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        unlink(compactPath.c_str());
+    }
+
+    mCompacting = false;
+    mCommitDone.notify_all();
+    return err;
+}
+
+void ChipLinuxStorageLog::CompactionThreadMain()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+
+    while (true)
+    {
+        mCompactionWanted.wait(lock, [this] { return mShuttingDown || mCompactionRequested; });
+        if (mShuttingDown)
+        {
+            break;
+        }
+
+        mCompactionRequested = false;
+        CHIP_ERROR err       = CompactLocked(lock);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "KVS log compaction failed: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+}
+
+ChipLinuxStorageLog::Stats ChipLinuxStorageLog::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mStats;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
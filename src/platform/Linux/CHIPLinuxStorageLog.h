@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Log-structured key-value store used by the Linux KeyValueStoreManagerImpl
+ *          when built with chip_linux_kvs_log_store=true.
+ *
+ *          Every Put/Delete appends a small CRC-protected record to a single log file
+ *          instead of rewriting the whole store, and an in-memory hash index holds the
+ *          current value of every key. Writers that arrive while another writer is
+ *          syncing the log are committed together by the next fdatasync (group commit).
+ *          Once most of the log is made of overwritten or deleted records, a background
+ *          thread rewrites the live keys into a new log and atomically renames it over
+ *          the old one. On start-up the log is replayed and any torn record left by a
+ *          crash is truncated away. An INI store left at the same path by the default
+ *          backend is imported into a new log the first time it is opened.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    struct Stats
+    {
+        uint64_t puts        = 0; ///< Put records appended
+        uint64_t deletes     = 0; ///< Delete records appended
+        uint64_t commits     = 0; ///< fdatasync calls made by group commit
+        uint64_t compactions = 0; ///< Completed log rewrites
+        size_t liveBytes     = 0; ///< Size of the records needed to rebuild the current keys
+        size_t logBytes      = 0; ///< Size of the log, including records not synced yet
+    };
+
+    static constexpr size_t kMaxKeyLength   = UINT8_MAX;
+    static constexpr size_t kMaxValueLength = 64 * 1024;
+
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog();
+
+    /**
+     * Open (or create) the log at @p logFile, replay it into the index and start the compaction thread.
+     */
+    CHIP_ERROR Init(const char * logFile);
+
+    /**
+     * Stop the compaction thread and close the log. Pending writes have all been synced by the time
+     * their Put/Delete returned, so nothing is lost.
+     */
+    void Shutdown();
+
+    /**
+     * Same contract as KeyValueStoreManager::Get: copies up to @p valueSize bytes starting at @p offset
+     * and returns CHIP_ERROR_BUFFER_TOO_SMALL if the value did not fit.
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize = nullptr, size_t offset = 0);
+    CHIP_ERROR Put(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Rewrite the log synchronously, whether or not the compaction threshold has been reached.
+     */
+    CHIP_ERROR Compact();
+
+    Stats GetStats();
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+    };
+
+    static void AppendRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value,
+                             size_t valueSize);
+    static size_t RecordSize(size_t keyLength, size_t valueSize);
+
+    // A Put/Delete whose record has been appended but not committed yet.
+    struct Update
+    {
+        uint64_t sequence;
+        RecordType type;
+        std::string key;
+        std::vector<uint8_t> value;
+    };
+
+    CHIP_ERROR Open();
+    // Converts @p file, if it is a store written by ChipLinuxStorageIni, into a log holding the same keys.
+    static CHIP_ERROR ImportIni(std::vector<uint8_t> & file);
+    // Atomically replaces the log file with @p log, and @p fd with a descriptor of the new file.
+    CHIP_ERROR ReplaceLog(const std::vector<uint8_t> & log, int & fd);
+    CHIP_ERROR Replay(const std::vector<uint8_t> & log, size_t & validLength);
+    void ApplyRecord(RecordType type, std::string key, const uint8_t * value, size_t valueSize);
+    bool Exists(const std::string & key) const;
+    CHIP_ERROR Append(std::unique_lock<std::mutex> & lock, RecordType type, const char * key, const void * value,
+                      size_t valueSize);
+    CHIP_ERROR WaitForCommit(std::unique_lock<std::mutex> & lock, uint64_t sequence);
+    CHIP_ERROR CompactLocked(std::unique_lock<std::mutex> & lock);
+    bool ShouldCompact() const;
+    void CompactionThreadMain();
+
+    std::mutex mLock;
+    std::condition_variable mCommitDone;
+    std::condition_variable mCompactionWanted;
+    std::thread mCompactionThread;
+
+    std::string mPath;
+    int mFd = -1;
+    // Bytes of the current log file that have been written and synced.
+    size_t mFileSize = 0;
+    // Records appended but not written yet; the next commit leader takes all of them.
+    std::vector<uint8_t> mPending;
+    // Updates of the records not committed yet, in sequence order. They are applied to mIndex once committed.
+    std::deque<Update> mUncommitted;
+    uint64_t mAppendedSequence  = 0;
+    uint64_t mCommittedSequence = 0;
+    bool mCommitting            = false;
+    bool mCompacting            = false;
+    bool mCompactionRequested   = false;
+    bool mShuttingDown          = false;
+    // Updates of the batches that failed to commit, with the error their writers are to return.
+    std::unordered_map<uint64_t, CHIP_ERROR> mFailedUpdates;
+    // Set when a failed batch could not be truncated away; the file may hold part of it, so the store refuses
+    // further writes.
+    CHIP_ERROR mWriteError = CHIP_NO_ERROR;
+
+    std::unordered_map<std::string, std::vector<uint8_t>> mIndex;
+    Stats mStats;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -21,9 +21,42 @@
 
 #include "OTAImageProcessorImpl.h"
 
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
 #include <sys/stat.h>
 
 namespace chip {
+namespace {
+
+// Length of the digests in the image header that are checked against the SHA-256 of the payload, 0 for other types.
+size_t Sha256DigestLength(OTAImageDigestType type)
+{
+    switch (type)
+    {
+    case OTAImageDigestType::kSha256:
+        return 32;
+    case OTAImageDigestType::kSha256_128:
+        return 16;
+    case OTAImageDigestType::kSha256_120:
+        return 15;
+    case OTAImageDigestType::kSha256_96:
+        return 12;
+    case OTAImageDigestType::kSha256_64:
+        return 8;
+    case OTAImageDigestType::kSha256_32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+OTAImageProcessorImpl::~OTAImageProcessorImpl()
+{
+    StopWriter(/* discardQueued = */ true);
+}
 
 CHIP_ERROR OTAImageProcessorImpl::PrepareDownload()
 {
@@ -39,6 +72,25 @@ CHIP_ERROR OTAImageProcessorImpl::PrepareDownload()
 
 CHIP_ERROR OTAImageProcessorImpl::Finalize()
 {
+    if (mPipelinedWrites)
+    {
+        VerifyOrReturnError(!mFinalizing, CHIP_ERROR_INCORRECT_STATE);
+
+        // Blocks were acknowledged as soon as they were queued: the writer thread may still have up to kWriteQueueDepth
+        // blocks to write, so wait for it off the Matter thread. The downloader acknowledges the last block once
+        // HandleFinalized reports that the image was stored.
+        mFinalizing     = true;
+        mAbortRequested = false;
+        CHIP_ERROR err  = DeviceLayer::PlatformMgr().ScheduleBackgroundWork(HandleFinalizeInBackground,
+                                                                            reinterpret_cast<intptr_t>(this));
+        if (err != CHIP_NO_ERROR)
+        {
+            mFinalizing = false;
+            return err;
+        }
+        return CHIP_ERROR_IN_PROGRESS;
+    }
+
     DeviceLayer::PlatformMgr().ScheduleWork(HandleFinalize, reinterpret_cast<intptr_t>(this));
     return CHIP_NO_ERROR;
 }
@@ -63,6 +115,11 @@ CHIP_ERROR OTAImageProcessorImpl::Abort()
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessBlock(ByteSpan & block)
 {
+    if (mPipelinedWrites)
+    {
+        return QueueBlock(block);
+    }
+
     if (!mOfs.is_open() || !mOfs.good())
     {
         return CHIP_ERROR_INTERNAL;
@@ -137,6 +194,11 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
+    if (imageProcessor->mPipelinedWrites)
+    {
+        imageProcessor->StartWriter();
+    }
+
     imageProcessor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
 }
 
@@ -154,6 +216,50 @@ void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
     ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
 }
 
+void OTAImageProcessorImpl::HandleFinalizeInBackground(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr);
+
+    CHIP_ERROR err = imageProcessor->StopWriter(/* discardQueued = */ false);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = imageProcessor->FinishImage();
+    }
+    imageProcessor->mFinalizeError = err;
+
+    DeviceLayer::PlatformMgr().ScheduleWork(HandleFinalized, context);
+}
+
+void OTAImageProcessorImpl::HandleFinalized(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr);
+
+    imageProcessor->mFinalizing             = false;
+    imageProcessor->mParams.downloadedBytes = imageProcessor->mWrittenBytes;
+    imageProcessor->mParams.totalFileBytes  = imageProcessor->mWriterPayloadSize;
+
+    if (imageProcessor->mAbortRequested)
+    {
+        HandleAbort(context);
+        return;
+    }
+
+    CHIP_ERROR err = imageProcessor->mFinalizeError;
+    if (err == CHIP_NO_ERROR)
+    {
+        HandleFinalize(context);
+    }
+    else
+    {
+        ChipLogError(SoftwareUpdate, "Cannot finalize OTA image: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    VerifyOrReturn(imageProcessor->mDownloader != nullptr);
+    imageProcessor->mDownloader->OnFinalized(err);
+}
+
 void OTAImageProcessorImpl::HandleApply(intptr_t context)
 {
     auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
@@ -180,6 +286,16 @@ void OTAImageProcessorImpl::HandleAbort(intptr_t context)
         return;
     }
 
+    // Background work is still waiting for the writer thread: HandleFinalized aborts once it is done.
+    if (imageProcessor->mFinalizing)
+    {
+        imageProcessor->mAbortRequested = true;
+        return;
+    }
+
+    // The writer thread must not write to the file being removed.
+    imageProcessor->StopWriter(/* discardQueued = */ true);
+
     imageProcessor->mOfs.close();
     unlink(imageProcessor->mImageFile);
     imageProcessor->ReleaseBlock();
@@ -229,13 +345,236 @@ CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
         ReturnErrorCodeIf(error == CHIP_ERROR_BUFFER_TOO_SMALL, CHIP_NO_ERROR);
         ReturnErrorOnFailure(error);
 
-        mParams.totalFileBytes = header.mPayloadSize;
+        if (mPipelinedWrites)
+        {
+            // Called on the writer thread, while mParams belongs to the Matter thread.
+            ReturnErrorOnFailure(StartDigest(header));
+            std::lock_guard<std::mutex> lock(mWriterLock);
+            mWriterPayloadSize = header.mPayloadSize;
+        }
+        else
+        {
+            mParams.totalFileBytes = header.mPayloadSize;
+        }
         mHeaderParser.Clear();
     }
 
     return CHIP_NO_ERROR;
 }
 
+void OTAImageProcessorImpl::HandleBlockQueued(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr && imageProcessor->mDownloader != nullptr);
+
+    imageProcessor->mDownloader->FetchNextData();
+}
+
+void OTAImageProcessorImpl::HandleWriteError(intptr_t context)
+{
+    auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
+    VerifyOrReturn(imageProcessor != nullptr && imageProcessor->mDownloader != nullptr);
+    // Reported by HandleFinalized, already reported, or the download was aborted in the meantime.
+    VerifyOrReturn(!imageProcessor->mFinalizing && !imageProcessor->mWriteErrorReported &&
+                   imageProcessor->mWriterThread.joinable());
+
+    CHIP_ERROR error;
+    {
+        std::lock_guard<std::mutex> lock(imageProcessor->mWriterLock);
+        error = imageProcessor->mWriteError;
+    }
+    imageProcessor->mWriteErrorReported = true;
+    imageProcessor->mDownloader->EndDownload(error);
+}
+
+CHIP_ERROR OTAImageProcessorImpl::QueueBlock(const ByteSpan & block)
+{
+    VerifyOrReturnError(!mFinalizing, CHIP_ERROR_INCORRECT_STATE);
+
+    std::unique_lock<std::mutex> lock(mWriterLock);
+    VerifyOrReturnError(mWriterThread.joinable(), CHIP_ERROR_INCORRECT_STATE);
+    // HandleWriteError is already scheduled to end the download.
+    ReturnErrorOnFailure(mWriteError);
+    // The previous block was not acknowledged while the queue is full.
+    VerifyOrReturnError(mQueueCount < kWriteQueueDepth, CHIP_ERROR_INCORRECT_STATE);
+
+    QueuedBlock & entry = mQueue[(mQueueHead + mQueueCount) % kWriteQueueDepth];
+    if (entry.capacity < block.size())
+    {
+        auto * data = static_cast<uint8_t *>(Platform::MemoryAlloc(block.size()));
+        VerifyOrReturnError(data != nullptr, CHIP_ERROR_NO_MEMORY);
+        if (entry.data != nullptr)
+        {
+            Platform::MemoryFree(entry.data);
+        }
+        entry.data     = data;
+        entry.capacity = block.size();
+    }
+    if (!block.empty())
+    {
+        memcpy(entry.data, block.data(), block.size());
+    }
+    entry.size = block.size();
+    mQueueCount++;
+
+    // Progress is that of the blocks written so far.
+    mParams.downloadedBytes = mWrittenBytes;
+    mParams.totalFileBytes  = mWriterPayloadSize;
+
+    // When the queue is full, the writer thread acknowledges the block once it has written the oldest one.
+    mFetchDeferred = (mQueueCount == kWriteQueueDepth);
+    bool fetchNow  = !mFetchDeferred;
+    lock.unlock();
+    mWriterWake.notify_one();
+
+    if (fetchNow)
+    {
+        DeviceLayer::PlatformMgr().ScheduleWork(HandleBlockQueued, reinterpret_cast<intptr_t>(this));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageProcessorImpl::StartWriter()
+{
+    StopWriter(/* discardQueued = */ true);
+
+    mWriterStop         = false;
+    mDiscardQueued      = false;
+    mFetchDeferred      = false;
+    mWriteError         = CHIP_NO_ERROR;
+    mWriterPayloadSize  = 0;
+    mWrittenBytes       = 0;
+    mWriteErrorReported = false;
+    mDigestLength       = 0;
+    mWriterThread       = std::thread(&OTAImageProcessorImpl::WriterThreadMain, this);
+}
+
+CHIP_ERROR OTAImageProcessorImpl::StopWriter(bool discardQueued)
+{
+    VerifyOrReturnError(mWriterThread.joinable(), CHIP_NO_ERROR);
+
+    {
+        std::lock_guard<std::mutex> lock(mWriterLock);
+        mWriterStop    = true;
+        mDiscardQueued = discardQueued;
+    }
+    mWriterWake.notify_one();
+    mWriterThread.join();
+
+    for (auto & entry : mQueue)
+    {
+        if (entry.data != nullptr)
+        {
+            Platform::MemoryFree(entry.data);
+        }
+        entry = QueuedBlock();
+    }
+    mQueueHead  = 0;
+    mQueueCount = 0;
+    if (discardQueued)
+    {
+        mPayloadHash.Clear();
+    }
+
+    return mWriteError;
+}
+
+void OTAImageProcessorImpl::WriterThreadMain()
+{
+    std::unique_lock<std::mutex> lock(mWriterLock);
+    while (true)
+    {
+        mWriterWake.wait(lock, [this] { return mWriterStop || mQueueCount > 0; });
+        if (mQueueCount == 0 || mDiscardQueued)
+        {
+            break;
+        }
+
+        // QueueBlock only fills the other entries while this one is written.
+        const QueuedBlock & entry = mQueue[mQueueHead];
+        bool failed               = (mWriteError != CHIP_NO_ERROR);
+        lock.unlock();
+        CHIP_ERROR err = failed ? CHIP_NO_ERROR : WriteBlock(ByteSpan(entry.data, entry.size));
+        lock.lock();
+
+        mQueueHead = (mQueueHead + 1) % kWriteQueueDepth;
+        mQueueCount--;
+
+        if (err != CHIP_NO_ERROR)
+        {
+            mWriteError = err;
+            DeviceLayer::PlatformMgr().ScheduleWork(HandleWriteError, reinterpret_cast<intptr_t>(this));
+        }
+        else if (mFetchDeferred && !failed)
+        {
+            mFetchDeferred = false;
+            DeviceLayer::PlatformMgr().ScheduleWork(HandleBlockQueued, reinterpret_cast<intptr_t>(this));
+        }
+    }
+}
+
+CHIP_ERROR OTAImageProcessorImpl::WriteBlock(ByteSpan block)
+{
+    if (ProcessHeader(block) != CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
+        return CHIP_ERROR_INVALID_FILE_IDENTIFIER;
+    }
+    VerifyOrReturnError(!block.empty(), CHIP_NO_ERROR);
+
+    // Flush every block, so that running out of space is noticed while the download is still in progress.
+    if (!mOfs.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size())) || !mOfs.flush())
+    {
+        ChipLogError(SoftwareUpdate, "Cannot write OTA image block");
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (mDigestLength > 0)
+    {
+        ReturnErrorOnFailure(mPayloadHash.AddData(block));
+    }
+
+    std::lock_guard<std::mutex> lock(mWriterLock);
+    mWrittenBytes += block.size();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::StartDigest(const OTAImageHeader & header)
+{
+    mDigestLength = Sha256DigestLength(header.mImageDigestType);
+    if (mDigestLength == 0)
+    {
+        ChipLogProgress(SoftwareUpdate, "Not checking image digest of type %u", static_cast<unsigned>(header.mImageDigestType));
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(header.mImageDigest.size() == mDigestLength, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    memcpy(mExpectedDigest, header.mImageDigest.data(), mDigestLength);
+    return mPayloadHash.Begin();
+}
+
+CHIP_ERROR OTAImageProcessorImpl::FinishImage()
+{
+    mOfs.close();
+    VerifyOrReturnError(!mOfs.fail(), CHIP_ERROR_WRITE_FAILED);
+    // The image ended before its header did.
+    VerifyOrReturnError(!mHeaderParser.IsInitialized(), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+
+    if (mDigestLength > 0)
+    {
+        uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+        MutableByteSpan digest(digestBuffer);
+        ReturnErrorOnFailure(mPayloadHash.Finish(digest));
+        if (memcmp(digest.data(), mExpectedDigest, mDigestLength) != 0)
+        {
+            ChipLogError(SoftwareUpdate, "OTA image digest does not match its header");
+            return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR OTAImageProcessorImpl::SetBlock(ByteSpan & block)
 {
     if (block.empty())
@@ -19,11 +19,15 @@
 #pragma once
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/OTAImageHeader.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/OTAImageProcessor.h>
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 namespace chip {
 
@@ -33,6 +37,11 @@ static char kImageExecPath[] = "/tmp/ota.update";
 class OTAImageProcessorImpl : public OTAImageProcessorInterface
 {
 public:
+    /// Number of blocks that may be queued for the writer thread in pipelined mode.
+    static constexpr size_t kWriteQueueDepth = 8;
+
+    ~OTAImageProcessorImpl();
+
     //////////// OTAImageProcessorInterface Implementation ///////////////
     CHIP_ERROR PrepareDownload() override;
     CHIP_ERROR Finalize() override;
@@ -45,16 +54,53 @@ public:
     void SetOTADownloader(OTADownloader * downloader) { mDownloader = downloader; }
     void SetOTAImageFile(const char * imageFile) { mImageFile = imageFile; }
 
+    /**
+     * Enable or disable pipelined writes, to be called before PrepareDownload.
+     *
+     * In pipelined mode, each block is copied to a queue of up to kWriteQueueDepth blocks and acknowledged right away,
+     * while a writer thread checks the image header, writes and flushes the blocks and computes the digest of the
+     * payload. A write error ends the download as soon as the writer thread reports it. Finalize returns
+     * CHIP_ERROR_IN_PROGRESS and waits in background work for the queued blocks to be written, then checks the payload
+     * digest and reports the result to OTADownloader::OnFinalized, so that an image that could not be stored fails the
+     * download before the last block is acknowledged.
+     */
+    void SetPipelinedWrites(bool enabled) { mPipelinedWrites = enabled; }
+
 private:
+    friend class TestOTAImageProcessorImpl;
+
     //////////// Actual handlers for the OTAImageProcessorInterface ///////////////
     static void HandlePrepareDownload(intptr_t context);
     static void HandleFinalize(intptr_t context);
     static void HandleApply(intptr_t context);
     static void HandleAbort(intptr_t context);
     static void HandleProcessBlock(intptr_t context);
+    static void HandleBlockQueued(intptr_t context);
+    static void HandleWriteError(intptr_t context);
+    static void HandleFinalizeInBackground(intptr_t context);
+    static void HandleFinalized(intptr_t context);
 
     CHIP_ERROR ProcessHeader(ByteSpan & block);
 
+    //////////// Pipelined writes ///////////////
+    CHIP_ERROR QueueBlock(const ByteSpan & block);
+    void StartWriter();
+    /**
+     * Stop the writer thread, after it wrote the queued blocks unless discardQueued is set, and return the first error
+     * it encountered.
+     */
+    CHIP_ERROR StopWriter(bool discardQueued);
+    void WriterThreadMain();
+    /**
+     * Called on the writer thread for each queued block.
+     */
+    CHIP_ERROR WriteBlock(ByteSpan block);
+    CHIP_ERROR StartDigest(const OTAImageHeader & header);
+    /**
+     * Called once the writer thread is stopped to close the image file and check the payload digest.
+     */
+    CHIP_ERROR FinishImage();
+
     /**
      * Called to allocate memory for mBlock if necessary and set it to block
      */
@@ -70,6 +116,38 @@ private:
     OTADownloader * mDownloader;
     OTAImageHeaderParser mHeaderParser;
     const char * mImageFile = nullptr;
+
+    struct QueuedBlock
+    {
+        uint8_t * data  = nullptr;
+        size_t capacity = 0;
+        size_t size     = 0;
+    };
+
+    bool mPipelinedWrites = false;
+    std::thread mWriterThread;
+    // Protects the members below, up to mWrittenBytes, shared with the writer thread.
+    std::mutex mWriterLock;
+    std::condition_variable mWriterWake;
+    QueuedBlock mQueue[kWriteQueueDepth];
+    size_t mQueueHead           = 0; // Next block to be written.
+    size_t mQueueCount          = 0;
+    bool mWriterStop            = false;
+    bool mDiscardQueued         = false;
+    bool mFetchDeferred         = false; // The last queued block filled the queue and was not acknowledged yet.
+    CHIP_ERROR mWriteError      = CHIP_NO_ERROR;
+    uint64_t mWriterPayloadSize = 0; // Payload size from the image header, once the writer thread decoded it.
+    uint64_t mWrittenBytes      = 0; // Payload bytes written by the writer thread.
+    // Only used on the Matter thread.
+    bool mWriteErrorReported = false;
+    bool mFinalizing         = false; // Background work owns the writer thread and the image file until HandleFinalized.
+    bool mAbortRequested     = false; // Abort was called while finalizing.
+    // Set by background work before it schedules HandleFinalized.
+    CHIP_ERROR mFinalizeError = CHIP_NO_ERROR;
+    // Only used by the writer thread while it runs.
+    Crypto::Hash_SHA256_stream mPayloadHash;
+    uint8_t mExpectedDigest[Crypto::kSHA256_Hash_Length];
+    size_t mDigestLength = 0; // 0 when the payload digest is not checked.
 };
 
 } // namespace chip
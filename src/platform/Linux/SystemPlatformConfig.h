@@ -42,3 +42,7 @@ struct ChipDeviceEvent;
 
 // ========== Platform-specific Configuration Overrides =========
 #define CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS 5
+
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE 16
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
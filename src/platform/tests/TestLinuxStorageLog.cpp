@@ -0,0 +1,564 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the log-structured Linux
+ *      key-value store, and compares its throughput with the INI backend.
+ *
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr char kLogPath[] = LOCALSTATEDIR "/chip_kvs_log_test";
+constexpr char kIniPath[] = LOCALSTATEDIR "/chip_kvs_ini_test.ini";
+
+const uint8_t kValue[]      = { 0x15, 0x24, 0x00, 0x01, 0x18 };
+const uint8_t kOtherValue[] = { 0x15, 0x24, 0x00, 0x02, 0x25, 0x01, 0x34, 0x12, 0x18 };
+
+void RemoveTestFiles()
+{
+    unlink(kLogPath);
+    unlink(kIniPath);
+}
+
+size_t FileSize(const char * path)
+{
+    FILE * file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size < 0 ? 0 : static_cast<size_t>(size);
+}
+
+// Returns a descriptor this process has open on path, or -1.
+int FindOpenDescriptor(const char * path)
+{
+    char resolved[PATH_MAX];
+    VerifyOrReturnValue(realpath(path, resolved) != nullptr, -1);
+
+    DIR * dir = opendir("/proc/self/fd");
+    VerifyOrReturnValue(dir != nullptr, -1);
+
+    int fd = -1;
+    for (struct dirent * entry = readdir(dir); entry != nullptr && fd < 0; entry = readdir(dir))
+    {
+        char link[64];
+        char target[PATH_MAX];
+        snprintf(link, sizeof(link), "/proc/self/fd/%s", entry->d_name);
+        ssize_t length = readlink(link, target, sizeof(target) - 1);
+        if (length > 0)
+        {
+            target[length] = '\0';
+            if (strcmp(target, resolved) == 0)
+            {
+                fd = atoi(entry->d_name);
+            }
+        }
+    }
+    closedir(dir);
+    return fd;
+}
+
+void TestPutGetDelete(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t buf[sizeof(kOtherValue)];
+    size_t readSize = 0;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Delete("k") == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, store.Put("k", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue) && memcmp(buf, kValue, sizeof(kValue)) == 0);
+
+    // Overwrite with a longer value, then read it back partially and at an offset.
+    NL_TEST_ASSERT(inSuite, store.Put("k", kOtherValue, sizeof(kOtherValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, 4, &readSize) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, readSize == 4 && memcmp(buf, kOtherValue, 4) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kOtherValue) - 4 && memcmp(buf, kOtherValue + 4, readSize) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize, sizeof(kOtherValue) + 1) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Empty values are stored as such.
+    NL_TEST_ASSERT(inSuite, store.Put("empty", nullptr, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("empty", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == 0);
+
+    NL_TEST_ASSERT(inSuite, store.Delete("k") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    ChipLinuxStorageLog::Stats stats = store.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.puts == 3);
+    NL_TEST_ASSERT(inSuite, stats.deletes == 1);
+    NL_TEST_ASSERT(inSuite, stats.commits == 4);
+    NL_TEST_ASSERT(inSuite, stats.logBytes == FileSize(kLogPath));
+
+    store.Shutdown();
+    NL_TEST_ASSERT(inSuite, store.Put("k", kValue, sizeof(kValue)) == CHIP_ERROR_INCORRECT_STATE);
+    RemoveTestFiles();
+}
+
+void TestRecovery(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t buf[sizeof(kOtherValue)];
+    size_t readSize = 0;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Put("a", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Put("b", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Delete("a") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Put("b", kOtherValue, sizeof(kOtherValue)) == CHIP_NO_ERROR);
+    size_t completeSize = FileSize(kLogPath);
+    store.Shutdown();
+
+    // Reopening replays the log.
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("a", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Get("b", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kOtherValue) && memcmp(buf, kOtherValue, sizeof(kOtherValue)) == 0);
+    NL_TEST_ASSERT(inSuite, store.GetStats().logBytes == completeSize);
+    store.Shutdown();
+
+    // Simulate a crash in the middle of appending a record: a partial header and a record with a bad CRC.
+    FILE * file = fopen(kLogPath, "ab");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    const uint8_t torn[] = { 0xde, 0xad, 0xbe, 0xef, 0x05, 0x00, 0x00, 0x00, 0x01, 0x01, 'c', 0x15, 0x24 };
+    fwrite(torn, 1, sizeof(torn), file);
+    fclose(file);
+
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, FileSize(kLogPath) == completeSize);
+    NL_TEST_ASSERT(inSuite, store.Get("c", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Get("b", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+
+    // Records appended after recovery land right after the last good one.
+    NL_TEST_ASSERT(inSuite, store.Put("c", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+    store.Shutdown();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("c", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue));
+    store.Shutdown();
+
+    // A file that is neither a KVS log nor an INI store is left alone.
+    file = fopen(kLogPath, "wb");
+    NL_TEST_ASSERT(inSuite, file != nullptr);
+    fputs("[Default]\nkey=value\n", file);
+    fclose(file);
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    NL_TEST_ASSERT(inSuite, FileSize(kLogPath) == strlen("[Default]\nkey=value\n"));
+
+    RemoveTestFiles();
+}
+
+void TestImportIni(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t buf[sizeof(kOtherValue)];
+    size_t readSize = 0;
+
+    // A store written by the INI backend, with a key that it escapes.
+    RemoveTestFiles();
+    {
+        ChipLinuxStorage ini;
+        NL_TEST_ASSERT(inSuite, ini.Init(kLogPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("f/1/n", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("key = value", kOtherValue, sizeof(kOtherValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Is imported when first opened as a log, and then kept as a log.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, store.Get("f/1/n", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue) && memcmp(buf, kValue, sizeof(kValue)) == 0);
+        NL_TEST_ASSERT(inSuite, store.Get("key = value", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == sizeof(kOtherValue) && memcmp(buf, kOtherValue, sizeof(kOtherValue)) == 0);
+        NL_TEST_ASSERT(inSuite, store.GetStats().logBytes == FileSize(kLogPath));
+        if (pass == 0)
+        {
+            NL_TEST_ASSERT(inSuite, store.Put("f/2/n", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, store.Get("f/2/n", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+        }
+        store.Shutdown();
+    }
+
+    RemoveTestFiles();
+}
+
+void TestFailedCommit(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t buf[sizeof(kOtherValue)];
+    size_t readSize = 0;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Put("k", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+
+    // Make every further write to the log fail, and the truncate that would take back a failed batch too.
+    int logFd  = FindOpenDescriptor(kLogPath);
+    int fullFd = open("/dev/full", O_WRONLY | O_CLOEXEC);
+    NL_TEST_ASSERT(inSuite, logFd >= 0 && fullFd >= 0);
+    NL_TEST_ASSERT(inSuite, logFd >= 0 && fullFd >= 0 && dup2(fullFd, logFd) == logFd);
+    if (fullFd >= 0)
+    {
+        close(fullFd);
+    }
+
+    NL_TEST_ASSERT(inSuite, store.Put("k", kOtherValue, sizeof(kOtherValue)) == CHIP_ERROR_WRITE_FAILED);
+    NL_TEST_ASSERT(inSuite, store.Put("new", kValue, sizeof(kValue)) == CHIP_ERROR_WRITE_FAILED);
+    NL_TEST_ASSERT(inSuite, store.Delete("k") == CHIP_ERROR_WRITE_FAILED);
+
+    // None of the failed writes are visible.
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue) && memcmp(buf, kValue, sizeof(kValue)) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("new", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    store.Shutdown();
+
+    // The log on disk agrees with what was read.
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue) && memcmp(buf, kValue, sizeof(kValue)) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("new", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    store.Shutdown();
+    RemoveTestFiles();
+}
+
+void TestRetryAfterFailedCommit(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t buf[sizeof(kOtherValue)];
+    size_t readSize = 0;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Put("k", kValue, sizeof(kValue)) == CHIP_NO_ERROR);
+    const size_t committedSize = FileSize(kLogPath);
+
+    // Let the log grow by only a few bytes, as on a disk about to be full: the next batch is partly written.
+    struct rlimit savedLimit;
+    NL_TEST_ASSERT(inSuite, getrlimit(RLIMIT_FSIZE, &savedLimit) == 0);
+    struct rlimit limit = savedLimit;
+    limit.rlim_cur      = committedSize + 4;
+
+    // Writes past the limit then fail with EFBIG instead of raising SIGXFSZ.
+    void (*savedHandler)(int) = signal(SIGXFSZ, SIG_IGN);
+    NL_TEST_ASSERT(inSuite, setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+    NL_TEST_ASSERT(inSuite, store.Put("k", kOtherValue, sizeof(kOtherValue)) == CHIP_ERROR_WRITE_FAILED);
+    NL_TEST_ASSERT(inSuite, store.Put("new", kValue, sizeof(kValue)) == CHIP_ERROR_WRITE_FAILED);
+
+    NL_TEST_ASSERT(inSuite, setrlimit(RLIMIT_FSIZE, &savedLimit) == 0);
+    signal(SIGXFSZ, savedHandler);
+
+    // The failed batches were taken back, and once there is room again the store accepts writes.
+    NL_TEST_ASSERT(inSuite, FileSize(kLogPath) == committedSize);
+    NL_TEST_ASSERT(inSuite, store.Get("new", buf, sizeof(buf), &readSize) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, store.Put("new", kOtherValue, sizeof(kOtherValue)) == CHIP_NO_ERROR);
+    store.Shutdown();
+
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, store.Get("k", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kValue) && memcmp(buf, kValue, sizeof(kValue)) == 0);
+    NL_TEST_ASSERT(inSuite, store.Get("new", buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(kOtherValue) && memcmp(buf, kOtherValue, sizeof(kOtherValue)) == 0);
+    store.Shutdown();
+    RemoveTestFiles();
+}
+
+void TestCompaction(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog store;
+    uint8_t value[256];
+    uint8_t buf[sizeof(value)];
+    size_t readSize = 0;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+
+    // Overwrite a handful of keys until most of the log is garbage, which wakes the compaction thread.
+    constexpr unsigned kKeys = 4;
+    for (unsigned round = 0; round < 128; round++)
+    {
+        memset(value, static_cast<int>(round), sizeof(value));
+        for (unsigned i = 0; i < kKeys; i++)
+        {
+            char key[16];
+            snprintf(key, sizeof(key), "key/%u", i);
+            NL_TEST_ASSERT(inSuite, store.Put(key, value, sizeof(value)) == CHIP_NO_ERROR);
+        }
+    }
+
+    for (int i = 0; i < 1000 && store.GetStats().compactions == 0; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    NL_TEST_ASSERT(inSuite, store.GetStats().compactions > 0);
+
+    // An explicit compaction leaves exactly the live records.
+    NL_TEST_ASSERT(inSuite, store.Compact() == CHIP_NO_ERROR);
+    ChipLinuxStorageLog::Stats stats = store.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.logBytes == stats.liveBytes);
+    NL_TEST_ASSERT(inSuite, FileSize(kLogPath) == stats.liveBytes);
+    NL_TEST_ASSERT(inSuite, stats.liveBytes < 2 * kKeys * sizeof(value));
+    store.Shutdown();
+
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    for (unsigned i = 0; i < kKeys; i++)
+    {
+        char key[16];
+        snprintf(key, sizeof(key), "key/%u", i);
+        NL_TEST_ASSERT(inSuite, store.Get(key, buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(buf, value, sizeof(value)) == 0);
+    }
+    store.Shutdown();
+
+    RemoveTestFiles();
+}
+
+void TestGroupCommit(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr unsigned kThreads   = 4;
+    constexpr unsigned kPerThread = 200;
+
+    ChipLinuxStorageLog store;
+
+    RemoveTestFiles();
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+
+    std::thread writers[kThreads];
+    bool ok[kThreads];
+    for (unsigned t = 0; t < kThreads; t++)
+    {
+        ok[t]      = true;
+        writers[t] = std::thread([&store, &ok, t] {
+            for (unsigned i = 0; i < kPerThread; i++)
+            {
+                char key[16];
+                snprintf(key, sizeof(key), "t%u/%u", t, i);
+                ok[t] = ok[t] && store.Put(key, &i, sizeof(i)) == CHIP_NO_ERROR;
+            }
+        });
+    }
+    for (auto & writer : writers)
+    {
+        writer.join();
+    }
+
+    ChipLinuxStorageLog::Stats stats = store.GetStats();
+    NL_TEST_ASSERT(inSuite, stats.puts == kThreads * kPerThread);
+    NL_TEST_ASSERT(inSuite, stats.commits <= stats.puts);
+    ChipLogProgress(DeviceLayer, "%u concurrent puts needed %u commits", static_cast<unsigned>(stats.puts),
+                    static_cast<unsigned>(stats.commits));
+    store.Shutdown();
+
+    NL_TEST_ASSERT(inSuite, store.Init(kLogPath) == CHIP_NO_ERROR);
+    for (unsigned t = 0; t < kThreads; t++)
+    {
+        NL_TEST_ASSERT(inSuite, ok[t]);
+        for (unsigned i = 0; i < kPerThread; i++)
+        {
+            char key[16];
+            unsigned readValue = 0;
+            snprintf(key, sizeof(key), "t%u/%u", t, i);
+            NL_TEST_ASSERT(inSuite, store.Get(key, &readValue, sizeof(readValue)) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, readValue == i);
+        }
+    }
+    store.Shutdown();
+
+    RemoveTestFiles();
+}
+
+uint64_t NowUs()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+uint64_t OpsPerSecond(uint32_t ops, uint64_t us)
+{
+    return us == 0 ? 0 : ops * 1000000ull / us;
+}
+
+void BenchmarkAgainstIni(nlTestSuite * inSuite, void * inContext)
+{
+    // Every operation of the log store is timed over all the keys. Every INI write rewrites the whole store, so the INI
+    // store holds as many keys but is timed over a sample of the operations.
+    constexpr uint32_t kKeyCount   = 10000;
+    constexpr uint32_t kIniSamples = 20;
+
+    uint8_t value[64];
+    uint8_t buf[sizeof(value)];
+    size_t readSize = 0;
+    char key[16];
+    memset(value, 0xA5, sizeof(value));
+
+    RemoveTestFiles();
+
+    // Log store: put, get and delete every key.
+    ChipLinuxStorageLog log;
+    NL_TEST_ASSERT(inSuite, log.Init(kLogPath) == CHIP_NO_ERROR);
+
+    uint64_t start = NowUs();
+    for (uint32_t i = 0; i < kKeyCount; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, log.Put(key, value, sizeof(value)) == CHIP_NO_ERROR);
+    }
+    uint64_t logPutUs = NowUs() - start;
+
+    start = NowUs();
+    for (uint32_t i = 0; i < kKeyCount; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, log.Get(key, buf, sizeof(buf), &readSize) == CHIP_NO_ERROR);
+    }
+    uint64_t logGetUs = NowUs() - start;
+
+    start = NowUs();
+    for (uint32_t i = 0; i < kKeyCount; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, log.Delete(key) == CHIP_NO_ERROR);
+    }
+    uint64_t logDeleteUs = NowUs() - start;
+    log.Shutdown();
+
+    // INI store: fill it with the same keys in one commit, then time each operation the way KeyValueStoreManagerImpl does it.
+    ChipLinuxStorage ini;
+    NL_TEST_ASSERT(inSuite, ini.Init(kIniPath) == CHIP_NO_ERROR);
+    for (uint32_t i = 0; i < kKeyCount; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin(key, value, sizeof(value)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+
+    start = NowUs();
+    for (uint32_t i = 0; i < kIniSamples; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin(key, value, sizeof(value)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+    }
+    uint64_t iniPutUs = NowUs() - start;
+
+    start = NowUs();
+    for (uint32_t i = 0; i < kIniSamples; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, ini.ReadValueBin(key, buf, sizeof(buf), readSize) == CHIP_NO_ERROR);
+    }
+    uint64_t iniGetUs = NowUs() - start;
+
+    start = NowUs();
+    for (uint32_t i = 0; i < kIniSamples; i++)
+    {
+        snprintf(key, sizeof(key), "b/%" PRIu32, i);
+        NL_TEST_ASSERT(inSuite, ini.ClearValue(key) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+    }
+    uint64_t iniDeleteUs = NowUs() - start;
+
+    ChipLogProgress(DeviceLayer, "KVS at %u keys, ops/s log vs ini: put %" PRIu64 " vs %" PRIu64 ", get %" PRIu64 " vs %" PRIu64
+                    ", delete %" PRIu64 " vs %" PRIu64,
+                    static_cast<unsigned>(kKeyCount), OpsPerSecond(kKeyCount, logPutUs), OpsPerSecond(kIniSamples, iniPutUs),
+                    OpsPerSecond(kKeyCount, logGetUs), OpsPerSecond(kIniSamples, iniGetUs), OpsPerSecond(kKeyCount, logDeleteUs),
+                    OpsPerSecond(kIniSamples, iniDeleteUs));
+
+    RemoveTestFiles();
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Put, get and delete", TestPutGetDelete),
+    NL_TEST_DEF("Recovery", TestRecovery),
+    NL_TEST_DEF("Import of an INI store", TestImportIni),
+    NL_TEST_DEF("Failed commit", TestFailedCommit),
+    NL_TEST_DEF("Retry after a failed commit", TestRetryAfterFailedCommit),
+    NL_TEST_DEF("Compaction", TestCompaction),
+    NL_TEST_DEF("Group commit", TestGroupCommit),
+    NL_TEST_DEF("Benchmark against INI", BenchmarkAgainstIni),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestLinuxStorageLog_Setup(void * inContext)
+{
+    VerifyOrReturnError(chip::Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int TestLinuxStorageLog_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestLinuxStorageLog()
+{
+    nlTestSuite theSuite = { "Linux log-structured KVS tests", &sTests[0], TestLinuxStorageLog_Setup,
+                             TestLinuxStorageLog_Teardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxStorageLog)
@@ -0,0 +1,483 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the pipelined writes of the
+ *      Linux OTA image processor.
+ *
+ */
+
+#include <app/clusters/ota-requestor/OTADownloader.h>
+#include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/UnitTestUtils.h>
+#include <nlunit-test.h>
+
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/Linux/OTAImageProcessorImpl.h>
+#include <platform/TestOnlyCommissionableDataProvider.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <stdlib.h>
+#include <streambuf>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using chip::ByteSpan;
+using chip::OTADownloader;
+using chip::OTAImageDigestType;
+using chip::OTAImageProcessorImpl;
+using chip::DeviceLayer::PlatformMgr;
+
+namespace Crypto   = chip::Crypto;
+namespace Encoding = chip::Encoding;
+namespace TLV      = chip::TLV;
+
+namespace chip {
+
+// The image processor only asks the requestor for its state when the image is applied or confirmed.
+OTARequestorInterface * GetRequestorInstance()
+{
+    return nullptr;
+}
+
+class TestOTAImageProcessorImpl
+{
+public:
+    // Sends the writes of the writer thread to buffer instead of the image file.
+    static void SetWriteBuffer(OTAImageProcessorImpl & processor, std::streambuf * buffer)
+    {
+        static_cast<std::ios &>(processor.mOfs).rdbuf(buffer);
+    }
+};
+
+} // namespace chip
+
+using chip::TestOTAImageProcessorImpl;
+
+namespace {
+
+constexpr size_t kBlockSize   = 64;
+constexpr size_t kPayloadSize = 1024;
+
+class FakeDownloader : public OTADownloader
+{
+public:
+    CHIP_ERROR BeginPrepareDownload() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR OnPreparedForDownload(CHIP_ERROR status) override
+    {
+        prepared       = true;
+        preparedStatus = status;
+        return CHIP_NO_ERROR;
+    }
+    void OnDownloadTimeout() override {}
+    void EndDownload(CHIP_ERROR reason) override
+    {
+        endCalls++;
+        endReason = reason;
+    }
+    CHIP_ERROR FetchNextData() override
+    {
+        fetches++;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR OnFinalized(CHIP_ERROR status) override
+    {
+        finalizedCalls++;
+        finalizedStatus = status;
+        return CHIP_NO_ERROR;
+    }
+
+    // Only used with the stack locked.
+    bool prepared              = false;
+    CHIP_ERROR preparedStatus  = CHIP_NO_ERROR;
+    size_t fetches             = 0;
+    int endCalls               = 0;
+    CHIP_ERROR endReason       = CHIP_NO_ERROR;
+    int finalizedCalls         = 0;
+    CHIP_ERROR finalizedStatus = CHIP_NO_ERROR;
+};
+
+// Holds the writer thread in its first write until opened, and fails the writes past failAfter bytes.
+class GatedStreamBuf : public std::streambuf
+{
+public:
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mOpen = true;
+        mOpened.notify_all();
+    }
+
+    bool IsHolding()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mHolding;
+    }
+
+    size_t failAfter = SIZE_MAX;
+
+protected:
+    std::streamsize xsputn(const char * s, std::streamsize count) override
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mHolding = !mOpen;
+        mOpened.wait(lock, [this] { return mOpen; });
+        mHolding = false;
+        VerifyOrReturnValue(mWritten + static_cast<size_t>(count) <= failAfter, 0);
+        mWritten += static_cast<size_t>(count);
+        return count;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        char ch = traits_type::to_char_type(c);
+        return xsputn(&ch, 1) == 1 ? c : traits_type::eof();
+    }
+
+private:
+    std::mutex mMutex;
+    std::condition_variable mOpened;
+    bool mOpen      = false;
+    bool mHolding   = false;
+    size_t mWritten = 0;
+};
+
+// An image with a SHA-256 digest of its payload in its header, or of another payload if corruptDigest is set.
+std::vector<uint8_t> MakeImage(bool corruptDigest)
+{
+    std::vector<uint8_t> payload(kPayloadSize);
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    uint8_t digest[Crypto::kSHA256_Hash_Length];
+    VerifyOrReturnValue(Crypto::Hash_SHA256(payload.data(), payload.size(), digest) == CHIP_NO_ERROR, {});
+    if (corruptDigest)
+    {
+        digest[0] = static_cast<uint8_t>(digest[0] ^ 0xFF);
+    }
+
+    uint8_t tlv[256];
+    TLV::TLVWriter writer;
+    TLV::TLVType outerType;
+    writer.Init(tlv);
+    VerifyOrReturnValue(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outerType) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(0), static_cast<uint16_t>(0xFFF1)) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(1), static_cast<uint16_t>(0x8001)) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(2), static_cast<uint32_t>(2)) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.PutString(TLV::ContextTag(3), "2.0") == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(4), static_cast<uint64_t>(payload.size())) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(8), static_cast<uint8_t>(OTAImageDigestType::kSha256)) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Put(TLV::ContextTag(9), ByteSpan(digest)) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.EndContainer(outerType) == CHIP_NO_ERROR, {});
+    VerifyOrReturnValue(writer.Finalize() == CHIP_NO_ERROR, {});
+    const uint32_t headerSize = writer.GetLengthWritten();
+
+    std::vector<uint8_t> image(16 + headerSize);
+    Encoding::LittleEndian::Put32(&image[0], chip::kOTAImageFileIdentifier);
+    Encoding::LittleEndian::Put64(&image[4], image.size() + payload.size());
+    Encoding::LittleEndian::Put32(&image[12], headerSize);
+    memcpy(&image[16], tlv, headerSize);
+    image.insert(image.end(), payload.begin(), payload.end());
+    return image;
+}
+
+// Polls predicate with the stack locked, as the event loop thread changes what it checks.
+template <typename Predicate>
+bool WaitFor(Predicate predicate)
+{
+    for (size_t t = 0; t < 1000; t++)
+    {
+        PlatformMgr().LockChipStack();
+        bool done = predicate();
+        PlatformMgr().UnlockChipStack();
+        if (done)
+        {
+            return true;
+        }
+        chip::test_utils::SleepMillis(1);
+    }
+    return false;
+}
+
+struct PipelinedDownload
+{
+    // Declared before the processor, which keeps a pointer to it.
+    GatedStreamBuf writeBuffer;
+    FakeDownloader downloader;
+    OTAImageProcessorImpl processor;
+    std::string path;
+    std::vector<uint8_t> image;
+
+    ~PipelinedDownload()
+    {
+        // Let the writer thread finish, should a test have failed while holding it.
+        writeBuffer.Open();
+        if (!path.empty())
+        {
+            unlink(path.c_str());
+        }
+    }
+
+    size_t BlockCount() const { return (image.size() + kBlockSize - 1) / kBlockSize; }
+    // Index of the first block with payload data, which is the first one to be written to the image file.
+    size_t FirstPayloadBlock() const { return (image.size() - kPayloadSize) / kBlockSize; }
+
+    bool Prepare(nlTestSuite * inSuite, bool corruptDigest, bool useWriteBuffer)
+    {
+        char pathTemplate[] = "/tmp/ota-image-XXXXXX";
+        int fd              = mkstemp(pathTemplate);
+        NL_TEST_ASSERT(inSuite, fd >= 0);
+        VerifyOrReturnValue(fd >= 0, false);
+        close(fd);
+        path = pathTemplate;
+
+        image = MakeImage(corruptDigest);
+        NL_TEST_ASSERT(inSuite, !image.empty());
+        VerifyOrReturnValue(!image.empty(), false);
+
+        processor.SetOTADownloader(&downloader);
+        processor.SetOTAImageFile(path.c_str());
+        processor.SetPipelinedWrites(true);
+
+        PlatformMgr().LockChipStack();
+        NL_TEST_ASSERT(inSuite, processor.PrepareDownload() == CHIP_NO_ERROR);
+        PlatformMgr().UnlockChipStack();
+        NL_TEST_ASSERT(inSuite, WaitFor([this] { return downloader.prepared; }));
+        NL_TEST_ASSERT(inSuite, downloader.preparedStatus == CHIP_NO_ERROR);
+        VerifyOrReturnValue(downloader.prepared && downloader.preparedStatus == CHIP_NO_ERROR, false);
+
+        if (useWriteBuffer)
+        {
+            // No block is queued yet, so the writer thread is not using the stream.
+            TestOTAImageProcessorImpl::SetWriteBuffer(processor, &writeBuffer);
+        }
+        else
+        {
+            writeBuffer.Open();
+        }
+        return true;
+    }
+
+    CHIP_ERROR QueueBlock(size_t index)
+    {
+        size_t offset = index * kBlockSize;
+        ByteSpan block(image.data() + offset, std::min(kBlockSize, image.size() - offset));
+
+        PlatformMgr().LockChipStack();
+        CHIP_ERROR err = processor.ProcessBlock(block);
+        PlatformMgr().UnlockChipStack();
+        return err;
+    }
+
+    // Queues blocks from first on, each once the previous one was acknowledged, as BDXDownloader does. Stops when the
+    // download is ended.
+    void QueueBlocks(nlTestSuite * inSuite, size_t first)
+    {
+        for (size_t index = first; index < BlockCount(); index++)
+        {
+            NL_TEST_ASSERT(inSuite, WaitFor([this, index] { return downloader.fetches >= index || downloader.endCalls > 0; }));
+            bool ended;
+            PlatformMgr().LockChipStack();
+            ended = downloader.endCalls > 0;
+            PlatformMgr().UnlockChipStack();
+            VerifyOrReturn(!ended);
+
+            // A block queued while the writer thread fails is refused, and the download is then ended.
+            if (QueueBlock(index) != CHIP_NO_ERROR)
+            {
+                NL_TEST_ASSERT(inSuite, WaitFor([this] { return downloader.endCalls > 0; }));
+                return;
+            }
+        }
+    }
+
+    CHIP_ERROR Finalize(nlTestSuite * inSuite)
+    {
+        PlatformMgr().LockChipStack();
+        NL_TEST_ASSERT(inSuite, processor.Finalize() == CHIP_ERROR_IN_PROGRESS);
+        PlatformMgr().UnlockChipStack();
+
+        NL_TEST_ASSERT(inSuite, WaitFor([this] { return downloader.finalizedCalls > 0; }));
+        PlatformMgr().LockChipStack();
+        NL_TEST_ASSERT(inSuite, downloader.finalizedCalls == 1);
+        CHIP_ERROR status = downloader.finalizedStatus;
+        PlatformMgr().UnlockChipStack();
+        return status;
+    }
+
+    // Aborts the download and waits for the event loop to have handled it.
+    void Abort(nlTestSuite * inSuite)
+    {
+        bool aborted = false;
+        PlatformMgr().LockChipStack();
+        NL_TEST_ASSERT(inSuite, processor.Abort() == CHIP_NO_ERROR);
+        PlatformMgr().ScheduleWork([](intptr_t arg) { *reinterpret_cast<bool *>(arg) = true; },
+                                   reinterpret_cast<intptr_t>(&aborted));
+        PlatformMgr().UnlockChipStack();
+        NL_TEST_ASSERT(inSuite, WaitFor([&aborted] { return aborted; }));
+    }
+};
+
+void TestFullWriteQueue(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kQueueDepth = OTAImageProcessorImpl::kWriteQueueDepth;
+
+    PipelinedDownload download;
+    VerifyOrReturn(download.Prepare(inSuite, /* corruptDigest = */ false, /* useWriteBuffer = */ true));
+    const size_t firstPayloadBlock = download.FirstPayloadBlock();
+    NL_TEST_ASSERT(inSuite, download.BlockCount() > firstPayloadBlock + kQueueDepth);
+
+    // The writer thread goes through the header blocks and holds on to the first payload block.
+    for (size_t index = 0; index <= firstPayloadBlock; index++)
+    {
+        NL_TEST_ASSERT(inSuite, download.QueueBlock(index) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, WaitFor([&download] { return download.writeBuffer.IsHolding(); }));
+
+    // So the queue fills up: the block that fills it is not acknowledged, and no further block can be queued.
+    const size_t fullIndex = firstPayloadBlock + kQueueDepth - 1;
+    for (size_t index = firstPayloadBlock + 1; index <= fullIndex; index++)
+    {
+        NL_TEST_ASSERT(inSuite, download.QueueBlock(index) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, WaitFor([&download, fullIndex] { return download.downloader.fetches == fullIndex; }));
+    NL_TEST_ASSERT(inSuite, download.QueueBlock(fullIndex + 1) == CHIP_ERROR_INCORRECT_STATE);
+
+    // Once the held block is written, the block that filled the queue is acknowledged.
+    download.writeBuffer.Open();
+    NL_TEST_ASSERT(inSuite, WaitFor([&download, fullIndex] { return download.downloader.fetches == fullIndex + 1; }));
+
+    download.QueueBlocks(inSuite, fullIndex + 1);
+    NL_TEST_ASSERT(inSuite, download.Finalize(inSuite) == CHIP_NO_ERROR);
+
+    PlatformMgr().LockChipStack();
+    NL_TEST_ASSERT(inSuite, download.downloader.endCalls == 0);
+    NL_TEST_ASSERT(inSuite, download.processor.GetBytesDownloaded() == kPayloadSize);
+    PlatformMgr().UnlockChipStack();
+}
+
+void TestWriteError(nlTestSuite * inSuite, void * inContext)
+{
+    PipelinedDownload download;
+    VerifyOrReturn(download.Prepare(inSuite, /* corruptDigest = */ false, /* useWriteBuffer = */ true));
+
+    // Fail partway through the payload.
+    download.writeBuffer.failAfter = kPayloadSize / 2;
+    download.writeBuffer.Open();
+    download.QueueBlocks(inSuite, 0);
+
+    NL_TEST_ASSERT(inSuite, WaitFor([&download] { return download.downloader.endCalls > 0; }));
+    PlatformMgr().LockChipStack();
+    NL_TEST_ASSERT(inSuite, download.downloader.endCalls == 1);
+    NL_TEST_ASSERT(inSuite, download.downloader.endReason == CHIP_ERROR_WRITE_FAILED);
+    NL_TEST_ASSERT(inSuite, download.downloader.fetches < download.BlockCount());
+    NL_TEST_ASSERT(inSuite, download.processor.GetBytesDownloaded() <= kPayloadSize / 2);
+    PlatformMgr().UnlockChipStack();
+
+    // Blocks that arrive after the error are refused with it.
+    NL_TEST_ASSERT(inSuite, download.QueueBlock(download.BlockCount() - 1) == CHIP_ERROR_WRITE_FAILED);
+
+    download.Abort(inSuite);
+    NL_TEST_ASSERT(inSuite, access(download.path.c_str(), F_OK) != 0);
+}
+
+void TestDigestMismatch(nlTestSuite * inSuite, void * inContext)
+{
+    PipelinedDownload download;
+    VerifyOrReturn(download.Prepare(inSuite, /* corruptDigest = */ true, /* useWriteBuffer = */ false));
+
+    download.QueueBlocks(inSuite, 0);
+    NL_TEST_ASSERT(inSuite, download.Finalize(inSuite) == CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    PlatformMgr().LockChipStack();
+    NL_TEST_ASSERT(inSuite, download.downloader.endCalls == 0);
+    NL_TEST_ASSERT(inSuite, download.processor.GetBytesDownloaded() == kPayloadSize);
+    PlatformMgr().UnlockChipStack();
+
+    download.Abort(inSuite);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test pipelined writes with a full write queue", TestFullWriteQueue),
+    NL_TEST_DEF("Test pipelined writes with a write error", TestWriteError),
+    NL_TEST_DEF("Test pipelined writes with a digest mismatch", TestDigestMismatch),
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite.
+ */
+int TestOTAImageProcessorImpl_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+
+    static chip::DeviceLayer::TestOnlyCommissionableDataProvider commissionable_data_provider;
+    chip::DeviceLayer::SetCommissionableDataProvider(&commissionable_data_provider);
+
+    if (PlatformMgr().InitChipStack() != CHIP_NO_ERROR || PlatformMgr().StartEventLoopTask() != CHIP_NO_ERROR)
+        return FAILURE;
+
+    // Finalize waits for the writer thread in background work.
+    if (PlatformMgr().StartBackgroundEventLoopTask() != CHIP_NO_ERROR)
+        return FAILURE;
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestOTAImageProcessorImpl_Teardown(void * inContext)
+{
+    PlatformMgr().StopEventLoopTask();
+    PlatformMgr().Shutdown();
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestOTAImageProcessorImpl()
+{
+    nlTestSuite theSuite = { "OTAImageProcessorImpl tests", &sTests[0], TestOTAImageProcessorImpl_Setup,
+                             TestOTAImageProcessorImpl_Teardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestOTAImageProcessorImpl);
@@ -29,6 +29,9 @@
 #include <string.h>
 
 #include <atomic>
+#if CHIP_DEVICE_LAYER_TARGET_LINUX
+#include <thread>
+#endif
 
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
@@ -189,6 +192,173 @@ static void TestPlatformMgr_RunEventLoopStopBeforeSleep(nlTestSuite * inSuite, v
     PlatformMgr().Shutdown();
 }
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+static std::atomic<int> sBackgroundWorkRun;
+static std::atomic<int> sBackgroundWorkBlocked;
+static std::atomic<bool> sBackgroundWorkRelease;
+
+static void CountBackgroundWork(intptr_t)
+{
+    sBackgroundWorkRun++;
+}
+
+// Keeps a background task busy until released, then posts more background work.
+static void BlockBackgroundTask(intptr_t)
+{
+    sBackgroundWorkBlocked++;
+    for (size_t t = 0; !sBackgroundWorkRelease && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+    PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork);
+}
+
+static void WaitForBackgroundWork(std::atomic<int> & counter, int expected)
+{
+    // Busy loop with a timeout, as in TestPlatformMgr_BasicEventLoopTask.
+    for (size_t t = 0; counter != expected && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+}
+
+// Runs the foreground event loop until the work posted to it so far has been dispatched.
+static void RunForegroundWork()
+{
+    stopRan = false;
+    PlatformMgr().ScheduleWork(StopTheLoop);
+    PlatformMgr().RunEventLoop();
+}
+
+static void TestPlatformMgr_BackgroundEventLoopTask(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kWorkCount = 16;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Start/stop the background tasks a few times. The foreground event loop does not run, so the work can only be
+    // dispatched by the background tasks.
+    for (size_t i = 0; i < 3; i++)
+    {
+        err = PlatformMgr().StartBackgroundEventLoopTask();
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, PlatformMgr().StartBackgroundEventLoopTask() == CHIP_ERROR_INCORRECT_STATE);
+
+        sBackgroundWorkRun = 0;
+        for (int w = 0; w < kWorkCount; w++)
+        {
+            NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork) == CHIP_NO_ERROR);
+        }
+        WaitForBackgroundWork(sBackgroundWorkRun, kWorkCount);
+        NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == kWorkCount);
+
+        err = PlatformMgr().StopBackgroundEventLoopTask();
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    // Once the background tasks are stopped, background work is dispatched by the foreground event loop.
+    sBackgroundWorkRun = 0;
+    NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork) == CHIP_NO_ERROR);
+    chip::test_utils::SleepMillis(10);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == 0);
+    RunForegroundWork();
+    NL_TEST_ASSERT(inSuite, stopRan);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == 1);
+
+    // Shutting down the stack stops background tasks that are still running, so they can be started again.
+    NL_TEST_ASSERT(inSuite, PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR);
+    PlatformMgr().Shutdown();
+
+    err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().StopBackgroundEventLoopTask() == CHIP_NO_ERROR);
+
+    PlatformMgr().Shutdown();
+}
+
+static void TestPlatformMgr_BackgroundWorkDuringStop(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kQueuedWorkCount = 4;
+
+    sBackgroundWorkRun     = 0;
+    sBackgroundWorkBlocked = 0;
+    sBackgroundWorkRelease = false;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = PlatformMgr().StartBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Keep every background task busy, so that further work stays queued.
+    for (int w = 0; w < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; w++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(BlockBackgroundTask) == CHIP_NO_ERROR);
+    }
+    WaitForBackgroundWork(sBackgroundWorkBlocked, CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkBlocked == CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+
+    for (int w = 0; w < kQueuedWorkCount; w++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork) == CHIP_NO_ERROR);
+    }
+
+    // Release the busy tasks while StopBackgroundEventLoopTask() waits for them: the work they post then, and the
+    // work still queued, is handed to the running foreground event loop rather than dropped.
+    err = PlatformMgr().StartEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    std::thread stopper([&]() { err = PlatformMgr().StopBackgroundEventLoopTask(); });
+    chip::test_utils::SleepMillis(10);
+    sBackgroundWorkRelease = true;
+    stopper.join();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    WaitForBackgroundWork(sBackgroundWorkRun, kQueuedWorkCount + CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == kQueuedWorkCount + CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+
+    err = PlatformMgr().StopEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    PlatformMgr().Shutdown();
+}
+
+static void TestPlatformMgr_BackgroundWorkDuringShutdown(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kQueuedWorkCount = 4;
+
+    sBackgroundWorkRun     = 0;
+    sBackgroundWorkBlocked = 0;
+    sBackgroundWorkRelease = false;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = PlatformMgr().StartBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (int w = 0; w < CHIP_DEVICE_CONFIG_BG_TASK_COUNT; w++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(BlockBackgroundTask) == CHIP_NO_ERROR);
+    }
+    WaitForBackgroundWork(sBackgroundWorkBlocked, CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkBlocked == CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+
+    for (int w = 0; w < kQueuedWorkCount; w++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(CountBackgroundWork) == CHIP_NO_ERROR);
+    }
+
+    // The work left when the stack is shut down is dropped, rather than run by the event loop of the next stack.
+    std::thread stopper([&]() { PlatformMgr().Shutdown(); });
+    chip::test_utils::SleepMillis(10);
+    sBackgroundWorkRelease = true;
+    stopper.join();
+
+    err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    RunForegroundWork();
+    NL_TEST_ASSERT(inSuite, stopRan);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == 0);
+
+    PlatformMgr().Shutdown();
+}
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 static void TestPlatformMgr_TryLockChipStack(nlTestSuite * inSuite, void * inContext)
 {
     bool locked = PlatformMgr().TryLockChipStack();
@@ -263,6 +433,11 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test basic PlatformMgr::RunEventLoop", TestPlatformMgr_BasicRunEventLoop),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with two tasks", TestPlatformMgr_RunEventLoopTwoTasks),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with stop before sleep", TestPlatformMgr_RunEventLoopStopBeforeSleep),
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    NL_TEST_DEF("Test PlatformMgr::StartBackgroundEventLoopTask", TestPlatformMgr_BackgroundEventLoopTask),
+    NL_TEST_DEF("Test background work posted while stopping", TestPlatformMgr_BackgroundWorkDuringStop),
+    NL_TEST_DEF("Test background work left at shutdown", TestPlatformMgr_BackgroundWorkDuringShutdown),
+#endif
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
     NL_TEST_DEF("Test mock System::Layer", TestPlatformMgr_MockSystemLayer),
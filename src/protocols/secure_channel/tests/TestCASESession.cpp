@@ -378,6 +378,7 @@ public:
     static void SimulateUpdateNOCInvalidatePendingEstablishment(nlTestSuite * inSuite, void * inContext);
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * inContext);
+    static void HandshakeWorkerBenchmark(nlTestSuite * inSuite, void * inContext);
 };
 
 void TestCASESession::SecurePairingWaitTest(nlTestSuite * inSuite, void * inContext)
@@ -1208,6 +1209,127 @@ void TestCASESession::Sigma1BadDestinationIdTest(nlTestSuite * inSuite, void * i
     caseSession.Clear();
 }
 
+namespace {
+
+// Hands each incoming Sigma1 to the next responder session, so that several handshakes can be in progress at once.
+class ResponderDispatcher : public Messaging::UnsolicitedMessageHandler
+{
+public:
+    ResponderDispatcher(CASESession * responders, size_t count) : mResponders(responders), mCount(count) {}
+
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        VerifyOrReturnError(mNext < mCount, CHIP_ERROR_NO_MEMORY);
+        return mResponders[mNext++].OnUnsolicitedMessageReceived(payloadHeader, newDelegate);
+    }
+
+private:
+    CASESession * mResponders;
+    size_t mCount;
+    size_t mNext = 0;
+};
+
+// As many handshakes as the unauthenticated session pool can carry at once: each one takes a session on both sides.
+constexpr size_t kConcurrentHandshakes = CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE / 2;
+
+// Runs kConcurrentHandshakes CASE handshakes side by side and returns how many of them completed on both sides.
+uint32_t RunConcurrentHandshakes(nlTestSuite * inSuite, TestContext & ctx)
+{
+    TemporarySessionManager sessionManager(inSuite, ctx);
+
+    TestCASESecurePairingDelegate initiatorDelegates[kConcurrentHandshakes];
+    TestCASESecurePairingDelegate responderDelegates[kConcurrentHandshakes];
+    CASESession initiators[kConcurrentHandshakes];
+    CASESession responders[kConcurrentHandshakes];
+    ResponderDispatcher dispatcher(responders, kConcurrentHandshakes);
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                                     &dispatcher) == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kConcurrentHandshakes; i++)
+    {
+        responders[i].SetGroupDataProvider(&gDeviceGroupDataProvider);
+        NL_TEST_ASSERT(inSuite,
+                       responders[i].PrepareForSessionEstablishment(sessionManager, &gDeviceFabrics, nullptr, nullptr,
+                                                                    &responderDelegates[i], ScopedNodeId(),
+                                                                    NullOptional) == CHIP_NO_ERROR);
+
+        initiators[i].SetGroupDataProvider(&gCommissionerGroupDataProvider);
+        ExchangeContext * exchange = ctx.NewUnauthenticatedExchangeToBob(&initiators[i]);
+        NL_TEST_ASSERT(inSuite,
+                       initiators[i].EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                      ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, exchange, nullptr,
+                                                      nullptr, &initiatorDelegates[i], NullOptional) == CHIP_NO_ERROR);
+    }
+
+    // Work done by background workers completes asynchronously, so keep servicing until every handshake has ended.
+    auto allEnded = [&]() {
+        for (size_t i = 0; i < kConcurrentHandshakes; i++)
+        {
+            if (initiatorDelegates[i].mNumPairingComplete + initiatorDelegates[i].mNumPairingErrors == 0 ||
+                responderDelegates[i].mNumPairingComplete + responderDelegates[i].mNumPairingErrors == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (int pass = 0; pass < 1000 && !allEnded(); pass++)
+    {
+        ServiceEvents(ctx);
+    }
+
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+
+    uint32_t completed = 0;
+    for (size_t i = 0; i < kConcurrentHandshakes; i++)
+    {
+        if (initiatorDelegates[i].mNumPairingComplete == 1 && responderDelegates[i].mNumPairingComplete == 1)
+        {
+            completed++;
+        }
+    }
+    return completed;
+}
+
+// backgroundTasks is only reported: 0 stands for background work run on the Matter thread.
+void RunHandshakeBenchmark(nlTestSuite * inSuite, TestContext & ctx, unsigned backgroundTasks)
+{
+    constexpr uint32_t kRounds     = 8;
+    constexpr uint32_t kHandshakes = kRounds * kConcurrentHandshakes;
+
+    uint32_t completed     = 0;
+    const uint64_t startUs = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        completed += RunConcurrentHandshakes(inSuite, ctx);
+    }
+    const uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - startUs;
+
+    NL_TEST_ASSERT(inSuite, completed == kHandshakes);
+    ChipLogProgress(Test, "CASE handshakes, %u background tasks: %u handshakes in %u us (%u handshakes/s)", backgroundTasks,
+                    static_cast<unsigned>(completed), static_cast<unsigned>(elapsedUs),
+                    static_cast<unsigned>(elapsedUs ? (uint64_t{ completed } * 1000000) / elapsedUs : 0));
+}
+
+} // anonymous namespace
+
+void TestCASESession::HandshakeWorkerBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    // Measures how many handshakes per second complete when their background work (Sigma2 validation, Sigma3
+    // signing and validation) runs on the Matter thread, and when it runs on the background event loop tasks.
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    RunHandshakeBenchmark(inSuite, ctx, 0);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    NL_TEST_ASSERT(inSuite, chip::DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR);
+    RunHandshakeBenchmark(inSuite, ctx, CHIP_DEVICE_CONFIG_BG_TASK_COUNT);
+    NL_TEST_ASSERT(inSuite, chip::DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask() == CHIP_NO_ERROR);
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+}
+
 } // namespace chip
 
 // Test Suite
@@ -1232,6 +1354,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("InvalidatePendingSessionEstablishment", chip::TestCASESession::SimulateUpdateNOCInvalidatePendingEstablishment),
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("Sigma1BadDestinationId", chip::TestCASESession::Sigma1BadDestinationIdTest),
+    NL_TEST_DEF("HandshakeWorkerBenchmark", chip::TestCASESession::HandshakeWorkerBenchmark),
 
     NL_TEST_SENTINEL()
 };
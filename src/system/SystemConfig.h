@@ -256,6 +256,17 @@
 #define CHIP_SYSTEM_CONFIG_POOL_USE_HEAP 0
 #endif /* CHIP_SYSTEM_CONFIG_POOL_USE_HEAP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_POOL_USE_SLAB
+ *
+ *  @brief
+ *      When CHIP_SYSTEM_CONFIG_POOL_USE_HEAP is enabled, make heap pools allocate their objects in slabs of
+ *      contiguous objects (ObjectPoolMem::kSlab) rather than one heap block per object (ObjectPoolMem::kHeap).
+ */
+#ifndef CHIP_SYSTEM_CONFIG_POOL_USE_SLAB
+#define CHIP_SYSTEM_CONFIG_POOL_USE_SLAB 0
+#endif /* CHIP_SYSTEM_CONFIG_POOL_USE_SLAB */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_NO_LOCKING
  *
@@ -358,6 +369,20 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+ *
+ *  @brief
+ *      When packet buffers are allocated using malloc (CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is 0), this is the
+ *      number of released buffers kept for reuse in each allocation size class, instead of being returned to the heap.
+ *
+ *      Allocations are rounded up to a size class only when this is nonzero. Buffers are taken from and returned to
+ *      the cache without locking, so it is suitable for hosts where several threads allocate packet buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -0,0 +1,488 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using Linux epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mEventCount = 0;
+    mTimerFdAwakenTime.ClearValue();
+
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrReturnError(mTimerFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    // The timerfd is the only descriptor not backed by a SocketWatch; it is identified by its own address.
+    epoll_event event = {};
+    event.events      = EPOLLIN;
+    event.data.ptr    = &mTimerFd;
+    VerifyOrReturnError(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    mSocketWatchPool.ReleaseAll();
+    mEventCount = 0;
+
+    if (mTimerFd >= 0)
+    {
+        VerifyOrDie(::close(mTimerFd) == 0);
+        mTimerFd = kInvalidFd;
+    }
+    if (mEpollFd >= 0)
+    {
+        VerifyOrDie(::close(mEpollFd) == 0);
+        mEpollFd = kInvalidFd;
+    }
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by notifying the wake event.
+     *
+     * If this is being called from within an I/O event callback, then notifying can be skipped,
+     * since the I/O thread is already awake.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleSelectThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+Clock::Timeout LayerImplEpoll::GetRemainingTime(TimerCompleteCallback onComplete, void * appState)
+{
+    return mTimerList.GetRemainingTime(onComplete, appState);
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Schedule as a timer with no delay, but do NOT cancel previous timers with the same onComplete/appState.
+    // See LayerImplSelect::ScheduleWork for why this is not a ScheduleLambda.
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    bool duplicate = false;
+    mSocketWatchPool.ForEachActiveObject([&](SocketWatch * w) {
+        duplicate = (w->mFD == fd);
+        return duplicate ? Loop::Break : Loop::Continue;
+    });
+    // Duplicate registration is an error.
+    VerifyOrReturnError(!duplicate, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The descriptor is only added to the epoll interest list once a callback is requested.
+    SocketWatch * watch = mSocketWatchPool.CreateObject(fd);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch->mRegisteredEvents != 0)
+    {
+        // Failure here means the descriptor was already closed, which also removes it from the interest list.
+        (void) epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr);
+    }
+
+    // Events for this socket may already have been retrieved by WaitForEvents() but not yet dispatched;
+    // make sure HandleEvents() does not dispatch them to a released watch.
+    for (int i = 0; i < mEventCount; i++)
+    {
+        if (mEvents[i].data.ptr == watch)
+        {
+            mEvents[i].data.ptr = nullptr;
+        }
+    }
+
+    mSocketWatchPool.ReleaseObject(watch);
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Bring the epoll interest list entry for a socket in line with the callbacks requested for it.
+ *
+ *  Sockets with no pending requests are removed from the interest list altogether, since error and hang-up
+ *  conditions are always reported by epoll and would otherwise keep waking up the event loop.
+ */
+CHIP_ERROR LayerImplEpoll::UpdateInterest(SocketWatch & watch)
+{
+    uint32_t events = (watch.mPendingIO.Has(SocketEventFlags::kRead) ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+        (watch.mPendingIO.Has(SocketEventFlags::kWrite) ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    VerifyOrReturnError(events != watch.mRegisteredEvents, CHIP_NO_ERROR);
+
+    int op;
+    if (watch.mRegisteredEvents == 0)
+    {
+        op = EPOLL_CTL_ADD;
+    }
+    else if (events == 0)
+    {
+        op = EPOLL_CTL_DEL;
+    }
+    else
+    {
+        op = EPOLL_CTL_MOD;
+    }
+
+    epoll_event event = {};
+    event.events      = events;
+    event.data.ptr    = &watch;
+    VerifyOrReturnError(epoll_ctl(mEpollFd, op, watch.mFD, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    watch.mRegisteredEvents = events;
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::ArmTimerFd(Clock::Timestamp currentTime)
+{
+    TimerList::Node * timer = mTimerList.Earliest();
+
+    if (timer == nullptr)
+    {
+        VerifyOrReturn(mTimerFdAwakenTime.HasValue());
+        mTimerFdAwakenTime.ClearValue();
+    }
+    else
+    {
+        VerifyOrReturn(!mTimerFdAwakenTime.HasValue() || mTimerFdAwakenTime.Value() != timer->AwakenTime());
+        mTimerFdAwakenTime.SetValue(timer->AwakenTime());
+    }
+
+    itimerspec spec = {};
+    if (mTimerFdAwakenTime.HasValue())
+    {
+        const Clock::Microseconds64 sleepTime = (timer->AwakenTime() > currentTime) ? (timer->AwakenTime() - currentTime)
+                                                                                    : Clock::Microseconds64(0);
+        spec.it_value.tv_sec  = static_cast<time_t>(sleepTime.count() / kMicrosecondsPerSecond);
+        spec.it_value.tv_nsec = static_cast<long>((sleepTime.count() % kMicrosecondsPerSecond) * kNanosecondsPerMicrosecond);
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+        {
+            // An all-zero it_value disarms the timer; expire as soon as possible instead.
+            spec.it_value.tv_nsec = 1;
+        }
+    }
+
+    if (timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        mTimerFdAwakenTime.ClearValue();
+    }
+}
+
+void LayerImplEpoll::ConfirmTimerFd()
+{
+    uint64_t expirations;
+    // Reading resets the expiration count so the timerfd stops being readable. EAGAIN just means it was re-armed since.
+    (void) ::read(mTimerFd, &expirations, sizeof(expirations));
+
+    // The timerfd is now disarmed; make sure PrepareEvents() arms it again for the next timer.
+    mTimerFdAwakenTime.ClearValue();
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    // Unlike select(), socket interest is already registered, so only the timerfd may need updating.
+    ArmTimerFd(SystemClock().GetMonotonicTimestamp());
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    // Timeouts are delivered through the timerfd, so wait indefinitely.
+    mEventCount = epoll_wait(mEpollFd, mEvents, kMaxEventsPerWait, -1);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        mEventCount = 0;
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(timer);
+    }
+
+    // Note that callbacks may stop watching sockets whose events are further along in mEvents;
+    // StopWatchingSocket() clears those entries.
+    for (int i = 0; i < mEventCount; i++)
+    {
+        void * ptr = mEvents[i].data.ptr;
+        if (ptr == &mTimerFd)
+        {
+            ConfirmTimerFd();
+            continue;
+        }
+
+        SocketWatch * watch = static_cast<SocketWatch *>(ptr);
+        if (watch == nullptr || watch->mCallback == nullptr)
+        {
+            continue;
+        }
+
+        // Errors and hang-ups are reported to whichever direction is being waited on, as select() would.
+        const uint32_t ready = mEvents[i].events;
+        const bool failed    = (ready & (EPOLLERR | EPOLLHUP)) != 0;
+        SocketEvents events;
+        if (watch->mPendingIO.Has(SocketEventFlags::kRead) && (failed || (ready & EPOLLIN) != 0))
+        {
+            events.Set(SocketEventFlags::kRead);
+        }
+        if (watch->mPendingIO.Has(SocketEventFlags::kWrite) && (failed || (ready & EPOLLOUT) != 0))
+        {
+            events.Set(SocketEventFlags::kWrite);
+        }
+        if (events.HasAny())
+        {
+            watch->mCallback(events, watch->mCallbackData);
+        }
+    }
+    mEventCount = 0;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+} // namespace System
+} // namespace chip
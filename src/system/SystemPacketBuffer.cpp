@@ -58,6 +58,10 @@
 #include <lib/support/CHIPMem.h>
 #endif
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+#include <atomic>
+#endif
+
 namespace chip {
 namespace System {
 
@@ -122,6 +126,109 @@ void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 }
 #endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+//
+// Recycling of heap allocated PacketBuffer objects.
+//
+// Allocation sizes are rounded up to one of a few size classes, and each class keeps up to
+// CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE released blocks in an array of atomic slots. A release claims an empty
+// slot with a compare-and-swap and an allocation empties a full one with an exchange. Neither needs a lock, and since a
+// slot only ever holds a block that nobody else owns, there is no ABA hazard as there would be with a linked free list.
+//
+
+namespace {
+
+// Data sizes (reserve included) of the size classes, in increasing order. The largest class must be exactly the largest
+// size New() accepts, so that a maximum-size request still gets a block of exactly PacketBuffer::kBlockSize bytes.
+constexpr uint16_t kHeapCacheClassSizes[] = { 128, 256, 512, PacketBuffer::kMaxSizeWithoutReserve };
+constexpr size_t kHeapCacheClassCount     = ArraySize(kHeapCacheClassSizes);
+
+static_assert(PacketBuffer::kMaxSizeWithoutReserve > 512, "PacketBuffer heap cache size classes are not increasing");
+
+std::atomic<PacketBuffer *> sHeapCache[kHeapCacheClassCount][CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE];
+
+// Index of the smallest size class that holds aAllocSize bytes. Every size New() accepts fits in the largest class.
+size_t HeapCacheSizeClass(size_t aAllocSize)
+{
+    size_t sizeClass = 0;
+    while (kHeapCacheClassSizes[sizeClass] < aAllocSize)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+uint16_t HeapCacheRoundUp(size_t aAllocSize)
+{
+    return kHeapCacheClassSizes[HeapCacheSizeClass(aAllocSize)];
+}
+
+} // namespace
+
+PacketBuffer * PacketBuffer::HeapCacheAllocate(uint16_t aAllocSize)
+{
+    for (auto & slot : sHeapCache[HeapCacheSizeClass(aAllocSize)])
+    {
+        // Only attempt the exchange on slots that look full, to avoid taking cache lines exclusive for nothing.
+        if (slot.load(std::memory_order_relaxed) != nullptr)
+        {
+            PacketBuffer * lPacket = slot.exchange(nullptr, std::memory_order_acquire);
+            if (lPacket != nullptr)
+            {
+                SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(Stats::kPacketBufferCache_Hits);
+                return lPacket;
+            }
+        }
+    }
+
+    SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(Stats::kPacketBufferCache_Misses);
+    return reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(kStructureSize + aAllocSize));
+}
+
+void PacketBuffer::HeapCacheRelease(PacketBuffer * aPacket, uint16_t aAllocSize)
+{
+    // Blocks that are not exactly a class size (e.g. adopted from elsewhere) are never cached.
+    for (size_t sizeClass = 0; sizeClass < kHeapCacheClassCount; sizeClass++)
+    {
+        if (kHeapCacheClassSizes[sizeClass] != aAllocSize)
+        {
+            continue;
+        }
+
+        for (auto & slot : sHeapCache[sizeClass])
+        {
+            PacketBuffer * lEmpty = nullptr;
+            if (slot.load(std::memory_order_relaxed) == nullptr &&
+                slot.compare_exchange_strong(lEmpty, aPacket, std::memory_order_release, std::memory_order_relaxed))
+            {
+                SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(Stats::kPacketBufferCache_Recycled);
+                return;
+            }
+        }
+
+        SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(Stats::kPacketBufferCache_Overflows);
+        break;
+    }
+
+    chip::Platform::MemoryFree(aPacket);
+}
+
+void PacketBuffer::ReleaseHeapCache()
+{
+    for (auto & sizeClass : sHeapCache)
+    {
+        for (auto & slot : sizeClass)
+        {
+            PacketBuffer * lPacket = slot.exchange(nullptr, std::memory_order_acquire);
+            if (lPacket != nullptr)
+            {
+                chip::Platform::MemoryFree(lPacket);
+            }
+        }
+    }
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
 // Number of unused bytes below which \c RightSize() won't bother reallocating.
 constexpr uint16_t kRightSizingThreshold = 16;
 
@@ -137,13 +244,23 @@ void PacketBufferHandle::InternalRightSize()
     const uint8_t * const start   = mBuffer->ReserveStart();
     const uint8_t * const payload = mBuffer->Start();
     const uint16_t usedSize       = static_cast<uint16_t>(payload - start + mBuffer->len);
-    if (usedSize + kRightSizingThreshold > mBuffer->alloc_size)
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    // The buffer can only shrink to the size class that holds usedSize.
+    const uint16_t allocSize = HeapCacheRoundUp(usedSize);
+#else
+    const uint16_t allocSize = usedSize;
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    if (allocSize + kRightSizingThreshold > mBuffer->alloc_size)
     {
         return;
     }
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    PacketBuffer * newBuffer = PacketBuffer::HeapCacheAllocate(allocSize);
+#else
+    const size_t blockSize   = allocSize + PacketBuffer::kStructureSize;
     PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -156,7 +273,7 @@ void PacketBufferHandle::InternalRightSize()
     newBuffer->tot_len       = mBuffer->tot_len;
     newBuffer->len           = mBuffer->len;
     newBuffer->ref           = 1;
-    newBuffer->alloc_size    = static_cast<uint16_t>(usedSize);
+    newBuffer->alloc_size    = allocSize;
     memcpy(newStart, start, usedSize);
 
     PacketBuffer::Free(mBuffer);
@@ -523,7 +640,14 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
-    lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    // Hand out the whole size class, so that the block can later be reused for any request in that class.
+    const uint16_t lHeapAllocSize = HeapCacheRoundUp(lAllocSize);
+    lPacket                       = PacketBuffer::HeapCacheAllocate(lHeapAllocSize);
+#else
+    const size_t lHeapAllocSize = lAllocSize;
+    lPacket                     = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -541,7 +665,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     lPacket->next                   = nullptr;
     lPacket->ref                    = 1;
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-    lPacket->alloc_size = static_cast<uint16_t>(lAllocSize);
+    lPacket->alloc_size = static_cast<uint16_t>(lHeapAllocSize);
 #endif
 
     return PacketBufferHandle(lPacket);
@@ -602,11 +726,17 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+            // Clear() resets alloc_size, which selects the size class.
+            const uint16_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
+#elif CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+            HeapCacheRelease(aPacket, lAllocSize);
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
 #endif
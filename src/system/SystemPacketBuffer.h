@@ -353,6 +353,16 @@ public:
 #endif
     }
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    /**
+     * Return every packet buffer held in the heap cache to the heap.
+     *
+     * Buffers released later are cached again as usual; this only drops what is currently held, e.g. under memory
+     * pressure or before Platform::MemoryShutdown().
+     */
+    static void ReleaseHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
 private:
     // Memory required for a maximum-size PacketBuffer.
     static constexpr uint16_t kBlockSize = PacketBuffer::kStructureSize + PacketBuffer::kMaxSizeWithoutReserve;
@@ -369,6 +379,13 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    // Take a block for aAllocSize, which must be a size class, from the cache, or from the heap if the class is empty.
+    static PacketBuffer * HeapCacheAllocate(uint16_t aAllocSize);
+    // Keep a released block for reuse if it has a size class and the class has room, otherwise free it.
+    static void HeapCacheRelease(PacketBuffer * aPacket, uint16_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -53,6 +53,17 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+ *
+ * True if released heap packet buffers are kept in size-classed caches for reuse.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0)
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_LWIP_POOL
  *
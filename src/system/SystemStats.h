@@ -39,6 +39,7 @@
 #include <lwip/stats.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#include <atomic>
 #include <stdint.h>
 
 namespace chip {
@@ -92,6 +93,23 @@ void UpdateLwipPbufCounts(void);
 typedef const char * Label;
 const Label * GetStrings();
 
+/**
+ * Event counters for the packet buffer heap cache (see CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE).
+ *
+ * These are kept apart from the resource counts above: they only ever grow, and are updated from whichever thread
+ * allocates or frees a packet buffer.
+ */
+enum PacketBufferCacheCounter
+{
+    kPacketBufferCache_Hits,      ///< Allocations served from the cache
+    kPacketBufferCache_Misses,    ///< Allocations that had to go to the heap
+    kPacketBufferCache_Recycled,  ///< Released buffers kept in the cache
+    kPacketBufferCache_Overflows, ///< Released buffers returned to the heap because their size class was full
+    kPacketBufferCache_NumCounters
+};
+
+std::atomic<uint32_t> * GetPacketBufferCacheCounts();
+
 } // namespace Stats
 } // namespace System
 } // namespace chip
@@ -146,6 +164,12 @@ const Label * GetStrings();
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 
+#define SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(counter)                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        chip::System::Stats::GetPacketBufferCacheCounts()[counter].fetch_add(1, std::memory_order_relaxed);                        \
+    } while (0)
+
 // Additional macros for testing.
 #define SYSTEM_STATS_TEST_IN_USE(entry, expected) (chip::System::Stats::GetResourcesInUse()[entry] == (expected))
 #define SYSTEM_STATS_TEST_HIGH_WATER_MARK(entry, expected) (chip::System::Stats::GetHighWatermarks()[entry] == (expected))
@@ -167,6 +191,8 @@ const Label * GetStrings();
 
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 
+#define SYSTEM_STATS_COUNT_PACKETBUFFER_CACHE(counter)
+
 #define SYSTEM_STATS_TEST_IN_USE(entry, expected) (true)
 #define SYSTEM_STATS_TEST_HIGH_WATER_MARK(entry, expected) (true)
 #define SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(entry)
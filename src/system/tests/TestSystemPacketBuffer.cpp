@@ -23,10 +23,12 @@
  *      structure for network packet buffer management.
  */
 
+#include <atomic>
 #include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -36,6 +38,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -130,6 +133,7 @@ public:
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
+    static void CheckHeapCache(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
     {
@@ -229,6 +233,9 @@ int PacketBufferTest::TestTeardown(void * inContext)
 {
     chip::DeviceLayer::PlatformMgr().Shutdown();
 
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+    PacketBuffer::ReleaseHeapCache();
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
     chip::Platform::MemoryShutdown();
 
     return SUCCESS;
@@ -1962,6 +1969,113 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+void PacketBufferTest::CheckHeapCache(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+#if CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+
+    using namespace chip::System::Stats;
+
+    PacketBuffer::ReleaseHeapCache();
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    uint32_t counts[kPacketBufferCache_NumCounters];
+    for (size_t i = 0; i < kPacketBufferCache_NumCounters; i++)
+    {
+        counts[i] = GetPacketBufferCacheCounts()[i].load();
+    }
+    auto countDelta = [&counts](PacketBufferCacheCounter counter) {
+        return GetPacketBufferCacheCounts()[counter].load() - counts[counter];
+    };
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    // Allocations are rounded up to a size class, and a released buffer is reused for another request in its class.
+    PacketBufferHandle handle = PacketBufferHandle::New(100, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    NL_TEST_ASSERT(inSuite, handle->AllocSize() == 128);
+    const PacketBuffer * const released = handle.mBuffer;
+    handle                              = nullptr;
+
+    handle = PacketBufferHandle::New(64, 10);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == released);
+    NL_TEST_ASSERT(inSuite, handle->AllocSize() == 128);
+    NL_TEST_ASSERT(inSuite, handle->DataLength() == 0);
+    NL_TEST_ASSERT(inSuite, handle->ReservedSize() == 10);
+    handle = nullptr;
+
+    // A maximum-size request still gets exactly the largest block, and is not served from a smaller class.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    NL_TEST_ASSERT(inSuite, handle.mBuffer != released);
+    NL_TEST_ASSERT(inSuite, handle->AllocSize() == PacketBuffer::kMaxSizeWithoutReserve);
+    handle = nullptr;
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    NL_TEST_ASSERT(inSuite, countDelta(kPacketBufferCache_Hits) == 1);
+    NL_TEST_ASSERT(inSuite, countDelta(kPacketBufferCache_Misses) == 2);
+    NL_TEST_ASSERT(inSuite, countDelta(kPacketBufferCache_Recycled) == 3);
+    NL_TEST_ASSERT(inSuite, countDelta(kPacketBufferCache_Overflows) == 0);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    // Releasing more buffers of one class than the cache holds returns the excess to the heap.
+    {
+        std::vector<PacketBufferHandle> held;
+        for (int i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE + 2; i++)
+        {
+            held.push_back(PacketBufferHandle::New(200, 0));
+            NL_TEST_ASSERT(inSuite, !held.back().IsNull());
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    NL_TEST_ASSERT(inSuite, countDelta(kPacketBufferCache_Overflows) == 2);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    // Threads taking and returning blocks concurrently must never be handed the same block.
+    constexpr int kThreadCount = 4;
+    constexpr int kIterations  = 20000;
+    std::atomic<bool> corrupted{ false };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; t++)
+    {
+        threads.emplace_back([t, &corrupted]() {
+            for (int i = 0; i < kIterations; i++)
+            {
+                const uint16_t allocSize = (i % 2) ? 256 : 512;
+                PacketBuffer * packet    = PacketBuffer::HeapCacheAllocate(allocSize);
+                if (packet == nullptr)
+                {
+                    continue;
+                }
+                uint8_t * const data = reinterpret_cast<uint8_t *>(packet) + PacketBuffer::kStructureSize;
+                memset(data, t, allocSize);
+                std::this_thread::yield();
+                for (uint16_t j = 0; j < allocSize; j++)
+                {
+                    if (data[j] != t)
+                    {
+                        corrupted = true;
+                        break;
+                    }
+                }
+                PacketBuffer::HeapCacheRelease(packet, allocSize);
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    NL_TEST_ASSERT(inSuite, !corrupted);
+
+    PacketBuffer::ReleaseHeapCache();
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HEAP_CACHE
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -2002,6 +2116,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::HeapCache",              PacketBufferTest::CheckHeapCache),
 
     NL_TEST_SENTINEL()
 };
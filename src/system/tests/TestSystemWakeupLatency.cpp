@@ -0,0 +1,191 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a microbenchmark measuring how long the event loop of <tt>chip::System::LayerImpl</tt>
+ *      takes to dispatch a read callback for one active socket while many idle sockets are watched.
+ *
+ *      Build with different values of chip_system_config_event_loop to compare implementations.
+ */
+
+#include <system/SystemConfig.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+#include <algorithm>
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace chip::System;
+
+namespace {
+
+constexpr size_t kMaxIdleSockets = 256;
+constexpr size_t kIterations     = 1000;
+
+struct SocketPair
+{
+    int mFds[2]                  = { -1, -1 };
+    SocketWatchToken mWatchToken = 0;
+    bool mWatching               = false;
+};
+
+struct TestContext
+{
+    ::chip::System::LayerImpl mSystemLayer;
+    SocketPair mIdle[kMaxIdleSockets];
+    size_t mIdleCount = 0;
+    SocketPair mActive;
+    size_t mCallbackCount    = 0;
+    uint64_t mCallbackTimeUs = 0;
+
+    TestContext() { mSystemLayer.Init(); }
+    ~TestContext()
+    {
+        for (size_t i = 0; i < mIdleCount; ++i)
+        {
+            Close(mIdle[i]);
+        }
+        Close(mActive);
+        mSystemLayer.Shutdown();
+    }
+
+    CHIP_ERROR Open(SocketPair & pair)
+    {
+        VerifyOrReturnError(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair.mFds) == 0, CHIP_ERROR_POSIX(errno));
+        ReturnErrorOnFailure(mSystemLayer.StartWatchingSocket(pair.mFds[0], &pair.mWatchToken));
+        pair.mWatching = true;
+        ReturnErrorOnFailure(mSystemLayer.SetCallback(pair.mWatchToken, HandleSocketEvent, reinterpret_cast<intptr_t>(this)));
+        return mSystemLayer.RequestCallbackOnPendingRead(pair.mWatchToken);
+    }
+
+    void Close(SocketPair & pair)
+    {
+        if (pair.mWatching)
+        {
+            mSystemLayer.StopWatchingSocket(&pair.mWatchToken);
+            pair.mWatching = false;
+        }
+        for (int & fd : pair.mFds)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    static void HandleSocketEvent(SocketEvents events, intptr_t data)
+    {
+        TestContext & context = *reinterpret_cast<TestContext *>(data);
+        uint8_t byte;
+
+        context.mCallbackTimeUs = SystemClock().GetMonotonicMicroseconds64().count();
+        context.mCallbackCount++;
+        VerifyOrDie(events.Has(SocketEventFlags::kRead));
+        VerifyOrDie(read(context.mActive.mFds[0], &byte, sizeof(byte)) == 1);
+    }
+};
+
+void BenchmarkWakeupLatency(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & context = *static_cast<TestContext *>(aContext);
+
+    // Watch as many idle sockets as the implementation accepts, keeping one slot for the active socket.
+    while (context.mIdleCount < kMaxIdleSockets)
+    {
+        SocketPair & pair = context.mIdle[context.mIdleCount];
+        CHIP_ERROR err    = context.Open(pair);
+        if (err != CHIP_NO_ERROR)
+        {
+            context.Close(pair);
+            break;
+        }
+        context.mIdleCount++;
+    }
+    if (context.mIdleCount > 0)
+    {
+        context.Close(context.mIdle[--context.mIdleCount]);
+    }
+    NL_TEST_ASSERT(inSuite, context.Open(context.mActive) == CHIP_NO_ERROR);
+
+    uint64_t totalUs   = 0;
+    uint64_t maxUs     = 0;
+    const uint8_t byte = 0;
+
+    for (size_t i = 0; i < kIterations; ++i)
+    {
+        const size_t expectedCount = context.mCallbackCount + 1;
+
+        NL_TEST_ASSERT(inSuite, write(context.mActive.mFds[1], &byte, sizeof(byte)) == 1);
+        const uint64_t startUs = SystemClock().GetMonotonicMicroseconds64().count();
+
+        context.mSystemLayer.PrepareEvents();
+        context.mSystemLayer.WaitForEvents();
+        context.mSystemLayer.HandleEvents();
+
+        NL_TEST_ASSERT(inSuite, context.mCallbackCount == expectedCount);
+        const uint64_t elapsedUs = context.mCallbackTimeUs - startUs;
+        totalUs += elapsedUs;
+        maxUs = std::max(maxUs, elapsedUs);
+    }
+
+    ChipLogProgress(Test, "Wakeup latency with %u idle sockets: average %u us, max %u us over %u iterations",
+                    static_cast<unsigned>(context.mIdleCount), static_cast<unsigned>(totalUs / kIterations),
+                    static_cast<unsigned>(maxUs), static_cast<unsigned>(kIterations));
+}
+
+} // namespace
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("WakeupLatency::BenchmarkWakeupLatency", BenchmarkWakeupLatency),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static nlTestSuite kTheSuite = { "chip-system-wakeup-latency", sTests };
+
+int TestSystemWakeupLatency()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&kTheSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemWakeupLatency)
+#else  // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+int TestSystemWakeupLatency(void)
+{
+    return SUCCESS;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
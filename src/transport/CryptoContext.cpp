@@ -27,6 +27,8 @@
 #include <lib/core/CHIPEncoding.h>
 #include <lib/support/BufferWriter.h>
 #include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <system/SystemPacketBuffer.h>
 #include <transport/CryptoContext.h>
 #include <transport/raw/MessageHeader.h>
 
@@ -55,6 +57,11 @@ CryptoContext::CryptoContext() : mKeyAvailable(false) {}
 
 CryptoContext::~CryptoContext()
 {
+#if CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    mPreparedEncryptionKey.Clear();
+    mPreparedDecryptionKey.Clear();
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+
     if (mKeystore)
     {
         mKeystore->DestroyKey(mEncryptionKey);
@@ -86,6 +93,7 @@ CHIP_ERROR CryptoContext::InitFromSecret(SessionKeystore & keystore, const ByteS
     mKeyAvailable = true;
     mSessionRole  = role;
     mKeystore     = &keystore;
+    PrepareKeys();
 
     return CHIP_NO_ERROR;
 }
@@ -111,6 +119,7 @@ CHIP_ERROR CryptoContext::InitFromSecret(Crypto::SessionKeystore & keystore, con
     mKeyAvailable = true;
     mSessionRole  = role;
     mKeystore     = &keystore;
+    PrepareKeys();
 
     return CHIP_NO_ERROR;
 }
@@ -150,6 +159,20 @@ CHIP_ERROR CryptoContext::InitTestMode(Crypto::SessionKeystore & keystore, Crypt
 }
 #endif // CHIP_CONFIG_SECURITY_TEST_MODE
 
+void CryptoContext::PrepareKeys()
+{
+#if CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    // Prepared keys only save the per-message key setup, so messages fall back to the key handles if preparing fails.
+    if (mPreparedEncryptionKey.Init(mEncryptionKey) != CHIP_NO_ERROR ||
+        mPreparedDecryptionKey.Init(mDecryptionKey) != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Failed to prepare session keys");
+        mPreparedEncryptionKey.Clear();
+        mPreparedDecryptionKey.Clear();
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+}
+
 CHIP_ERROR CryptoContext::BuildNonce(NonceView nonce, uint8_t securityFlags, uint32_t messageCounter, NodeId nodeId)
 {
     Encoding::LittleEndian::BufferWriter bbuf(nonce.data(), nonce.size());
@@ -191,6 +214,100 @@ CHIP_ERROR CryptoContext::GetAdditionalAuthData(const PacketHeader & header, uin
     return CHIP_NO_ERROR;
 }
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+CryptoContext::CopyStats CryptoContext::sCopyStats;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
+CHIP_ERROR CryptoContext::Seal(const uint8_t * input, size_t input_length, uint8_t * output, ByteSpan aad, ConstNonceView nonce,
+                               uint8_t * tag, size_t taglen) const
+{
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    if (input != output)
+    {
+        sCopyStats.cipherCopiedBytes += input_length;
+    }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
+    if (mKeyContext)
+    {
+        ByteSpan plaintext(input, input_length);
+        MutableByteSpan ciphertext(output, input_length);
+        MutableByteSpan mic(tag, taglen);
+
+        return mKeyContext->MessageEncrypt(plaintext, aad, nonce, mic, ciphertext);
+    }
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+#if CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    if (mPreparedEncryptionKey.IsInitialized())
+    {
+        return mPreparedEncryptionKey.Encrypt(input, input_length, aad.data(), aad.size(), nonce.data(), nonce.size(), output, tag,
+                                              taglen);
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    return AES_CCM_encrypt(input, input_length, aad.data(), aad.size(), mEncryptionKey, nonce.data(), nonce.size(), output, tag,
+                           taglen);
+}
+
+CHIP_ERROR CryptoContext::Open(const uint8_t * input, size_t input_length, uint8_t * output, ByteSpan aad, ConstNonceView nonce,
+                               const uint8_t * tag, size_t taglen) const
+{
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    if (input != output)
+    {
+        sCopyStats.cipherCopiedBytes += input_length;
+    }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
+    if (nullptr != mKeyContext)
+    {
+        ByteSpan ciphertext(input, input_length);
+        MutableByteSpan plaintext(output, input_length);
+        ByteSpan mic(tag, taglen);
+
+        return mKeyContext->MessageDecrypt(ciphertext, aad, nonce, mic, plaintext);
+    }
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+#if CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    if (mPreparedDecryptionKey.IsInitialized())
+    {
+        return mPreparedDecryptionKey.Decrypt(input, input_length, aad.data(), aad.size(), tag, taglen, nonce.data(), nonce.size(),
+                                              output);
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    return AES_CCM_decrypt(input, input_length, aad.data(), aad.size(), tag, taglen, mDecryptionKey, nonce.data(), nonce.size(),
+                           output);
+}
+
+CHIP_ERROR CryptoContext::GatherMessage(System::PacketBufferHandle & msgBuf, uint16_t reserve)
+{
+    if (!msgBuf->HasChainedBuffer())
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    // Append the data of the other buffers after that of the head buffer, which keeps its reserved
+    // space for the headers that are encoded in front of the message.
+    const size_t gatherLength = msgBuf->TotalLength() - msgBuf->DataLength();
+    VerifyOrReturnError(gatherLength + reserve <= msgBuf->AvailableDataLength(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    System::PacketBufferHandle head = msgBuf.PopHead();
+    while (!msgBuf.IsNull())
+    {
+        const uint16_t headLength = head->DataLength();
+        memcpy(head->Start() + headLength, msgBuf->Start(), msgBuf->DataLength());
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+        sCopyStats.gatheredBytes += msgBuf->DataLength();
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+        head->SetDataLength(static_cast<uint16_t>(headLength + msgBuf->DataLength()));
+        msgBuf.FreeHead();
+    }
+    msgBuf = std::move(head);
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                                   PacketHeader & header, MessageAuthenticationCode & mac) const
 {
@@ -208,21 +325,7 @@ CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, ui
     uint8_t tag[kMaxTagLen];
 
     ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
-
-    if (mKeyContext)
-    {
-        ByteSpan plaintext(input, input_length);
-        MutableByteSpan ciphertext(output, input_length);
-        MutableByteSpan mic(tag, taglen);
-
-        ReturnErrorOnFailure(mKeyContext->MessageEncrypt(plaintext, ByteSpan(AAD, aadLen), nonce, mic, ciphertext));
-    }
-    else
-    {
-        VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(), output, tag, taglen));
-    }
+    ReturnErrorOnFailure(Seal(input, input_length, output, ByteSpan(AAD, aadLen), nonce, tag, taglen));
 
     mac.SetTag(&header, tag, taglen);
 
@@ -242,22 +345,61 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     VerifyOrReturnError(output != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
     ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+    return Open(input, input_length, output, ByteSpan(AAD, aadLen), nonce, tag, taglen);
+}
 
-    if (nullptr != mKeyContext)
-    {
-        ByteSpan ciphertext(input, input_length);
-        MutableByteSpan plaintext(output, input_length);
-        ByteSpan mic(tag, taglen);
+CHIP_ERROR CryptoContext::EncryptMessage(ConstNonceView nonce, const PacketHeader & header,
+                                         System::PacketBufferHandle & msgBuf) const
+{
+    VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint16_t taglen = header.MICTagLength();
+    VerifyOrReturnError(taglen != 0, CHIP_ERROR_WRONG_ENCRYPTION_TYPE);
+    VerifyOrDie(taglen <= kMaxTagLen);
+
+    ReturnErrorOnFailure(GatherMessage(msgBuf, taglen));
+
+    uint8_t * data        = msgBuf->Start();
+    const uint16_t length = msgBuf->DataLength();
+    VerifyOrReturnError(length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(msgBuf->AvailableDataLength() >= taglen, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(CanCastTo<uint16_t>(length + taglen), CHIP_ERROR_INTERNAL);
+
+    uint8_t AAD[kMaxAADLen];
+    uint16_t aadLen = sizeof(AAD);
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    // The MIC goes straight to its place after the ciphertext.
+    ReturnErrorOnFailure(Seal(data, length, data, ByteSpan(AAD, aadLen), nonce, &data[length], taglen));
+    msgBuf->SetDataLength(static_cast<uint16_t>(length + taglen));
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CryptoContext::DecryptMessage(ConstNonceView nonce, const PacketHeader & header,
+                                         System::PacketBufferHandle & msgBuf) const
+{
+    VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint16_t taglen = header.MICTagLength();
+    VerifyOrReturnError(taglen != 0, CHIP_ERROR_WRONG_ENCRYPTION_TYPE_FROM_PEER);
+
+    ReturnErrorOnFailure(GatherMessage(msgBuf, 0));
+
+    uint8_t * data = msgBuf->Start();
+    uint16_t len   = msgBuf->DataLength();
+    VerifyOrReturnError(taglen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    len = static_cast<uint16_t>(len - taglen);
+    VerifyOrReturnError(len > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t AAD[kMaxAADLen];
+    uint16_t aadLen = sizeof(AAD);
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    // The MIC is verified where it was received, after the ciphertext.
+    ReturnErrorOnFailure(Open(data, len, data, ByteSpan(AAD, aadLen), nonce, &data[len], taglen));
+    msgBuf->SetDataLength(len);
 
-        CHIP_ERROR err = mKeyContext->MessageDecrypt(ciphertext, ByteSpan(AAD, aadLen), nonce, mic, plaintext);
-        ReturnErrorOnFailure(err);
-    }
-    else
-    {
-        VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
-        ReturnErrorOnFailure(
-            AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), output));
-    }
     return CHIP_NO_ERROR;
 }
 
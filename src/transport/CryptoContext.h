@@ -146,6 +146,37 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                        const PacketHeader & header, const MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief
+     *   Encrypt a message in place and append its MIC, using keys established in the secure channel
+     *
+     *   The message is the data of msgBuf starting at msgBuf->Start(). If msgBuf is a chain, its data is
+     *   first gathered into the head buffer, since AES-CCM needs the message in one piece; the head buffer
+     *   must have room for the whole message and the MIC.
+     *
+     * @param nonce Nonce buffer for encrypt
+     * @param header message header structure, used as additional authenticated data
+     * @param msgBuf message to encrypt
+     *
+     * @return CHIP_ERROR The result of encryption
+     */
+    CHIP_ERROR EncryptMessage(ConstNonceView nonce, const PacketHeader & header, System::PacketBufferHandle & msgBuf) const;
+
+    /**
+     * @brief
+     *   Verify and decrypt a message in place, removing its MIC, using keys established in the secure channel
+     *
+     *   The message, followed by its MIC, is the data of msgBuf starting at msgBuf->Start(). A chain is
+     *   gathered into the head buffer as for EncryptMessage.
+     *
+     * @param nonce Nonce buffer for decrypt
+     * @param header message header structure, used as additional authenticated data
+     * @param msgBuf message to decrypt
+     *
+     * @return CHIP_ERROR The result of decryption
+     */
+    CHIP_ERROR DecryptMessage(ConstNonceView nonce, const PacketHeader & header, System::PacketBufferHandle & msgBuf) const;
+
     CHIP_ERROR PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                               MessageAuthenticationCode & mac) const;
 
@@ -167,6 +198,20 @@ public:
 
     bool IsResponder() const { return mKeyAvailable && mSessionRole == SessionRole::kResponder; }
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    /**
+     * Bytes copied by the message paths of all crypto contexts, for benchmarks.
+     */
+    struct CopyStats
+    {
+        uint64_t gatheredBytes;     ///< Data of chained buffers copied into the head buffer by EncryptMessage/DecryptMessage.
+        uint64_t cipherCopiedBytes; ///< Input that the cipher wrote to a separate output instead of in place.
+    };
+
+    static const CopyStats & GetCopyStats() { return sCopyStats; }
+    static void ResetCopyStats() { sCopyStats = {}; }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 private:
     CHIP_ERROR InitTestMode(Crypto::SessionKeystore & keystore, Crypto::Aes128KeyHandle & i2rKey, Crypto::Aes128KeyHandle & r2iKey);
 
@@ -178,6 +223,24 @@ private:
     Crypto::AttestationChallenge mAttestationChallenge;
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
+#if CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+    Crypto::AesCcm128PreparedKey mPreparedEncryptionKey;
+    Crypto::AesCcm128PreparedKey mPreparedDecryptionKey;
+#endif // CHIP_CONFIG_SECURE_SESSION_PREPARED_KEYS
+
+    void PrepareKeys();
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    static CopyStats sCopyStats;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
+    CHIP_ERROR Seal(const uint8_t * input, size_t input_length, uint8_t * output, ByteSpan aad, ConstNonceView nonce, uint8_t * tag,
+                    size_t taglen) const;
+    CHIP_ERROR Open(const uint8_t * input, size_t input_length, uint8_t * output, ByteSpan aad, ConstNonceView nonce,
+                    const uint8_t * tag, size_t taglen) const;
+
+    // Gather a chained message into its head buffer, keeping room for reserve bytes after it.
+    static CHIP_ERROR GatherMessage(System::PacketBufferHandle & msgBuf, uint16_t reserve);
 
     // Use unencrypted header as additional authenticated data (AAD) during encryption and decryption.
     // The encryption operations includes AAD when message authentication tag is generated. This tag
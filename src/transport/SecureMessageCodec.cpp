@@ -40,27 +40,12 @@ CHIP_ERROR Encrypt(const CryptoContext & context, CryptoContext::ConstNonceView
                    PacketHeader & packetHeader, System::PacketBufferHandle & msgBuf)
 {
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     VerifyOrReturnError(msgBuf->TotalLength() <= kMaxAppMessageLen, CHIP_ERROR_MESSAGE_TOO_LONG);
 
-    static_assert(std::is_same<decltype(msgBuf->TotalLength()), uint16_t>::value,
-                  "Addition to generate payloadLength might overflow");
-
     ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(msgBuf));
 
-    uint8_t * data    = msgBuf->Start();
-    uint16_t totalLen = msgBuf->TotalLength();
-
-    MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(context.Encrypt(data, totalLen, data, nonce, packetHeader, mac));
-
-    uint16_t taglen = 0;
-    ReturnErrorOnFailure(mac.Encode(packetHeader, &data[totalLen], msgBuf->AvailableDataLength(), &taglen));
-
-    VerifyOrReturnError(CanCastTo<uint16_t>(totalLen + taglen), CHIP_ERROR_INTERNAL);
-    msgBuf->SetDataLength(static_cast<uint16_t>(totalLen + taglen));
-
-    return CHIP_NO_ERROR;
+    // Encrypts in place and appends the MIC, gathering a chained message into its head buffer first.
+    return context.EncryptMessage(nonce, packetHeader, msgBuf);
 }
 
 CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
@@ -68,32 +53,15 @@ CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView
 {
     ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
 
-    uint8_t * data = msg->Start();
-    uint16_t len   = msg->DataLength();
-
-    PacketBufferHandle origMsg;
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     /* This is a workaround for the case where PacketBuffer payload is not
         allocated as an inline buffer to PacketBuffer structure */
-    origMsg = std::move(msg);
-    msg     = PacketBufferHandle::New(len);
+    PacketBufferHandle origMsg = std::move(msg);
+    msg                        = PacketBufferHandle::NewWithData(origMsg->Start(), origMsg->DataLength());
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
-    msg->SetDataLength(len);
 #endif
 
-    uint16_t footerLen = packetHeader.MICTagLength();
-    VerifyOrReturnError(footerLen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
-
-    uint16_t taglen = 0;
-    MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(mac.Decode(packetHeader, &data[len - footerLen], footerLen, &taglen));
-    VerifyOrReturnError(taglen == footerLen, CHIP_ERROR_INTERNAL);
-
-    len = static_cast<uint16_t>(len - taglen);
-    msg->SetDataLength(len);
-
-    uint8_t * plainText = msg->Start();
-    ReturnErrorOnFailure(context.Decrypt(data, len, plainText, nonce, packetHeader, mac));
+    ReturnErrorOnFailure(context.DecryptMessage(nonce, packetHeader, msg));
 
     ReturnErrorOnFailure(payloadHeader.DecodeAndConsume(msg));
     return CHIP_NO_ERROR;
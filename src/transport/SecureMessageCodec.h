@@ -46,7 +46,8 @@ namespace SecureMessageCodec {
  *                      portion of the message header
  * @param msgBuf        The message buffer that contains the unencrypted message. If
  *                      the operation is successful, this buffer will be mutated to contain
- *                      the encrypted message.
+ *                      the encrypted message. The message is encrypted in place; a chained
+ *                      message is first gathered into its head buffer.
  * @return A CHIP_ERROR value consistent with the result of the encryption operation
  */
 CHIP_ERROR Encrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
@@ -52,8 +52,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
         }
     }
 
-    SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
-                                                   peerSessionId, fabricIndex, config);
+    SecureSession * result = AllocateSession(secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs, peerSessionId,
+                                             fabricIndex, config);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
@@ -73,7 +73,7 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     //
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
-        allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        allocated = AllocateSession(secureSessionType, sessionId.Value());
     }
     else
     {
@@ -216,7 +216,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         if (newCount < prevCount)
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
-            auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
+            auto * retSession = AllocateSession(secureSessionType, localSessionId);
             VerifyOrDie(session != nullptr);
             return retSession;
         }
@@ -339,69 +339,171 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
-    SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
+    for (size_t slot = LocalSessionIndexSlot(localSessionId); mLocalSessionIndex[slot] != nullptr;
+         slot = (slot + 1) & kLocalSessionIndexMask)
+    {
+        SecureSession * session = mLocalSessionIndex[slot];
         if (session->GetLocalSessionId() == localSessionId)
         {
-            result = session;
-            return Loop::Break;
+            return MakeOptional<SessionHandle>(*session);
         }
-        return Loop::Continue;
-    });
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    }
+    return Optional<SessionHandle>::Missing();
 }
 
-Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
+bool SecureSessionTable::AddToLocalSessionIndex(SecureSession * session)
+{
+    // Keep at least one empty slot, so that every probe terminates.
+    VerifyOrReturnValue(mLocalSessionIndexCount + 1 < kLocalSessionIndexSize, false,
+                        ChipLogError(SecureChannel, "Local session ID index is full"));
+
+    size_t slot = LocalSessionIndexSlot(session->GetLocalSessionId());
+    while (mLocalSessionIndex[slot] != nullptr)
+    {
+        slot = (slot + 1) & kLocalSessionIndexMask;
+    }
+    mLocalSessionIndex[slot] = session;
+    mLocalSessionIndexCount++;
+    return true;
+}
+
+void SecureSessionTable::RemoveFromLocalSessionIndex(SecureSession * session)
 {
-    uint16_t candidate_base = 0;
-    uint64_t candidate_mask = 0;
-    for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
+    size_t slot = LocalSessionIndexSlot(session->GetLocalSessionId());
+    while (mLocalSessionIndex[slot] != session)
     {
-        // candidate_base is the base session ID we are searching from.
-        // We have a 64-bit mask anchored at this ID and iterate over the
-        // whole session table, setting bits in the mask for in-use IDs.
-        // If we can iterate through the entire session table and have
-        // any bits clear in the mask, we have available session IDs.
-        candidate_base = static_cast<uint16_t>(i + mNextSessionId);
-        candidate_mask = 0;
+        VerifyOrReturn(mLocalSessionIndex[slot] != nullptr);
+        slot = (slot + 1) & kLocalSessionIndexMask;
+    }
+
+    //
+    // Backward-shift deletion: walk the rest of the probe chain and move back any entry whose
+    // home slot does not lie cyclically within (hole, current], so that every remaining entry is
+    // still reachable from its home slot without crossing an empty slot.
+    //
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & kLocalSessionIndexMask; mLocalSessionIndex[next] != nullptr;
+         next = (next + 1) & kLocalSessionIndexMask)
+    {
+        size_t home = LocalSessionIndexSlot(mLocalSessionIndex[next]->GetLocalSessionId());
+        if (((next - home) & kLocalSessionIndexMask) >= ((next - hole) & kLocalSessionIndexMask))
         {
-            uint16_t shift = static_cast<uint16_t>(kUnsecuredSessionId - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift); // kUnsecuredSessionId is never available
-            }
+            mLocalSessionIndex[hole] = mLocalSessionIndex[next];
+            hole                     = next;
         }
-        mEntries.ForEachActiveObject([&](auto session) {
-            uint16_t shift = static_cast<uint16_t>(session->GetLocalSessionId() - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift);
-            }
-            if (candidate_mask == UINT64_MAX)
-            {
-                return Loop::Break; // No bits clear means this bucket is full.
-            }
-            return Loop::Continue;
-        });
-        if (candidate_mask != UINT64_MAX)
+    }
+    mLocalSessionIndex[hole] = nullptr;
+    mLocalSessionIndexCount--;
+}
+
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+namespace {
+
+// Index of the lowest clear bit of a word that is known to have one.
+size_t FirstZeroBit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(~word));
+#else
+    size_t index = 0;
+    while (word & 1)
+    {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+} // namespace
+
+void SecureSessionTable::ReserveLocalSessionId(uint16_t localSessionId)
+{
+    size_t word = localSessionId / kSessionIdBitmapWordBits;
+
+    mSessionIdInUse[word] |= (1ULL << (localSessionId % kSessionIdBitmapWordBits));
+    if (mSessionIdInUse[word] == UINT64_MAX)
+    {
+        mSessionIdWordFull[word / kSessionIdBitmapWordBits] |= (1ULL << (word % kSessionIdBitmapWordBits));
+    }
+}
+
+void SecureSessionTable::ReleaseLocalSessionId(uint16_t localSessionId)
+{
+    // Test-only sessions may share a local session ID; keep it reserved while any of them is still alive.
+    // The released session has already been removed from the index by the time we get here.
+    VerifyOrReturn(localSessionId != kUnsecuredSessionId && !FindSecureSessionByLocalKey(localSessionId).HasValue());
+
+    size_t word = localSessionId / kSessionIdBitmapWordBits;
+
+    mSessionIdInUse[word] &= ~(1ULL << (localSessionId % kSessionIdBitmapWordBits));
+    mSessionIdWordFull[word / kSessionIdBitmapWordBits] &= ~(1ULL << (word % kSessionIdBitmapWordBits));
+}
+
+size_t SecureSessionTable::FindNonFullSessionIdWord(size_t fromWord) const
+{
+    for (size_t summaryWord = fromWord / kSessionIdBitmapWordBits; summaryWord < kSessionIdSummaryWords; summaryWord++)
+    {
+        uint64_t full = mSessionIdWordFull[summaryWord];
+        if (summaryWord == fromWord / kSessionIdBitmapWordBits)
+        {
+            // Treat the words before fromWord as full.
+            full |= (1ULL << (fromWord % kSessionIdBitmapWordBits)) - 1;
+        }
+        if (full != UINT64_MAX)
         {
-            break; // Any bit clear means we have an available ID in this bucket.
+            return summaryWord * kSessionIdBitmapWordBits + FirstZeroBit(full);
         }
     }
-    if (candidate_mask != UINT64_MAX)
+    return kSessionIdBitmapWords;
+}
+
+Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
+{
+    size_t word = mNextSessionId / kSessionIdBitmapWordBits;
+
+    // Look for a free ID at or after mNextSessionId in its own word first, treating the IDs below it as taken.
+    uint64_t inUse = mSessionIdInUse[word] | ((1ULL << (mNextSessionId % kSessionIdBitmapWordBits)) - 1);
+    if (inUse == UINT64_MAX)
     {
-        uint16_t offset = 0;
-        while (candidate_mask & 1)
+        // Then look at the following words, and finally wrap around to the start of the ID space, which
+        // includes the IDs below mNextSessionId in its word.
+        word = FindNonFullSessionIdWord(word + 1);
+        if (word == kSessionIdBitmapWords)
         {
-            candidate_mask >>= 1;
-            ++offset;
+            word = FindNonFullSessionIdWord(0);
+        }
+        VerifyOrReturnValue(word != kSessionIdBitmapWords, NullOptional);
+        inUse = mSessionIdInUse[word];
+    }
+
+    return MakeOptional(static_cast<uint16_t>(word * kSessionIdBitmapWordBits + FirstZeroBit(inUse)));
+}
+
+#else // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
+void SecureSessionTable::ReserveLocalSessionId(uint16_t localSessionId) {}
+
+void SecureSessionTable::ReleaseLocalSessionId(uint16_t localSessionId) {}
+
+Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
+{
+    // At most CHIP_CONFIG_SECURE_SESSION_POOL_SIZE IDs plus kUnsecuredSessionId can be taken, so this
+    // terminates well before wrapping all the way around.
+    uint16_t candidate = mNextSessionId;
+    for (uint32_t i = 0; i <= kMaxSessionID; i++, candidate++)
+    {
+        if (candidate != kUnsecuredSessionId && !FindSecureSessionByLocalKey(candidate).HasValue())
+        {
+            return MakeOptional(candidate);
         }
-        uint16_t available = static_cast<uint16_t>(candidate_base + offset);
-        return MakeOptional<uint16_t>(available);
     }
 
     return NullOptional;
 }
 
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+
 } // namespace Transport
 } // namespace chip
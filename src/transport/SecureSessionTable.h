@@ -29,6 +29,21 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+namespace detail {
+
+// Smallest power of two that is at least twice the given session pool size.
+constexpr size_t LocalSessionIndexSizeFor(size_t poolSize)
+{
+    size_t size = 1;
+    while (size < 2 * poolSize)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+} // namespace detail
+
 /**
  * Handles a set of sessions.
  *
@@ -76,7 +91,12 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromLocalSessionIndex(session);
+        ReleaseLocalSessionId(session->GetLocalSessionId());
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -243,21 +263,91 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
+     * Returns the first unused session ID at or after the mNextSessionId clue,
+     * wrapping around the session ID space and never returning kUnsecuredSessionId.
      *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * With CHIP_CONFIG_SECURE_SESSION_ID_BITMAP, this is a find-first-zero over
+     * the in-use bitmap words, using a summary bitmap of full words to skip over
+     * densely allocated ranges.  Otherwise, successive candidates are checked
+     * against the local session ID index; since at most
+     * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE IDs can be in use, this takes at most
+     * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE + 2 index lookups.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Allocate a session out of mEntries and record it in the local session ID index
+     * and in-use bitmap.
+     *
+     * All session allocations must go through here so that FindSecureSessionByLocalKey
+     * never misses a live session and FindUnusedSessionId never hands out a live ID.
+     */
+    template <typename... Args>
+    SecureSession * AllocateSession(Args &&... args)
+    {
+        SecureSession * session = mEntries.CreateObject(*this, std::forward<Args>(args)...);
+        VerifyOrReturnValue(session != nullptr, nullptr);
+        if (!AddToLocalSessionIndex(session))
+        {
+            mEntries.ReleaseObject(session);
+            return nullptr;
+        }
+        ReserveLocalSessionId(session->GetLocalSessionId());
+        return session;
+    }
+
+    void ReserveLocalSessionId(uint16_t localSessionId);
+    void ReleaseLocalSessionId(uint16_t localSessionId);
+
+    //
+    // Index of live sessions keyed by local session ID, used to make FindSecureSessionByLocalKey
+    // independent of the session table size.
+    //
+    // This is an open-addressed hash table with linear probing over (local session ID & kLocalSessionIndexMask).
+    // Since local session IDs are handed out sequentially by FindUnusedSessionId, consecutive sessions land
+    // in consecutive slots and probe chains stay short. The table is sized to at least twice the session pool.
+    // Heap pools and test-only allocations can hold more sessions than that, so the index refuses an entry that
+    // would fill its last empty slot, which is what terminates every probe. Removal uses backward-shift deletion,
+    // so no tombstones are needed.
+    //
+    static constexpr size_t kLocalSessionIndexSize = detail::LocalSessionIndexSizeFor(CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+    static constexpr size_t kLocalSessionIndexMask = kLocalSessionIndexSize - 1;
+
+    static_assert(kLocalSessionIndexSize > CHIP_CONFIG_SECURE_SESSION_POOL_SIZE,
+                  "The local session index must always keep at least one empty slot");
+
+    static size_t LocalSessionIndexSlot(uint16_t localSessionId) { return localSessionId & kLocalSessionIndexMask; }
+
+    /**
+     * @return false, leaving the index unchanged, if the index has no room left for the session.
+     */
+    CHECK_RETURN_VALUE bool AddToLocalSessionIndex(SecureSession * session);
+    void RemoveFromLocalSessionIndex(SecureSession * session);
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
+    SecureSession * mLocalSessionIndex[kLocalSessionIndexSize] = {};
+    size_t mLocalSessionIndexCount                             = 0;
+
+#if CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
+    //
+    // Two-level bitmap of local session IDs in use: one bit per session ID in mSessionIdInUse,
+    // and one bit per mSessionIdInUse word in mSessionIdWordFull, set when every ID in that word is in use.
+    //
+    static constexpr size_t kSessionIdBitmapWordBits = 64;
+    static constexpr size_t kSessionIdBitmapWords    = (static_cast<size_t>(kMaxSessionID) + 1) / kSessionIdBitmapWordBits;
+    static constexpr size_t kSessionIdSummaryWords   = kSessionIdBitmapWords / kSessionIdBitmapWordBits;
+
+    size_t FindNonFullSessionIdWord(size_t fromWord) const;
+
+    // kUnsecuredSessionId is never available.
+    static_assert(kUnsecuredSessionId == 0, "The in-use bitmap reserves session ID 0 at construction");
+    uint64_t mSessionIdInUse[kSessionIdBitmapWords]     = { 1 };
+    uint64_t mSessionIdWordFull[kSessionIdSummaryWords] = {};
+#endif // CHIP_CONFIG_SECURE_SESSION_ID_BITMAP
 
     size_t GetMaxSessionTableSize() const
     {
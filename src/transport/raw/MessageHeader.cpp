@@ -404,6 +404,10 @@ CHIP_ERROR PayloadHeader::EncodeBeforeData(const System::PacketBufferHandle & bu
     return CHIP_NO_ERROR;
 }
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+uint64_t MessageAuthenticationCode::sCopiedBytes = 0;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 CHIP_ERROR MessageAuthenticationCode::Decode(const PacketHeader & packetHeader, const uint8_t * const data, uint16_t size,
                                              uint16_t * decode_len)
 {
@@ -413,6 +417,9 @@ CHIP_ERROR MessageAuthenticationCode::Decode(const PacketHeader & packetHeader,
     VerifyOrReturnError(size >= taglen, CHIP_ERROR_INVALID_ARGUMENT);
 
     memcpy(&mTag[0], data, taglen);
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    sCopiedBytes += taglen;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
     *decode_len = taglen;
 
@@ -429,6 +436,9 @@ CHIP_ERROR MessageAuthenticationCode::Encode(const PacketHeader & packetHeader,
     VerifyOrReturnError(size >= taglen, CHIP_ERROR_INVALID_ARGUMENT);
 
     memcpy(p, &mTag[0], taglen);
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    sCopiedBytes += taglen;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
     // Written data size provided to caller on success
     *encode_size = taglen;
@@ -759,6 +759,9 @@ public:
         if (tagLen > 0 && tagLen <= kMaxTagLen && len == tagLen)
         {
             memcpy(&mTag, tag, tagLen);
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+            sCopiedBytes += tagLen;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
         }
 
         return *this;
@@ -796,9 +799,19 @@ public:
      */
     CHIP_ERROR Encode(const PacketHeader & packetHeader, uint8_t * data, uint16_t size, uint16_t * encode_size) const;
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    /// Tag bytes copied in and out of all MessageAuthenticationCode objects by SetTag, Decode and Encode, for benchmarks.
+    static uint64_t GetCopiedBytes() { return sCopiedBytes; }
+    static void ResetCopiedBytes() { sCopiedBytes = 0; }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 private:
     /// Message authentication tag generated at encryption of the message.
     uint8_t mTag[kMaxTagLen];
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    static uint64_t sCopiedBytes;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 };
 
 } // namespace chip
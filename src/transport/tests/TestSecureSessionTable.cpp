@@ -31,6 +31,7 @@
 #include <nlbyteorder.h>
 #include <nlunit-test.h>
 
+#include <algorithm>
 #include <errno.h>
 #include <vector>
 
@@ -47,6 +48,25 @@ public:
     //
     static void ValidateSessionSorting(nlTestSuite * inSuite, void * inContext);
 
+    //
+    // This test validates FindSecureSessionByLocalKey against a linear scan of the table
+    // for increasing table sizes, and logs the per-lookup cost of both so that the effect
+    // of CHIP_CONFIG_SECURE_SESSION_POOL_SIZE on the receive path can be measured.
+    //
+    static void BenchmarkLocalSessionLookup(nlTestSuite * inSuite, void * inContext);
+
+    //
+    // This test validates that FindUnusedSessionId hands out the first unused ID at or
+    // after mNextSessionId, wrapping around the ID space and skipping kUnsecuredSessionId.
+    //
+    static void ValidateSessionIdAllocation(nlTestSuite * inSuite, void * inContext);
+
+    //
+    // This test validates that the local session ID index refuses sessions past its capacity, which a heap pool
+    // or CreateNewSecureSessionForTest can exceed, instead of looping forever.
+    //
+    static void ValidateLocalSessionIndexCapacity(nlTestSuite * inSuite, void * inContext);
+
 private:
     struct SessionParameters
     {
@@ -459,6 +479,158 @@ void TestSecureSessionTable::ValidateSessionSorting(nlTestSuite * inSuite, void
     }
 }
 
+void TestSecureSessionTable::BenchmarkLocalSessionLookup(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kLookupRounds = 1000;
+
+    for (size_t tableSize = 1;; tableSize = std::min<size_t>(tableSize * 2, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE))
+    {
+        auto table = Platform::MakeUnique<SecureSessionTable>();
+        NL_TEST_ASSERT(inSuite, table.get() != nullptr);
+        table->Init();
+
+        Optional<SessionHandle> handles[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+        uint16_t sessionIds[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+        for (size_t i = 0; i < tableSize; i++)
+        {
+            handles[i] = table->CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+            NL_TEST_ASSERT(inSuite, handles[i].HasValue());
+            sessionIds[i] = handles[i].Value()->AsSecureSession()->GetLocalSessionId();
+        }
+
+        // Release every other session so that lookups also have to probe past removed entries.
+        for (size_t i = 0; i < tableSize; i += 2)
+        {
+            handles[i].ClearValue();
+        }
+
+        uint32_t found = 0;
+
+        uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (uint32_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < tableSize; i++)
+            {
+                found += table->FindSecureSessionByLocalKey(sessionIds[i]).HasValue() ? 1 : 0;
+            }
+        }
+        uint64_t indexedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+        start = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (uint32_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < tableSize; i++)
+            {
+                SecureSession * result = nullptr;
+                table->ForEachSession([&](auto session) {
+                    if (session->GetLocalSessionId() == sessionIds[i])
+                    {
+                        result = session;
+                        return Loop::Break;
+                    }
+                    return Loop::Continue;
+                });
+                found -= (result != nullptr) ? 1 : 0;
+            }
+        }
+        uint64_t linearUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+        // Both lookups must agree on every ID, and only the odd-indexed sessions are still alive.
+        NL_TEST_ASSERT(inSuite, found == 0);
+        for (size_t i = 0; i < tableSize; i++)
+        {
+            NL_TEST_ASSERT(inSuite, table->FindSecureSessionByLocalKey(sessionIds[i]).HasValue() == (i % 2 == 1));
+        }
+
+        ChipLogProgress(SecureChannel, "Local session lookup, %u sessions: indexed %u us, linear scan %u us (%u lookups)",
+                        static_cast<unsigned>(tableSize), static_cast<unsigned>(indexedUs), static_cast<unsigned>(linearUs),
+                        static_cast<unsigned>(kLookupRounds * tableSize));
+
+        // Sessions must be released before the table that owns them.
+        for (auto & handle : handles)
+        {
+            handle.ClearValue();
+        }
+
+        if (tableSize == CHIP_CONFIG_SECURE_SESSION_POOL_SIZE)
+        {
+            break;
+        }
+    }
+}
+
+void TestSecureSessionTable::ValidateSessionIdAllocation(nlTestSuite * inSuite, void * inContext)
+{
+    auto table = Platform::MakeUnique<SecureSessionTable>();
+    NL_TEST_ASSERT(inSuite, table.get() != nullptr);
+
+    auto createSession = [&](uint16_t localSessionId) {
+        return table->CreateNewSecureSessionForTest(SecureSession::Type::kCASE, localSessionId, 1, 2, CATValues(), 1, kFabric1,
+                                                    GetDefaultMRPConfig());
+    };
+
+    table->mNextSessionId = static_cast<uint16_t>(kMaxSessionID - 1);
+    NL_TEST_ASSERT(inSuite, table->FindUnusedSessionId() == MakeOptional(static_cast<uint16_t>(kMaxSessionID - 1)));
+
+    // IDs at and after the clue are taken, so we wrap around, never hand out kUnsecuredSessionId,
+    // and skip the taken IDs after it.
+    auto sessionMaxMinusOne = createSession(static_cast<uint16_t>(kMaxSessionID - 1));
+    auto sessionMax         = createSession(kMaxSessionID);
+    auto session1           = createSession(1);
+    auto session2           = createSession(2);
+    NL_TEST_ASSERT(inSuite, sessionMaxMinusOne.HasValue() && sessionMax.HasValue() && session1.HasValue() && session2.HasValue());
+    NL_TEST_ASSERT(inSuite, table->FindUnusedSessionId() == MakeOptional(static_cast<uint16_t>(3)));
+
+    // Releasing a session makes its ID available again.
+    sessionMax.Value()->AsSecureSession()->MarkForEviction();
+    sessionMax.ClearValue();
+    NL_TEST_ASSERT(inSuite, table->FindUnusedSessionId() == MakeOptional(kMaxSessionID));
+}
+
+void TestSecureSessionTable::ValidateLocalSessionIndexCapacity(nlTestSuite * inSuite, void * inContext)
+{
+    auto table = Platform::MakeUnique<SecureSessionTable>();
+    NL_TEST_ASSERT(inSuite, table.get() != nullptr);
+
+    std::vector<Optional<SessionHandle>> handles;
+    for (size_t i = 1; i <= SecureSessionTable::kLocalSessionIndexSize; i++)
+    {
+        auto handle = table->CreateNewSecureSessionForTest(SecureSession::Type::kCASE, static_cast<uint16_t>(i), 1, 2, CATValues(),
+                                                           1, kFabric1, GetDefaultMRPConfig());
+        if (!handle.HasValue())
+        {
+            break;
+        }
+        handles.push_back(handle);
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    NL_TEST_ASSERT(inSuite, handles.size() == SecureSessionTable::kLocalSessionIndexSize - 1);
+#else
+    NL_TEST_ASSERT(inSuite, handles.size() == CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+#endif
+
+    // Every indexed session is found, and looking up an ID that is not in use terminates.
+    for (size_t i = 0; i < handles.size(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, table->FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1)).HasValue());
+    }
+    NL_TEST_ASSERT(inSuite, !table->FindSecureSessionByLocalKey(kMaxSessionID).HasValue());
+
+    // Releasing a session makes room in the index again.
+    handles.front().Value()->AsSecureSession()->MarkForEviction();
+    handles.front().ClearValue();
+    auto handle = table->CreateNewSecureSessionForTest(SecureSession::Type::kCASE, kMaxSessionID, 1, 2, CATValues(), 1, kFabric1,
+                                                       GetDefaultMRPConfig());
+    NL_TEST_ASSERT(inSuite, handle.HasValue());
+    NL_TEST_ASSERT(inSuite, table->FindSecureSessionByLocalKey(kMaxSessionID).HasValue());
+    NL_TEST_ASSERT(inSuite, !table->FindSecureSessionByLocalKey(1).HasValue());
+
+    // Sessions must be released before the table that owns them.
+    handle.ClearValue();
+    handles.clear();
+}
+
 Platform::UniquePtr<TestSecureSessionTable> gTestSecureSessionTable;
 
 } // namespace Transport
@@ -475,6 +647,9 @@ namespace {
 const nlTest sTests[] =
 {
     NL_TEST_DEF("Validate Session Sorting (Over Minima)",               chip::Transport::TestSecureSessionTable::ValidateSessionSorting),
+    NL_TEST_DEF("Benchmark Local Session ID Lookup",                    chip::Transport::TestSecureSessionTable::BenchmarkLocalSessionLookup),
+    NL_TEST_DEF("Validate Session ID Allocation",                       chip::Transport::TestSecureSessionTable::ValidateSessionIdAllocation),
+    NL_TEST_DEF("Validate Local Session ID Index Capacity",             chip::Transport::TestSecureSessionTable::ValidateLocalSessionIndexCapacity),
     NL_TEST_SENTINEL()
 };
 // clang-format on